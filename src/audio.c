@@ -20,6 +20,7 @@
 
 #include "lvgl/lvgl.h"
 #include "audio.h"
+#include "audio_source.h"
 #include "meter.h"
 #include "dsp.h"
 #include "params/params.h"
@@ -50,7 +51,7 @@ static void read_callback(pa_stream *s, size_t nbytes, void *udata) {
     int16_t *buf = NULL;
 
     pa_stream_peek(s, (const void**) &buf, &nbytes);
-    dsp_put_audio_samples(nbytes / 2, buf);
+    audio_source_put_samples(AUDIO_SOURCE_LIVE, nbytes / 2, buf);
     pa_stream_drop(s);
 }
 
@@ -89,7 +90,13 @@ void audio_init() {
     pa_context_connect(ctx, NULL, 0, NULL);
     pa_threaded_mainloop_unlock(mloop);
 
-    while (PA_CONTEXT_READY != pa_context_get_state(ctx))  {
+    pa_context_state_t ctx_state;
+
+    while ((ctx_state = pa_context_get_state(ctx)) != PA_CONTEXT_READY)  {
+        if (!PA_CONTEXT_IS_GOOD(ctx_state)) {
+            LV_LOG_ERROR("PulseAudio is not available, live audio disabled");
+            return;
+        }
         pa_threaded_mainloop_wait(mloop);
     }
 
@@ -132,6 +139,10 @@ void audio_init() {
 }
 
 int audio_play(int16_t *samples_buf, size_t samples) {
+    if (!play_stm) {
+        return -1;
+    }
+
     while (true) {
         size_t size;
 
@@ -161,6 +172,10 @@ void audio_play_wait() {
     pa_operation *op;
     int r;
 
+    if (!play_stm) {
+        return;
+    }
+
     pa_threaded_mainloop_lock(mloop);
     op = pa_stream_drain(play_stm, NULL, NULL);
     pa_threaded_mainloop_unlock(mloop);
@@ -246,6 +261,12 @@ float audio_set_play_vol(float db) {
     snd_mixer_selem_id_set_name(sid, selem_name);
     snd_mixer_elem_t* elem = snd_mixer_find_selem(handle, sid);
 
+    if (!elem) {
+        LV_LOG_ERROR("Mixer element %s not found", selem_name);
+        snd_mixer_close(handle);
+        return db;
+    }
+
     snd_mixer_selem_set_playback_dB_all(elem, (long)(db * 100.0f), 0);
     long db_long;
     snd_mixer_selem_get_playback_dB(elem, SND_MIXER_SCHN_MONO, &db_long);
@@ -269,6 +290,12 @@ float audio_set_rec_vol(float db) {
     snd_mixer_selem_id_set_name(sid, selem_name);
     snd_mixer_elem_t* elem = snd_mixer_find_selem(handle, sid);
 
+    if (!elem) {
+        LV_LOG_ERROR("Mixer element %s not found", selem_name);
+        snd_mixer_close(handle);
+        return db;
+    }
+
     snd_mixer_selem_set_capture_dB_all(elem, (long)(db * 100.0f), 0);
     long db_long;
     snd_mixer_selem_get_capture_dB(elem, SND_MIXER_SCHN_MONO, &db_long);
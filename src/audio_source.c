@@ -0,0 +1,201 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "audio_source.h"
+
+#include "audio.h"
+#include "dsp.h"
+#include "recorder.h"
+#include "util.h"
+
+#include "lvgl/lvgl.h"
+
+#include <liquid/liquid.h>
+#include <sndfile.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CHUNK_SAMPLES   (AUDIO_CAPTURE_RATE / 10)   /* same as PulseAudio fragment */
+#define MAX_CHANNELS    8
+
+static _Atomic audio_source_t   source = AUDIO_SOURCE_LIVE;
+static atomic_bool              file_run = false;
+static pthread_t                file_thread;
+static bool                     file_thread_joinable = false;
+
+static SNDFILE                  *file;
+static SF_INFO                  file_info;
+static float                    file_speed;
+static char                     file_name[128];
+
+static void timespec_add_ns(struct timespec *t, uint64_t ns) {
+    t->tv_sec += ns / 1000000000L;
+    t->tv_nsec += ns % 1000000000L;
+
+    if (t->tv_nsec >= 1000000000L) {
+        t->tv_sec++;
+        t->tv_nsec -= 1000000000L;
+    }
+}
+
+static void * file_thread_fn(void *arg) {
+    float           ratio = (float) AUDIO_CAPTURE_RATE / file_info.samplerate;
+    msresamp_rrrf   resamp = NULL;
+    size_t          in_frames = CHUNK_SAMPLES;
+
+    if (file_info.samplerate != AUDIO_CAPTURE_RATE) {
+        resamp = msresamp_rrrf_create(ratio, 60.0f);
+        in_frames = CHUNK_SAMPLES / ratio;
+    }
+
+    float   *in = malloc(in_frames * file_info.channels * sizeof(float));
+    float   *mono = malloc(in_frames * sizeof(float));
+    float   *resampled = malloc((CHUNK_SAMPLES + 64) * sizeof(float));
+    int16_t *out = malloc((CHUNK_SAMPLES + 64) * sizeof(int16_t));
+
+    struct timespec start, deadline;
+    uint64_t        total = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    while (file_run) {
+        sf_count_t frames = sf_readf_float(file, in, in_frames);
+
+        if (frames <= 0) {
+            break;
+        }
+
+        for (sf_count_t i = 0; i < frames; i++) {
+            float sum = 0.0f;
+
+            for (int ch = 0; ch < file_info.channels; ch++) {
+                sum += in[i * file_info.channels + ch];
+            }
+            mono[i] = sum / file_info.channels;
+        }
+
+        float           *samples = mono;
+        unsigned int    count = frames;
+
+        if (resamp) {
+            msresamp_rrrf_execute(resamp, mono, frames, resampled, &count);
+            samples = resampled;
+        }
+
+        for (unsigned int i = 0; i < count; i++) {
+            out[i] = limit(samples[i] * 32767.0f, -32767, 32767);
+        }
+
+        audio_source_put_samples(AUDIO_SOURCE_FILE, count, out);
+        total += count;
+
+        if (file_speed > 0.0f) {
+            deadline = start;
+            timespec_add_ns(&deadline, total * 1000000000.0 / (AUDIO_CAPTURE_RATE * file_speed));
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+        }
+    }
+
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    uint64_t elapsed_ms = (now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000;
+    uint64_t audio_ms = total * 1000 / AUDIO_CAPTURE_RATE;
+
+    LV_LOG_USER("Audio file %s done: %llu ms of audio in %llu ms (x%.1f)",
+        file_name, (unsigned long long) audio_ms, (unsigned long long) elapsed_ms,
+        elapsed_ms ? (float) audio_ms / elapsed_ms : 0.0f);
+
+    if (resamp) {
+        msresamp_rrrf_destroy(resamp);
+    }
+    free(in);
+    free(mono);
+    free(resampled);
+    free(out);
+
+    sf_close(file);
+    file = NULL;
+
+    source = AUDIO_SOURCE_LIVE;
+    file_run = false;
+
+    return NULL;
+}
+
+void audio_source_init() {
+    const char *path = getenv("X6200_AUDIO_FILE");
+
+    if (path) {
+        const char  *speed_str = getenv("X6200_AUDIO_SPEED");
+        float       speed = speed_str ? atof(speed_str) : 1.0f;
+
+        audio_source_file_start(path, speed);
+    }
+}
+
+audio_source_t audio_source_get() {
+    return source;
+}
+
+void audio_source_put_samples(audio_source_t src, size_t nsamples, int16_t *samples) {
+    if (src != source) {
+        return;
+    }
+
+    dsp_put_audio_samples(nsamples, samples);
+}
+
+bool audio_source_file_start(const char *path, float speed) {
+    audio_source_file_stop();
+
+    if (path[0] == '/') {
+        strncpy(file_name, path, sizeof(file_name) - 1);
+    } else {
+        snprintf(file_name, sizeof(file_name), "%s/%s", recorder_path, path);
+    }
+
+    memset(&file_info, 0, sizeof(file_info));
+    file = sf_open(file_name, SFM_READ, &file_info);
+
+    if (!file) {
+        LV_LOG_ERROR("Can't open audio file %s: %s", file_name, sf_strerror(NULL));
+        return false;
+    }
+
+    if (file_info.channels < 1 || file_info.channels > MAX_CHANNELS) {
+        LV_LOG_ERROR("Unsupported number of channels: %i", file_info.channels);
+        sf_close(file);
+        file = NULL;
+        return false;
+    }
+
+    LV_LOG_USER("Audio source: %s (%i Hz, %i ch), speed %.1f",
+        file_name, file_info.samplerate, file_info.channels, speed);
+
+    file_speed = speed;
+    file_run = true;
+    source = AUDIO_SOURCE_FILE;
+
+    pthread_create(&file_thread, NULL, file_thread_fn, NULL);
+    file_thread_joinable = true;
+
+    return true;
+}
+
+void audio_source_file_stop() {
+    if (file_thread_joinable) {
+        file_run = false;
+        pthread_join(file_thread, NULL);
+        file_thread_joinable = false;
+    }
+}
@@ -0,0 +1,38 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    AUDIO_SOURCE_LIVE = 0,
+    AUDIO_SOURCE_FILE,
+} audio_source_t;
+
+/**
+ * Start file source from env (X6200_AUDIO_FILE, X6200_AUDIO_SPEED), if set
+ */
+void audio_source_init();
+
+audio_source_t audio_source_get();
+
+/**
+ * Feed samples of the source to the DSP. Samples of inactive source are dropped
+ */
+void audio_source_put_samples(audio_source_t source, size_t nsamples, int16_t *samples);
+
+/**
+ * Replay WAV/MP3 file through the capture path instead of live audio.
+ * Relative path is taken from recorder directory.
+ * Speed 1.0 - real time, N - N times faster, 0 - as fast as possible
+ */
+bool audio_source_file_start(const char *path, float speed);
+void audio_source_file_stop();
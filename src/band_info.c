@@ -15,15 +15,10 @@
 
 #include <stdlib.h>
 
-#define BANDS_REFRESH_PERIOD_MS 3 * 1000
-
 static lv_obj_t *obj;
 
 static lv_coord_t   band_info_height = 24;
 static int32_t      width_hz         = 100000;
-static band_info_t *band_info;
-static int32_t     band_info_cap    = 32;
-static uint16_t     bands_count      = 0;
 static uint64_t     freq;
 static lv_anim_t    fade;
 static bool         fade_run = false;
@@ -33,8 +28,6 @@ static lv_timer_t *timer = NULL;
 static void on_fft_width_changed(Subject *subj, void *user_data);
 static void on_freq_changed(Subject *subj, void *user_data);
 
-static void refresh_bands_info();
-
 static void band_info_timer(lv_timer_t *t) {
     lv_anim_set_values(&fade, lv_obj_get_style_opa(obj, 0), LV_OPA_TRANSP);
     lv_anim_start(&fade);
@@ -46,9 +39,10 @@ static void band_info_draw_cb(lv_event_t *e) {
     lv_obj_t       *obj      = lv_event_get_target(e);
     lv_draw_ctx_t  *draw_ctx = lv_event_get_draw_ctx(e);
 
-    if (!band_info) {
-        return;
-    }
+    /* Band plan is in memory, the database is not touched while tuning */
+
+    size_t             bands_count;
+    const band_info_t *band_info = cfg_band_plan_get(&bands_count);
 
     lv_coord_t x1 = obj->coords.x1;
     lv_coord_t y1 = obj->coords.y1;
@@ -56,8 +50,8 @@ static void band_info_draw_cb(lv_event_t *e) {
     lv_coord_t w = lv_obj_get_width(obj);
     lv_coord_t h = lv_obj_get_height(obj) - 1;
 
-    for (uint16_t i = 0; i < bands_count; i++) {
-        band_info_t *band = &band_info[i];
+    for (size_t i = 0; i < bands_count; i++) {
+        const band_info_t *band = &band_info[i];
 
         /* Rect */
 
@@ -135,8 +129,6 @@ static void fade_ready(lv_anim_t *a) {
 }
 
 lv_obj_t *band_info_init(lv_obj_t *parent) {
-    band_info = malloc(sizeof(*band_info) * band_info_cap);
-    refresh_bands_info();
     obj = lv_obj_create(parent);
 
     lv_obj_set_size(obj, lv_obj_get_width(parent), band_info_height);
@@ -187,12 +179,3 @@ static void on_fft_width_changed(Subject *subj, void *user_data) {
 static void on_freq_changed(Subject *subj, void *user_data) {
     band_info_update(subject_get_int(subj));
 }
-
-static void refresh_bands_info() {
-    for (size_t i = 0; i < bands_count; i++) {
-        if (band_info[i].name != NULL) {
-            free(band_info[i].name);
-        }
-    }
-    bands_count = cfg_band_read_all_bands(&band_info, &band_info_cap);
-}
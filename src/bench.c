@@ -0,0 +1,272 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+/*
+ * Each scenario changes the UI the same way the radio does (spectrum and
+ * waterfall data, S-meter, tuning, messages, dialogs) and the time of one
+ * main loop iteration with a forced refresh is measured.
+ *
+ * Environment:
+ *   X6200_BENCH        "all" or list of scenarios separated by ','
+ *   X6200_BENCH_FRAMES frames per scenario (default 300)
+ *   X6200_BENCH_OUT    CSV file for the results
+ */
+
+#include "bench.h"
+
+#include "dsp.h"
+#include "spectrum.h"
+#include "waterfall.h"
+#include "meter.h"
+#include "msg.h"
+#include "events.h"
+#include "scheduler.h"
+#include "main_screen.h"
+#include "dialog.h"
+#include "util.h"
+#include "cfg/cfg.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    const char  *name;
+    void        (*step)(uint32_t frame);
+} scenario_t;
+
+static const char   *scenarios_list = NULL;
+static uint32_t     frames = 300;
+static uint64_t     frame_px;
+
+static float        spectrum_buf[SPECTRUM_NFFT];
+static float        waterfall_buf[WATERFALL_NFFT];
+
+static uint64_t time_us() {
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t) t.tv_sec * 1000000L + t.tv_nsec / 1000;
+}
+
+/**
+ * Noise with a few drifting carriers, dB
+ */
+static void make_psd(float *buf, size_t size, uint32_t frame) {
+    for (size_t i = 0; i < size; i++) {
+        buf[i] = -120.0f + (float) rand() / RAND_MAX * 6.0f;
+    }
+
+    for (int n = 0; n < 8; n++) {
+        size_t center = (size / 9 * (n + 1) + frame * (n + 1) / 4) % size;
+
+        for (int d = -2; d <= 2; d++) {
+            size_t i = (center + d + size) % size;
+
+            buf[i] = LV_MAX(buf[i], -70.0f - n * 4.0f - d * d * 6.0f);
+        }
+    }
+}
+
+/* Scenarios */
+
+static void step_idle(uint32_t frame) {
+}
+
+static void step_spectrum(uint32_t frame) {
+    make_psd(spectrum_buf, SPECTRUM_NFFT, frame);
+    spectrum_data(spectrum_buf, SPECTRUM_NFFT, false);
+}
+
+static void step_waterfall(uint32_t frame) {
+    make_psd(waterfall_buf, WATERFALL_NFFT, frame);
+    waterfall_data(waterfall_buf, WATERFALL_NFFT, false);
+}
+
+static void step_meter(uint32_t frame) {
+    meter_update(S5 + sinf(frame * 0.2f) * 20.0f, 0.5f);
+}
+
+static void step_rx(uint32_t frame) {
+    step_spectrum(frame);
+    step_waterfall(frame);
+    step_meter(frame);
+}
+
+static void step_tune(uint32_t frame) {
+    static uint64_t start_freq;
+
+    if (frame == 0) {
+        start_freq = subject_get_int(cfg_cur.fg_freq);
+    }
+
+    main_screen_set_freq(start_freq + (frame % 200) * 50);
+    step_rx(frame);
+}
+
+static void step_msg(uint32_t frame) {
+    msg_update_text_fmt("Bench frame %u", frame);
+}
+
+static void step_dialog(uint32_t frame) {
+    switch (frame % 20) {
+        case 0:
+            main_screen_start_app(ACTION_APP_SETTINGS);
+            break;
+
+        case 10:
+            dialog_destruct();
+            break;
+
+        default:
+            break;
+    }
+}
+
+static const scenario_t scenarios[] = {
+    { "idle",       step_idle },
+    { "spectrum",   step_spectrum },
+    { "waterfall",  step_waterfall },
+    { "meter",      step_meter },
+    { "rx",         step_rx },
+    { "tune",       step_tune },
+    { "msg",        step_msg },
+    { "dialog",     step_dialog },
+};
+
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *) a;
+    uint32_t y = *(const uint32_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+static bool scenario_enabled(const char *name) {
+    if (strcmp(scenarios_list, "all") == 0) {
+        return true;
+    }
+
+    size_t      len = strlen(name);
+    const char  *p = scenarios_list;
+
+    while ((p = strstr(p, name))) {
+        bool start = (p == scenarios_list) || (p[-1] == ',');
+        bool end = (p[len] == '\0') || (p[len] == ',');
+
+        if (start && end) {
+            return true;
+        }
+        p += len;
+    }
+
+    return false;
+}
+
+static void run_scenario(const scenario_t *scenario, uint32_t *times, FILE *out) {
+    uint64_t px = 0;
+    uint64_t total = 0;
+    uint64_t prev = time_us();
+
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        scenario->step(frame);
+
+        uint64_t start = time_us();
+
+        lv_tick_inc((start - prev) / 1000);
+        prev = start - (start - prev) % 1000;
+
+        frame_px = 0;
+        observer_delayed_notify_all();
+        event_obj_check();
+        scheduler_work();
+        lv_timer_handler();
+        lv_refr_now(NULL);
+
+        times[frame] = time_us() - start;
+        total += times[frame];
+        px += frame_px;
+    }
+
+    qsort(times, frames, sizeof(uint32_t), cmp_u32);
+
+    uint32_t avg = total / frames;
+    uint32_t p50 = times[frames * 50 / 100];
+    uint32_t p90 = times[frames * 90 / 100];
+    uint32_t p99 = times[frames * 99 / 100];
+    uint32_t max = times[frames - 1];
+
+    printf("%-10s %8u %8u %8u %8u %8u %10llu\n",
+        scenario->name, avg, p50, p90, p99, max, (unsigned long long) (px / frames));
+
+    if (out) {
+        fprintf(out, "%s,%u,%u,%u,%u,%u,%u,%llu\n",
+            scenario->name, frames, avg, p50, p90, p99, max, (unsigned long long) (px / frames));
+    }
+}
+
+bool bench_init() {
+    scenarios_list = getenv("X6200_BENCH");
+
+    if (!scenarios_list) {
+        return false;
+    }
+
+    const char *str = getenv("X6200_BENCH_FRAMES");
+
+    if (str && atoi(str) > 0) {
+        frames = atoi(str);
+    }
+
+    return true;
+}
+
+void bench_flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+    lv_disp_flush_ready(drv);
+}
+
+void bench_monitor(lv_disp_drv_t *drv, uint32_t time, uint32_t px) {
+    frame_px += px;
+}
+
+void bench_run(lv_obj_t *main_obj) {
+    const char  *out_name = getenv("X6200_BENCH_OUT");
+    FILE        *out = NULL;
+    uint32_t    *times = malloc(frames * sizeof(uint32_t));
+
+    if (out_name) {
+        out = fopen(out_name, "w");
+
+        if (!out) {
+            LV_LOG_ERROR("Can't create %s", out_name);
+        } else {
+            fprintf(out, "scenario,frames,avg_us,p50_us,p90_us,p99_us,max_us,px\n");
+        }
+    }
+
+    lv_scr_load(main_obj);
+    lv_refr_now(NULL);
+
+    printf("%-10s %8s %8s %8s %8s %8s %10s\n", "scenario", "avg_us", "p50_us", "p90_us", "p99_us", "max_us", "px");
+
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        if (scenario_enabled(scenarios[i].name)) {
+            run_scenario(&scenarios[i], times, out);
+        }
+    }
+
+    printf("event queue peak depth %zu\n", event_get_peak_depth());
+
+    if (out) {
+        fclose(out);
+    }
+    free(times);
+
+    exit(0);
+}
@@ -0,0 +1,28 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include "lvgl/lvgl.h"
+
+/**
+ * Headless render benchmark. Enabled with X6200_BENCH env:
+ * "all" or comma separated list of scenarios
+ */
+bool bench_init();
+
+/**
+ * In-memory display driver callbacks
+ */
+void bench_flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+void bench_monitor(lv_disp_drv_t *drv, uint32_t time, uint32_t px);
+
+/**
+ * Run scenarios on the main screen, print frame time statistics and exit
+ */
+void bench_run(lv_obj_t *main_obj);
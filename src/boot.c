@@ -0,0 +1,185 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "boot.h"
+
+#include "lvgl/lvgl.h"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <time.h>
+
+static pthread_mutex_t  mux = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   cond = PTHREAD_COND_INITIALIZER;
+
+static boot_task_t      *tasks;
+static size_t           count;
+static uint32_t         started;
+static uint32_t         done;
+static uint32_t         workers_mask;       /* Not BOOT_MAIN */
+static uint64_t         boot_start;
+static atomic_size_t    background_left;
+
+static uint64_t now_ms() {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000L + now.tv_nsec / 1000000L;
+}
+
+static void run_task(boot_task_t *task) {
+    uint64_t start = now_ms();
+
+    task->fn();
+
+    task->start = start - boot_start;
+    task->time = now_ms() - start;
+
+    if (task->where == BOOT_BACKGROUND) {
+        LV_LOG_USER("Boot %s: %" PRIu64 " ms, finished at %" PRIu64 " ms in background", task->name, task->time, task->start + task->time);
+    } else {
+        LV_LOG_USER("Boot %s: %" PRIu64 " ms", task->name, task->time);
+    }
+}
+
+/**
+ * Under mux
+ */
+static int next_ready() {
+    for (size_t i = 0; i < count; i++) {
+        uint32_t bit = BOOT_DEP(i);
+
+        if ((workers_mask & bit) && !(started & bit) && (done & tasks[i].deps) == tasks[i].deps) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static void * worker_thread(void *arg) {
+    pthread_mutex_lock(&mux);
+
+    while ((started & workers_mask) != workers_mask) {
+        int id = next_ready();
+
+        if (id < 0) {
+            pthread_cond_wait(&cond, &mux);
+            continue;
+        }
+
+        started |= BOOT_DEP(id);
+        pthread_mutex_unlock(&mux);
+
+        run_task(&tasks[id]);
+
+        pthread_mutex_lock(&mux);
+        done |= BOOT_DEP(id);
+
+        if (tasks[id].where == BOOT_BACKGROUND) {
+            background_left--;
+        }
+        pthread_cond_broadcast(&cond);
+    }
+
+    pthread_mutex_unlock(&mux);
+    return NULL;
+}
+
+void boot_run(boot_task_t *table, size_t table_count) {
+    uint32_t    wait_mask = 0;
+    size_t      workers = 0;
+
+    if (table_count > 32) {
+        LV_LOG_ERROR("Too many boot tasks: %zu", table_count);
+        table_count = 32;
+    }
+
+    pthread_mutex_lock(&mux);
+
+    tasks = table;
+    count = table_count;
+    started = 0;
+    done = 0;
+    workers_mask = 0;
+    boot_start = now_ms();
+
+    for (size_t i = 0; i < count; i++) {
+        boot_task_t *task = &tasks[i];
+
+        if (task->deps & ~(BOOT_DEP(i) - 1)) {
+            LV_LOG_ERROR("Boot %s depends on a later task", task->name);
+            task->deps &= BOOT_DEP(i) - 1;
+        }
+
+        if (task->where != BOOT_MAIN) {
+            workers_mask |= BOOT_DEP(i);
+            workers++;
+        }
+
+        if (task->where == BOOT_BACKGROUND) {
+            background_left++;
+        } else {
+            wait_mask |= BOOT_DEP(i);
+        }
+    }
+
+    pthread_mutex_unlock(&mux);
+
+    if (workers > BOOT_WORKERS) {
+        workers = BOOT_WORKERS;
+    }
+
+    for (size_t i = 0; i < workers; i++) {
+        pthread_t thread;
+
+        pthread_create(&thread, NULL, worker_thread, NULL);
+        pthread_detach(thread);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        boot_task_t *task = &tasks[i];
+
+        if (task->where != BOOT_MAIN) {
+            continue;
+        }
+
+        pthread_mutex_lock(&mux);
+
+        while ((done & task->deps) != task->deps) {
+            pthread_cond_wait(&cond, &mux);
+        }
+
+        started |= BOOT_DEP(i);
+        pthread_mutex_unlock(&mux);
+
+        run_task(task);
+
+        pthread_mutex_lock(&mux);
+        done |= BOOT_DEP(i);
+        pthread_cond_broadcast(&cond);
+        pthread_mutex_unlock(&mux);
+    }
+
+    pthread_mutex_lock(&mux);
+
+    while ((done & wait_mask) != wait_mask) {
+        pthread_cond_wait(&cond, &mux);
+    }
+
+    pthread_mutex_unlock(&mux);
+
+    LV_LOG_USER("Boot: %" PRIu64 " ms, %zu tasks left in background", now_ms() - boot_start, boot_background_left());
+}
+
+size_t boot_background_left() {
+    return background_left;
+}
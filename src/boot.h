@@ -0,0 +1,59 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Startup init graph. Every task names the tasks it needs, a task may
+ * depend only on the tasks before it in the table, so the graph has no
+ * cycles. LVGL tasks run on the calling thread in the table order, the
+ * rest run on workers as soon as their dependencies are done. Duration
+ * of every task is logged
+ */
+
+#define BOOT_WORKERS    3
+#define BOOT_DEP(id)    (1u << (id))
+
+typedef enum {
+    BOOT_MAIN = 0,      /* Calling thread, the only one allowed to touch LVGL */
+    BOOT_WORKER,        /* Worker thread, boot_run() waits for it */
+    BOOT_BACKGROUND     /* Worker thread, may finish after boot_run() */
+} boot_where_t;
+
+typedef struct {
+    const char      *name;
+    void            (*fn)(void);
+    boot_where_t    where;
+    uint32_t        deps;       /* BOOT_DEP() of the task indexes */
+
+    /* Filled by boot_run() */
+    uint64_t        start;      /* ms from boot_run() */
+    uint64_t        time;
+} boot_task_t;
+
+/**
+ * Up to 32 tasks. Returns when all BOOT_MAIN and BOOT_WORKER tasks are done,
+ * the table must live until the background tasks finish
+ */
+void boot_run(boot_task_t *tasks, size_t count);
+
+/**
+ * Background tasks still running
+ */
+size_t boot_background_left();
+
+#ifdef __cplusplus
+}
+#endif
@@ -85,6 +85,8 @@ static const char * key_mode_label_getter();
 static const char * iambic_mode_label_getter();
 static const char * qsk_time_label_getter();
 static const char * key_ratio_label_getter();
+static const char * key_farnsworth_label_getter();
+static const char * key_weight_label_getter();
 
 static const char * cw_decoder_label_getter();
 static const char * cw_tuner_label_getter();
@@ -266,6 +268,8 @@ static button_item_t btn_key_iambic_mode = {.type     = BTN_TEXT_FN,
                                             .subj     = &cfg.iambic_mode.val};
 static button_item_t btn_key_qsk_time    = make_btn(qsk_time_label_getter, MFK_QSK_TIME, &cfg.qsk_time.val);
 static button_item_t btn_key_ratio       = make_btn(key_ratio_label_getter, MFK_KEY_RATIO, &cfg.key_ratio.val);
+static button_item_t btn_key_farnsworth  = make_btn(key_farnsworth_label_getter, MFK_KEY_FARNSWORTH, &cfg.key_farnsworth.val);
+static button_item_t btn_key_weight      = make_btn(key_weight_label_getter, MFK_KEY_WEIGHT, &cfg.key_weight.val);
 
 static button_item_t btn_cw_decoder = {.type     = BTN_TEXT_FN,
                                        .label_fn = cw_decoder_label_getter,
@@ -332,6 +336,8 @@ static button_item_t btn_callsign = make_action_btn("Callsign", ACTION_APP_CALLS
 static button_item_t btn_settings = make_app_btn("Settings", ACTION_APP_SETTINGS);
 
 static button_item_t  btn_wifi   = make_app_btn("WiFi", ACTION_APP_WIFI);
+static button_item_t  btn_skimmer = make_app_btn("CW\nSkimmer", ACTION_APP_CW_SKIMMER);
+static button_item_t  btn_psk = make_app_btn("PSK", ACTION_APP_PSK);
 
 /* RTTY */
 static button_item_t btn_rtty_p1 = {
@@ -364,6 +370,31 @@ static button_item_t btn_rtty_reverse = {
     .data  = MFK_RTTY_REVERSE,
 };
 
+/* PSK */
+static button_item_t btn_psk_p1 = {
+    .type  = BTN_TEXT,
+    .label = "(PSK 1:1)",
+    .press = NULL,
+};
+static button_item_t btn_psk_rate = {
+    .type  = BTN_TEXT,
+    .label = "Rate",
+    .press = button_mfk_update_cb,
+    .data  = MFK_PSK_RATE,
+};
+static button_item_t btn_psk_center = {
+    .type  = BTN_TEXT,
+    .label = "Center",
+    .press = button_mfk_update_cb,
+    .data  = MFK_PSK_CENTER,
+};
+static button_item_t btn_psk_multi = {
+    .type  = BTN_TEXT,
+    .label = "Multi",
+    .press = button_mfk_update_cb,
+    .data  = MFK_PSK_MULTI,
+};
+
 
 /* VOL pages */
 static button_item_t btn_vol_p1 = make_page_btn("(VOL 1:3)", "Volume|page 1");
@@ -412,8 +443,9 @@ static buttons_page_t page_mem_2 = {
 };
 
 /* KEY pages */
-static button_item_t btn_key_p1 = make_page_btn("(KEY 1:2)", "Key|page 1");
-static button_item_t btn_key_p2 = make_page_btn("(KEY 2:2)", "Key|page 2");
+static button_item_t btn_key_p1 = make_page_btn("(KEY 1:3)", "Key|page 1");
+static button_item_t btn_key_p2 = make_page_btn("(KEY 2:3)", "Key|page 2");
+static button_item_t btn_key_p3 = make_page_btn("(KEY 3:3)", "Key|page 3");
 static button_item_t btn_cw_p1  = make_page_btn("(CW 1:2)", "CW|page 1");
 static button_item_t btn_cw_p2  = make_page_btn("(CW 2:2)", "CW|page 2");
 
@@ -423,6 +455,9 @@ static buttons_page_t page_key_1 = {
 static buttons_page_t page_key_2 = {
     {&btn_key_p2, &btn_key_mode, &btn_key_iambic_mode, &btn_key_qsk_time, &btn_key_ratio}
 };
+static buttons_page_t page_key_3 = {
+    {&btn_key_p3, &btn_key_farnsworth, &btn_key_weight}
+};
 static buttons_page_t page_cw_decoder_1 = {
     {&btn_cw_p1, &btn_cw_decoder, &btn_cw_tuner, &btn_cw_snr, &btn_cw_zoom}
 };
@@ -462,7 +497,7 @@ static buttons_page_t page_app_2 = {
     {&btn_app_p2, &btn_rec, &btn_qth, &btn_callsign, &btn_settings}
 };
 static buttons_page_t page_app_3 = {
-    {&btn_app_p3, &btn_wifi}
+    {&btn_app_p3, &btn_wifi, &btn_skimmer, &btn_psk}
 };
 
 /* RTTY */
@@ -471,6 +506,12 @@ buttons_page_t buttons_page_rtty = {
     {&btn_rtty_p1, &btn_rtty_rate, &btn_rtty_shift, &btn_rtty_center, &btn_rtty_reverse}
 };
 
+/* PSK */
+
+buttons_page_t buttons_page_psk = {
+    {&btn_psk_p1, &btn_psk_rate, &btn_psk_center, &btn_psk_multi}
+};
+
 buttons_group_t buttons_group_gen = {
     &buttons_page_vol_1,
     &page_vol_2,
@@ -492,6 +533,7 @@ buttons_group_t buttons_group_app = {
 buttons_group_t buttons_group_key = {
     &page_key_1,
     &page_key_2,
+    &page_key_3,
     &page_cw_decoder_1,
     &page_cw_decoder_2,
 };
@@ -971,6 +1013,24 @@ static const char * key_ratio_label_getter() {
     return buf;
 }
 
+static const char * key_farnsworth_label_getter() {
+    static char buf[22];
+    int32_t     x = subject_get_int(cfg.key_farnsworth.val);
+
+    if (x) {
+        sprintf(buf, "Farnsworth:\n%i wpm", x);
+    } else {
+        sprintf(buf, "Farnsworth:\nOff");
+    }
+    return buf;
+}
+
+static const char * key_weight_label_getter() {
+    static char buf[22];
+    sprintf(buf, "Weight:\n%i%%", subject_get_int(cfg.key_weight.val));
+    return buf;
+}
+
 static const char * cw_decoder_label_getter() {
     static char buf[22];
     sprintf(buf, "Decoder:\n%s", subject_get_int(cfg.cw_decoder.val) ? "On": "Off");
@@ -58,6 +58,7 @@ extern buttons_page_t buttons_page_msg_cw_1;
 extern buttons_page_t buttons_page_msg_cw_2;
 
 extern buttons_page_t buttons_page_rtty;
+extern buttons_page_t buttons_page_psk;
 
 extern buttons_group_t buttons_group_gen;
 extern buttons_group_t buttons_group_app;
@@ -22,6 +22,7 @@
 
 extern "C" {
     // #include "cfg/cfg.h"
+    #include "cfg/snapshot.h"
     #include "events.h"
     #include "main_screen.h"
     #include "meter.h"
@@ -411,22 +412,31 @@ static void set_unsupported(const Frame *req, Frame *resp) {
 static Frame *process_req(const Frame *req) {
     auto resp = new Frame(req);
 
+    cfg_snapshot_t snap;
+
+    cfg_snapshot_get(&snap);
+
     int32_t        new_freq;
-    x6200_vfo_t    cur_vfo    = (x6200_vfo_t)subject_get_int(cfg_cur.band->vfo.val);
-    int32_t        cur_freq   = subject_get_int(cfg_cur.fg_freq);
-    x6200_mode_t   cur_mode   = (x6200_mode_t)subject_get_int(cfg_cur.mode);
+    x6200_vfo_t    cur_vfo    = snap.vfo;
+    int32_t        cur_freq   = snap.fg_freq;
+    x6200_mode_t   cur_mode   = snap.mode;
     x6200_vfo_t    target_vfo = cur_vfo;
     uint8_t        vfo_id;
 
     size_t data_size = req->data.size();
 
-    struct vfo_params *vfo_params[2];
+    struct vfo_params           *vfo_params[2];
+    const cfg_snapshot_vfo_t    *vfo_snap[2];
     if (cur_vfo == X6200_VFO_A) {
         vfo_params[0] = &cfg_cur.band->vfo_a;
         vfo_params[1] = &cfg_cur.band->vfo_b;
+        vfo_snap[0] = &snap.vfo_a;
+        vfo_snap[1] = &snap.vfo_b;
     } else {
         vfo_params[0] = &cfg_cur.band->vfo_b;
         vfo_params[1] = &cfg_cur.band->vfo_a;
+        vfo_snap[0] = &snap.vfo_b;
+        vfo_snap[1] = &snap.vfo_a;
     }
 
 #if 0
@@ -528,7 +538,7 @@ static Frame *process_req(const Frame *req) {
         case C_CTL_SPLT:
             if (data_size == 0) {
                 resp->set_payload_len(2);
-                resp->data[0] = subject_get_int(cfg_cur.band->split.val);
+                resp->data[0] = snap.split;
             } else if (data_size == 1) {
                 subject_set_int(cfg_cur.band->split.val, req->data[0]);
                 resp->set_code(CODE_OK);
@@ -552,7 +562,7 @@ static Frame *process_req(const Frame *req) {
         case C_CTL_ATT:
             if (data_size == 0) {
                 resp->set_payload_len(2);
-                resp->data[0] = subject_get_int(cfg_cur.att) * 0x20;
+                resp->data[0] = snap.att * 0x20;
             } else if (data_size == 1) {
                 subject_set_int(cfg_cur.att, req->data[0]);
                 resp->set_code(CODE_OK);
@@ -664,7 +674,7 @@ static Frame *process_req(const Frame *req) {
                         // PRE
                         if (data_size == 1) {
                             resp->set_payload_len(3);
-                            resp->data[1] = subject_get_int(cfg_cur.pre);
+                            resp->data[1] = snap.pre;
                         } else {
                             subject_set_int(cfg_cur.pre, req->data[1] > 0);
                             resp->set_code(CODE_OK);
@@ -798,7 +808,7 @@ static Frame *process_req(const Frame *req) {
         case C_SEND_SEL_FREQ:
             if (data_size == 1) {
                 vfo_id       = req->data[0] > 0;
-                int32_t freq = subject_get_int(vfo_params[vfo_id]->freq.val);
+                int32_t freq = vfo_snap[vfo_id]->freq;
                 resp->set_payload_len(7);
                 to_bcd(&resp->data[1], freq, 10);
             } else if (data_size == 6) {
@@ -819,7 +829,7 @@ static Frame *process_req(const Frame *req) {
                 switch (data_size) {
                     case 1:
                         vfo_id    = req->data[0] > 0;
-                        v = x_mode_2_ci_mode((x6200_mode_t)subject_get_int(vfo_params[vfo_id]->mode.val), &data_mode);
+                        v = x_mode_2_ci_mode(vfo_snap[vfo_id]->mode, &data_mode);
                         resp->set_payload_len(5);
                         resp->data[1] = v;
                         resp->data[2] = data_mode;
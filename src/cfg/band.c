@@ -6,6 +6,7 @@
 #include "cfg.private.h"
 
 #include "transverter.h"
+#include "values.private.h"
 
 #include "../lvgl/lvgl.h"
 #include "band.h"
@@ -17,20 +18,11 @@
 static sqlite3      *db;
 static sqlite3_stmt *insert_stmt;
 static sqlite3_stmt *read_stmt;
-static sqlite3_stmt *read_band_by_pk_stmt;
-static sqlite3_stmt *read_band_by_freq_stmt;
-static sqlite3_stmt *find_up_band_stmt;
-static sqlite3_stmt *find_down_band_stmt;
-static sqlite3_stmt *read_all_bands_stmt;
+static sqlite3_stmt *read_all_params_stmt;
 
 static pthread_mutex_t write_mutex             = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t read_mutex              = PTHREAD_MUTEX_INITIALIZER;
-static pthread_mutex_t read_band_by_pk_mutex   = PTHREAD_MUTEX_INITIALIZER;
-static pthread_mutex_t read_band_by_freq_mutex = PTHREAD_MUTEX_INITIALIZER;
-static pthread_mutex_t find_up_down_band_mutex = PTHREAD_MUTEX_INITIALIZER;
-static pthread_mutex_t read_all_bands_mutex    = PTHREAD_MUTEX_INITIALIZER;
 
-static band_info_t _band_info_cache = {.id = BAND_UNDEFINED, .start_freq = 0, .stop_freq = 0};
 
 cfg_band_t cfg_band;
 
@@ -53,13 +45,15 @@ static void on_cur_att_change(Subject *subj, void *user_data);
 static void on_cur_pre_change(Subject *subj, void *user_data);
 
 static void fill_band_cfg_item(cfg_item_t *item, Subject * val, const char * db_name, int pk);
+static void load_items(cfg_item_t *cfg_arr, uint32_t count);
 
 void cfg_band_params_init(sqlite3 *database) {
     init_db(database);
+    band_plan_init(database);
 
     x6200_mode_t default_mode;
     int32_t      band_id      = subject_get_int(cfg.band_id.val);
-    band_info_t *band_info    = get_band_info_by_pk(band_id);
+    const band_info_t *band_info  = get_band_info_by_pk(band_id);
     uint32_t     default_freq = 14000000;
     if (band_info && (band_info->id != BAND_UNDEFINED)) {
         default_freq = (band_info->start_freq + band_info->stop_freq) / 2;
@@ -128,12 +122,12 @@ void cfg_band_params_init(sqlite3 *database) {
     cfg_item_t *cfg_arr  = (cfg_item_t *)&cfg_band;
     uint32_t    cfg_size = sizeof(cfg_band) / sizeof(*cfg_arr);
     init_items(cfg_arr, cfg_size, cfg_band_params_load_item, cfg_band_params_save_item);
-    load_items_from_db(cfg_arr, cfg_size);
+    load_items(cfg_arr, cfg_size);
 }
 
 
 void cfg_band_set_freq_for_vfo(x6200_vfo_t vfo, int32_t freq) {
-    band_info_t *band_info = get_band_info_by_freq(freq);
+    const band_info_t *band_info = get_band_info_by_freq(freq);
     if (band_info == NULL) {
         LV_LOG_ERROR("Unknown band, can't set freq %i for vfo %u", freq, vfo);
         return;
@@ -145,6 +139,7 @@ void cfg_band_set_freq_for_vfo(x6200_vfo_t vfo, int32_t freq) {
     } else {
         target = &cfg_band.vfo_b;
     }
+    subject_transaction_begin();
     if (new_band_id != target->freq.pk) {
         cfg_band.vfo.pk = new_band_id;
         save_item_to_db(&cfg_band.vfo, true);
@@ -157,6 +152,7 @@ void cfg_band_set_freq_for_vfo(x6200_vfo_t vfo, int32_t freq) {
         subject_set_int(cfg.band_id.val, new_band_id);
     }
     subject_set_int(target->freq.val, freq);
+    subject_transaction_commit();
 }
 
 void cfg_band_vfo_copy() {
@@ -168,191 +164,34 @@ void cfg_band_vfo_copy() {
         src = &cfg_band.vfo_b;
         dst = &cfg_band.vfo_a;
     }
+    subject_transaction_begin();
     subject_set_int(dst->freq.val, subject_get_int(src->freq.val));
     subject_set_int(dst->mode.val, subject_get_int(src->mode.val));
     subject_set_int(dst->agc.val, subject_get_int(src->agc.val));
     subject_set_int(dst->att.val, subject_get_int(src->att.val));
     subject_set_int(dst->pre.val, subject_get_int(src->pre.val));
+    subject_transaction_commit();
 }
 
 void cfg_band_load_next(bool up) {
-    int32_t      cur_freq  = subject_get_int(cfg_cur.fg_freq);
-    int32_t      cur_id    = cfg_band.vfo.pk;
-    band_info_t *band_info = get_band_info_next(cur_freq, up, cur_id);
+    int32_t            cur_freq  = subject_get_int(cfg_cur.fg_freq);
+    int32_t            cur_id    = cfg_band.vfo.pk;
+    const band_info_t *band_info = get_band_info_next(cur_freq, up, cur_id);
     if (band_info != NULL) {
+        subject_transaction_begin();
         subject_set_int(cfg.band_id.val, band_info->id);
+        subject_transaction_commit();
     }
 }
 
 const char *cfg_band_label_get() {
-    if (_band_info_cache.id != BAND_UNDEFINED) {
-        return _band_info_cache.name;
-    } else {
-        return "";
-    }
-}
-
-band_info_t *get_band_info_by_pk(int32_t band_id) {
-    int rc;
-    if (_band_info_cache.id == band_id) {
-        return &_band_info_cache;
-    }
-    LV_LOG_USER("Loading band info for id: %i", band_id);
-    sqlite3_stmt *stmt = read_band_by_pk_stmt;
-    pthread_mutex_lock(&read_band_by_pk_mutex);
-    rc = sqlite3_bind_int(stmt, sqlite3_bind_parameter_index(stmt, ":id"), band_id);
-    if (rc != SQLITE_OK) {
-        LV_LOG_ERROR("Failed to bind bands_id %i: %s", band_id, sqlite3_errmsg(db));
-        pthread_mutex_unlock(&read_band_by_pk_mutex);
-        return NULL;
-    }
-    rc = sqlite3_step(stmt);
-    if (rc == SQLITE_ROW) {
-        if (_band_info_cache.name) {
-            free(_band_info_cache.name);
-            _band_info_cache.name = NULL;
-        }
-        _band_info_cache.id         = band_id;
-        _band_info_cache.name       = strdup(sqlite3_column_text(stmt, 0));
-        _band_info_cache.start_freq = sqlite3_column_int(stmt, 1);
-        _band_info_cache.stop_freq  = sqlite3_column_int(stmt, 2);
-        _band_info_cache.active     = sqlite3_column_int(stmt, 3);
-        rc                          = 0;
-    } else {
-        LV_LOG_USER("No info for band with id: %i", band_id);
-        rc = -1;
-    }
-    sqlite3_reset(stmt);
-    sqlite3_clear_bindings(stmt);
-    pthread_mutex_unlock(&read_band_by_pk_mutex);
-    if (rc == 0)
-        return &_band_info_cache;
-    else
-        return NULL;
-}
-
-band_info_t *get_band_info_by_freq(uint32_t freq) {
-    if ((freq > _band_info_cache.start_freq) && (freq <= _band_info_cache.stop_freq))
-        return &_band_info_cache;
-    LV_LOG_USER("Loading band info for freq: %u", freq);
-    int           rc;
-    sqlite3_stmt *stmt = read_band_by_freq_stmt;
-    pthread_mutex_lock(&read_band_by_freq_mutex);
-    rc = sqlite3_bind_int(stmt, sqlite3_bind_parameter_index(stmt, ":freq"), freq);
-    if (rc != SQLITE_OK) {
-        LV_LOG_ERROR("Failed to bind freq %lu to read_band_by_freq_stmt: %s", freq, sqlite3_errmsg(db));
-        pthread_mutex_unlock(&read_band_by_freq_mutex);
-        return NULL;
-    }
-    rc = sqlite3_step(stmt);
-    if (rc == SQLITE_ROW) {
-        if (_band_info_cache.name) {
-            free(_band_info_cache.name);
-            _band_info_cache.name = NULL;
-        }
-        if (sqlite3_column_type(stmt, 0) != SQLITE_NULL) {
-            _band_info_cache.id     = sqlite3_column_int(stmt, 0);
-            _band_info_cache.name   = strdup(sqlite3_column_text(stmt, 1));
-            _band_info_cache.active = true;
-        } else {
-            _band_info_cache.id     = BAND_UNDEFINED;
-            _band_info_cache.active = false;
-        }
-        _band_info_cache.start_freq = sqlite3_column_int(stmt, 2);
-        if (sqlite3_column_type(stmt, 3) == SQLITE_NULL) {
-            _band_info_cache.stop_freq = 0LU - 1;
-        } else {
-            _band_info_cache.stop_freq = sqlite3_column_int(stmt, 3);
-        }
-        rc = 0;
-    } else {
-        LV_LOG_WARN("No band info for freq: %lu", freq);
-        rc = -1;
-    }
-    sqlite3_reset(stmt);
-    sqlite3_clear_bindings(stmt);
-    pthread_mutex_unlock(&read_band_by_freq_mutex);
-    if (rc == 0) {
-        return &_band_info_cache;
-    } else {
-        return NULL;
-    }
-}
+    const band_info_t *band_info = get_band_info_by_pk(cfg_band.vfo.pk);
 
-band_info_t *get_band_info_next(uint32_t freq, bool up, int32_t cur_id) {
-    int           rc;
-    sqlite3_stmt *stmt;
-    pthread_mutex_lock(&find_up_down_band_mutex);
-    if (up) {
-        stmt = find_up_band_stmt;
+    if (band_info && band_info->name) {
+        return band_info->name;
     } else {
-        stmt = find_down_band_stmt;
-    }
-    rc = sqlite3_bind_int(stmt, sqlite3_bind_parameter_index(stmt, ":freq"), freq);
-    if (rc != SQLITE_OK) {
-        LV_LOG_ERROR("Failed to bind freq %lu to find up/down stmt: %s", freq, sqlite3_errmsg(db));
-        pthread_mutex_unlock(&find_up_down_band_mutex);
-        return NULL;
-    }
-    rc = sqlite3_bind_int(stmt, sqlite3_bind_parameter_index(stmt, ":id"), cur_id);
-    if (rc != SQLITE_OK) {
-        LV_LOG_ERROR("Failed to current band id %i to find up/down stmt: %s", cur_id, sqlite3_errmsg(db));
-        pthread_mutex_unlock(&find_up_down_band_mutex);
-        return NULL;
-    }
-    rc = sqlite3_step(stmt);
-    if (rc == SQLITE_ROW) {
-        if (_band_info_cache.name) {
-            free(_band_info_cache.name);
-            _band_info_cache.name = NULL;
-        }
-        _band_info_cache.id         = sqlite3_column_int(stmt, 0);
-        _band_info_cache.name       = strdup(sqlite3_column_text(stmt, 1));
-        _band_info_cache.active     = true;
-        _band_info_cache.start_freq = sqlite3_column_int(stmt, 2);
-        _band_info_cache.stop_freq  = sqlite3_column_int(stmt, 3);
-        rc                          = 0;
-    } else {
-        LV_LOG_INFO("No next band info for freq: %lu, cur_id: %i and direction: %u", freq, cur_id, up);
-        rc = -1;
-    }
-    sqlite3_reset(stmt);
-    sqlite3_clear_bindings(stmt);
-    pthread_mutex_unlock(&find_up_down_band_mutex);
-    if (rc == 0) {
-        return &_band_info_cache;
-    } else {
-        return NULL;
-    }
-}
-
-uint32_t cfg_band_read_all_bands(band_info_t **results, int32_t *cap) {
-    int           rc;
-    sqlite3_stmt *stmt = read_all_bands_stmt;
-    uint32_t      i    = 0;
-    while (1) {
-        rc = sqlite3_step(stmt);
-
-        if (rc == SQLITE_ROW) {
-            if (i >= *cap) {
-                *cap *= 2;
-                *results = realloc(*results, sizeof(**results) * *cap);
-            }
-            (*results)[i].id         = sqlite3_column_int(stmt, 0);
-            (*results)[i].name       = strdup(sqlite3_column_text(stmt, 1));
-            (*results)[i].start_freq = sqlite3_column_int(stmt, 2);
-            (*results)[i].stop_freq  = sqlite3_column_int(stmt, 3);
-            (*results)[i].active     = sqlite3_column_int(stmt, 4);
-            i++;
-        } else if (rc == SQLITE_DONE) {
-            break;
-        } else {
-            LV_LOG_ERROR("Error while reading bands rows: %s", sqlite3_errmsg(db));
-            break;
-        }
+        return "";
     }
-    sqlite3_reset(stmt);
-    return i;
 }
 
 void cfg_band_params_save_all() {
@@ -360,9 +199,13 @@ void cfg_band_params_save_all() {
     int32_t     cfg_arr_size = sizeof(cfg_band) / sizeof(*cfg_arr);
 
     LV_LOG_USER("Save band params for pk=%i", cfg_arr[0].pk);
+    if (!cfg_db_begin()) {
+        return;
+    }
     for (size_t i = 0; i < cfg_arr_size; i++) {
         save_item_to_db(&cfg_arr[i], false);
     }
+    cfg_db_commit();
 }
 
 void cfg_band_params_change_pk(int32_t pk) {
@@ -379,17 +222,20 @@ void cfg_band_params_load_all() {
     cfg_item_t *cfg_arr      = (cfg_item_t *)&cfg_band;
     int32_t     cfg_arr_size = sizeof(cfg_band) / sizeof(*cfg_arr);
     LV_LOG_USER("Load band params for pk=%i", cfg_arr[0].pk);
-    load_items_from_db(cfg_arr, cfg_arr_size);
+    load_items(cfg_arr, cfg_arr_size);
 }
 
-int cfg_band_params_load_item(cfg_item_t *item) {
+/**
+ * Value from values (params of the item's band) if given, otherwise from db
+ */
+static int load_item(cfg_item_t *item, db_values_t *values) {
     enum data_type dtype = subject_get_dtype(item->val);
     if (dtype != DTYPE_INT) {
         LV_LOG_WARN("Unknown item %s dtype: %u, can't load", item->db_name, dtype);
         return -1;
     }
 
-    band_info_t *band_info = get_band_info_by_pk(item->pk);
+    const band_info_t *band_info = get_band_info_by_pk(item->pk);
     if (!band_info) {
         LV_LOG_ERROR("Can't load band info for pk: %i", item->pk);
         return -1;
@@ -398,22 +244,28 @@ int cfg_band_params_load_item(cfg_item_t *item) {
     pthread_mutex_lock(&read_mutex);
     int     rc;
     int32_t int_val;
-    rc = sqlite3_bind_text(stmt, sqlite3_bind_parameter_index(stmt, ":name"), item->db_name, strlen(item->db_name), 0);
-    if (rc != SQLITE_OK) {
-        LV_LOG_ERROR("Failed to bind name %s: %s", item->db_name, sqlite3_errmsg(db));
-        pthread_mutex_unlock(&read_mutex);
-        return rc;
-    }
-    rc = sqlite3_bind_int(stmt, sqlite3_bind_parameter_index(stmt, ":id"), item->pk);
-    if (rc != SQLITE_OK) {
-        LV_LOG_ERROR("Failed to bind bands_id %i: %s", item->pk, sqlite3_errmsg(db));
-        pthread_mutex_unlock(&read_mutex);
-        return rc;
+    const db_value_t *value = NULL;
+    if (values) {
+        value = db_values_get(values, item->db_name);
+        rc = value ? SQLITE_ROW : SQLITE_DONE;
+    } else {
+        rc = sqlite3_bind_text(stmt, sqlite3_bind_parameter_index(stmt, ":name"), item->db_name, strlen(item->db_name), 0);
+        if (rc != SQLITE_OK) {
+            LV_LOG_ERROR("Failed to bind name %s: %s", item->db_name, sqlite3_errmsg(db));
+            pthread_mutex_unlock(&read_mutex);
+            return rc;
+        }
+        rc = sqlite3_bind_int(stmt, sqlite3_bind_parameter_index(stmt, ":id"), item->pk);
+        if (rc != SQLITE_OK) {
+            LV_LOG_ERROR("Failed to bind bands_id %i: %s", item->pk, sqlite3_errmsg(db));
+            pthread_mutex_unlock(&read_mutex);
+            return rc;
+        }
+        rc = sqlite3_step(stmt);
     }
 
-    rc = sqlite3_step(stmt);
     if (rc == SQLITE_ROW) {
-        int_val = sqlite3_column_int(stmt, 0);
+        int_val = value ? value->int_val : sqlite3_column_int(stmt, 0);
         rc = 0;
     } else {
         if (strcmp(item->db_name, "vfob_freq") == 0) {
@@ -449,9 +301,13 @@ int cfg_band_params_load_item(cfg_item_t *item) {
     return rc;
 }
 
+int cfg_band_params_load_item(cfg_item_t *item) {
+    return load_item(item, NULL);
+}
+
 int cfg_band_params_save_item(cfg_item_t *item) {
     int32_t      start_freq, stop_freq, band_id;
-    band_info_t *band_info = get_band_info_by_pk(item->pk);
+    const band_info_t *band_info = get_band_info_by_pk(item->pk);
     if (!band_info) {
         band_id = BAND_UNDEFINED;
     } else {
@@ -528,53 +384,15 @@ static void init_db(sqlite3 *database) {
         LV_LOG_ERROR("Failed prepare read statement: %s", sqlite3_errmsg(db));
         exit(1);
     }
-    rc = sqlite3_prepare_v2(db, "INSERT OR REPLACE INTO band_params(bands_id, name, val) VALUES(:id, :name, :val)", -1,
-                            &insert_stmt, 0);
-    if (rc != SQLITE_OK) {
-        LV_LOG_ERROR("Failed prepare write statement: %s", sqlite3_errmsg(db));
-        exit(1);
-    }
-    rc = sqlite3_prepare_v2(db, "SELECT name, start_freq, stop_freq, type FROM bands WHERE id = :id", -1,
-                            &read_band_by_pk_stmt, 0);
+    rc = sqlite3_prepare_v2(db, "SELECT name, val FROM band_params WHERE bands_id = :id", -1, &read_all_params_stmt, 0);
     if (rc != SQLITE_OK) {
-        LV_LOG_ERROR("Failed prepare read_band_by_pk_stmt statement: %s", sqlite3_errmsg(db));
+        LV_LOG_ERROR("Failed prepare read all statement: %s", sqlite3_errmsg(db));
         exit(1);
     }
-    rc = sqlite3_prepare_v2(
-        db,
-        "SELECT id, name, start_freq, stop_freq FROM bands WHERE "
-        "   (:freq >= start_freq) AND (:freq <= stop_freq) AND (type = 1) "
-        "UNION SELECT * FROM ("
-        "   SELECT NULL, NULL, a.stop_freq, b.start_freq FROM ("
-        "       SELECT stop_freq FROM bands WHERE :freq > stop_freq AND type = 1 ORDER BY stop_freq DESC LIMIT 1"
-        "   ) AS a FULL OUTER JOIN ("
-        "       SELECT start_freq FROM bands WHERE :freq < start_freq AND type = 1 ORDER BY start_freq LIMIT 1"
-        "   ) AS b"
-        ") ORDER BY id DESC NULLS LAST LIMIT 1",
-        -1, &read_band_by_freq_stmt, 0);
-    if (rc != SQLITE_OK) {
-        LV_LOG_ERROR("Failed prepare read_band_by_freq_stmt statement: %s", sqlite3_errmsg(db));
-        exit(1);
-    }
-    rc = sqlite3_prepare_v2(db,
-                            "SELECT id, name, start_freq, stop_freq, type FROM bands "
-                            "WHERE :freq <= start_freq AND id != :id AND type = 1 ORDER BY start_freq LIMIT 1",
-                            -1, &find_up_band_stmt, 0);
-    if (rc != SQLITE_OK) {
-        LV_LOG_ERROR("Failed prepare find_up_band_stmt statement: %s", sqlite3_errmsg(db));
-        exit(1);
-    }
-    rc = sqlite3_prepare_v2(db,
-                            "SELECT id, name, start_freq, stop_freq, type FROM bands "
-                            "WHERE :freq >= stop_freq AND id != :id AND type = 1 ORDER BY start_freq DESC LIMIT 1",
-                            -1, &find_down_band_stmt, 0);
-    if (rc != SQLITE_OK) {
-        LV_LOG_ERROR("Failed prepare find_down_band_stmt statement: %s", sqlite3_errmsg(db));
-        exit(1);
-    }
-    rc = sqlite3_prepare_v2(db, "SELECT id, name, start_freq, stop_freq, type FROM bands", -1, &read_all_bands_stmt, 0);
+    rc = sqlite3_prepare_v2(db, "INSERT OR REPLACE INTO band_params(bands_id, name, val) VALUES(:id, :name, :val)", -1,
+                            &insert_stmt, 0);
     if (rc != SQLITE_OK) {
-        LV_LOG_ERROR("Failed prepare read_all_bands statement: %s", sqlite3_errmsg(db));
+        LV_LOG_ERROR("Failed prepare write statement: %s", sqlite3_errmsg(db));
         exit(1);
     }
 }
@@ -677,14 +495,16 @@ static void on_ab_pre_change(Subject *subj, void *user_data) {
 }
 
 /**
- * Change freq/mode on changing band
+ * Change freq/mode on changing band. Loaded params are delivered at once
  */
 static void on_band_id_change(Subject *subj, void *user_data) {
     int32_t new_band_id = subject_get_int(subj);
     if (new_band_id != cfg_band.vfo.pk) {
+        subject_transaction_begin();
         cfg_band_params_save_all();
         cfg_band_params_change_pk(new_band_id);
         cfg_band_params_load_all();
+        subject_transaction_commit();
     }
 }
 
@@ -705,12 +525,14 @@ static void on_vfo_change(Subject *subj, void *user_data) {
         pre_src    = cfg_band.vfo_b.pre.val;
         att_src    = cfg_band.vfo_b.att.val;
     }
+    subject_transaction_begin();
     subject_set_int(cfg_cur.fg_freq, subject_get_int(fg_freq_src));
     subject_set_int(cfg_cur.bg_freq, subject_get_int(bg_freq_src));
     subject_set_int(cfg_cur.mode, subject_get_int(mode_src));
     subject_set_int(cfg_cur.agc, subject_get_int(agc_src));
     subject_set_int(cfg_cur.pre, subject_get_int(pre_src));
     subject_set_int(cfg_cur.att, subject_get_int(att_src));
+    subject_transaction_commit();
 }
 
 static void on_cur_mode_change(Subject *subj, void *user_data) {
@@ -761,6 +583,34 @@ static void on_cur_pre_change(Subject *subj, void *user_data) {
     subject_set_int(target_subj, new_pre);
 }
 
+/**
+ * Params of the band are read by one query and passed down to the items with its pk
+ */
+static void load_items(cfg_item_t *cfg_arr, uint32_t count) {
+    int32_t     pk = cfg_arr[0].pk;
+    db_values_t *values = NULL;
+
+    pthread_mutex_lock(&read_mutex);
+    if (sqlite3_bind_int(read_all_params_stmt, sqlite3_bind_parameter_index(read_all_params_stmt, ":id"), pk) ==
+        SQLITE_OK) {
+        values = db_values_load(read_all_params_stmt);
+    }
+    sqlite3_clear_bindings(read_all_params_stmt);
+    pthread_mutex_unlock(&read_mutex);
+
+    for (size_t i = 0; i < count; i++) {
+        cfg_arr[i].dirty->val = ITEM_STATE_LOADING;
+        if (load_item(&cfg_arr[i], cfg_arr[i].pk == pk ? values : NULL) != 0) {
+            LV_LOG_USER("Can't load %s (pk=%i)", cfg_arr[i].db_name, cfg_arr[i].pk);
+        }
+        cfg_arr[i].dirty->val = ITEM_STATE_CLEAN;
+    }
+
+    if (values) {
+        db_values_free(values);
+    }
+}
+
 static void fill_band_cfg_item(cfg_item_t *item, Subject * val, const char * db_name, int pk) {
     fill_cfg_item(item, val, db_name);
     item->pk = pk;
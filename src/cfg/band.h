@@ -4,6 +4,8 @@
 
 #include <aether_radio/x6200_control/control.h>
 
+#include <stddef.h>
+
 typedef struct {
     int32_t  id;
     char    *name;
@@ -37,4 +39,8 @@ void cfg_band_set_freq_for_vfo(x6200_vfo_t vfo, int32_t freq);
 void        cfg_band_vfo_copy();
 void        cfg_band_load_next(bool up);
 const char *cfg_band_label_get();
-uint32_t    cfg_band_read_all_bands(band_info_t **results, int32_t *cap);
+
+/**
+ * All bands sorted by start frequency. Lock-free, the array is never freed
+ */
+const band_info_t *cfg_band_plan_get(size_t *count);
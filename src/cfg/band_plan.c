@@ -0,0 +1,385 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "band_plan.private.h"
+#include "band.private.h"
+
+#include "../lvgl/lvgl.h"
+#include "../util.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Starts and stops of the bands with type 1 split the frequency range into
+ * segments. Segment k is (seg_hi[k - 1], seg_hi[k]] and has a band or a gap,
+ * so the lookup by frequency is a binary search over seg_hi
+ */
+
+typedef struct {
+    band_info_t         *bands;             /* Sorted by start_freq, id */
+    size_t              count;
+    const band_info_t   **by_id;            /* Sorted by id */
+    const band_info_t   **active;           /* Type 1, sorted by start_freq */
+    size_t              active_count;
+
+    uint32_t            *seg_hi;
+    const band_info_t   **seg_band;
+    size_t              seg_count;
+    band_info_t         *gaps;
+} band_plan_t;
+
+#define WAL_AUTOCHECKPOINT  1000            /* Pages, default of sqlite3_wal_autocheckpoint() */
+
+static sqlite3                      *db;
+static sqlite3_stmt                 *read_all_stmt;
+static pthread_mutex_t              build_mutex = PTHREAD_MUTEX_INITIALIZER;
+static _Atomic(const band_plan_t *) current;
+static const band_plan_t            *previous;
+static atomic_bool                  dirty;
+
+static const band_info_t            undefined = {
+    .id = BAND_UNDEFINED, .name = NULL, .start_freq = 0, .stop_freq = UINT32_MAX, .active = 0
+};
+
+static const band_plan_t            empty = {
+    .seg_hi = (uint32_t[]) { UINT32_MAX },
+    .seg_band = (const band_info_t *[]) { &undefined },
+    .seg_count = 1
+};
+
+static int compare_start(const void *p1, const void *p2) {
+    const band_info_t *a = p1;
+    const band_info_t *b = p2;
+
+    if (a->start_freq != b->start_freq) {
+        return a->start_freq < b->start_freq ? -1 : 1;
+    }
+
+    return (a->id > b->id) - (a->id < b->id);
+}
+
+static int compare_id(const void *p1, const void *p2) {
+    const band_info_t *a = *(const band_info_t **) p1;
+    const band_info_t *b = *(const band_info_t **) p2;
+
+    return (a->id > b->id) - (a->id < b->id);
+}
+
+static int compare_u32(const void *p1, const void *p2) {
+    uint32_t a = *(const uint32_t *) p1;
+    uint32_t b = *(const uint32_t *) p2;
+
+    return (a > b) - (a < b);
+}
+
+static bool read_bands(band_plan_t *plan) {
+    size_t  cap = 64;
+    int     rc;
+
+    plan->bands = malloc(cap * sizeof(band_info_t));
+
+    while ((rc = sqlite3_step(read_all_stmt)) == SQLITE_ROW) {
+        if (plan->count == cap) {
+            cap *= 2;
+            plan->bands = realloc(plan->bands, cap * sizeof(band_info_t));
+        }
+
+        band_info_t *band = &plan->bands[plan->count++];
+        const char  *name = (const char *) sqlite3_column_text(read_all_stmt, 1);
+
+        band->id = sqlite3_column_int(read_all_stmt, 0);
+        band->name = strdup(name ? name : "");
+        band->start_freq = sqlite3_column_int(read_all_stmt, 2);
+        band->stop_freq = sqlite3_column_int(read_all_stmt, 3);
+        band->active = sqlite3_column_int(read_all_stmt, 4);
+    }
+
+    sqlite3_reset(read_all_stmt);
+
+    if (rc != SQLITE_DONE) {
+        LV_LOG_ERROR("Error while reading bands rows: %s", sqlite3_errmsg(db));
+        return false;
+    }
+
+    return true;
+}
+
+static const band_info_t * covering_band(const band_plan_t *plan, uint32_t freq) {
+    const band_info_t *res = NULL;
+
+    for (size_t i = 0; i < plan->active_count && plan->active[i]->start_freq < freq; i++) {
+        const band_info_t *band = plan->active[i];
+
+        if (freq <= band->stop_freq && (!res || band->id > res->id)) {
+            res = band;
+        }
+    }
+
+    return res;
+}
+
+static void make_gap(const band_plan_t *plan, band_info_t *gap, uint32_t lo, uint32_t hi) {
+    *gap = undefined;
+
+    for (size_t i = 0; i < plan->active_count; i++) {
+        const band_info_t *band = plan->active[i];
+
+        if (band->stop_freq <= lo && band->stop_freq > gap->start_freq) {
+            gap->start_freq = band->stop_freq;
+        }
+
+        if (band->start_freq >= hi && band->start_freq < gap->stop_freq) {
+            gap->stop_freq = band->start_freq;
+        }
+    }
+}
+
+static void build_segments(band_plan_t *plan) {
+    size_t      n = 0;
+    uint32_t    *bounds = malloc((plan->active_count * 2 + 1) * sizeof(uint32_t));
+
+    for (size_t i = 0; i < plan->active_count; i++) {
+        bounds[n++] = plan->active[i]->start_freq;
+        bounds[n++] = plan->active[i]->stop_freq;
+    }
+
+    qsort(bounds, n, sizeof(uint32_t), compare_u32);
+
+    size_t unique = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        if (unique == 0 || bounds[i] != bounds[unique - 1]) {
+            bounds[unique++] = bounds[i];
+        }
+    }
+
+    if (unique == 0 || bounds[unique - 1] != UINT32_MAX) {
+        bounds[unique++] = UINT32_MAX;
+    }
+
+    plan->seg_hi = bounds;
+    plan->seg_count = unique;
+    plan->seg_band = malloc(unique * sizeof(band_info_t *));
+    plan->gaps = malloc(unique * sizeof(band_info_t));
+
+    for (size_t k = 0; k < unique; k++) {
+        const band_info_t *band = covering_band(plan, bounds[k]);
+
+        if (!band) {
+            make_gap(plan, &plan->gaps[k], k ? bounds[k - 1] : 0, bounds[k]);
+            band = &plan->gaps[k];
+        }
+
+        plan->seg_band[k] = band;
+    }
+}
+
+static void plan_free(band_plan_t *plan) {
+    if (!plan) {
+        return;
+    }
+
+    for (size_t i = 0; i < plan->count; i++) {
+        free(plan->bands[i].name);
+    }
+
+    free(plan->bands);
+    free(plan->by_id);
+    free(plan->active);
+    free(plan->seg_hi);
+    free(plan->seg_band);
+    free(plan->gaps);
+    free(plan);
+}
+
+/**
+ * Called with build_mutex locked. Readers don't hold any lock on the plans,
+ * so the replaced one is kept until the next rebuild and the one before it
+ * is freed: lookups last much less than the time between band edits
+ */
+static void rebuild() {
+    uint64_t    start = get_time();
+    band_plan_t *plan = calloc(1, sizeof(band_plan_t));
+
+    if (!read_bands(plan)) {
+        plan_free(plan);
+        return;
+    }
+
+    qsort(plan->bands, plan->count, sizeof(band_info_t), compare_start);
+
+    plan->by_id = malloc(plan->count * sizeof(band_info_t *));
+    plan->active = malloc(plan->count * sizeof(band_info_t *));
+
+    for (size_t i = 0; i < plan->count; i++) {
+        plan->by_id[i] = &plan->bands[i];
+
+        if (plan->bands[i].active == 1) {
+            plan->active[plan->active_count++] = &plan->bands[i];
+        }
+    }
+
+    qsort(plan->by_id, plan->count, sizeof(band_info_t *), compare_id);
+    build_segments(plan);
+
+    const band_plan_t *old = atomic_exchange_explicit(&current, plan, memory_order_acq_rel);
+
+    plan_free((band_plan_t *) previous);
+    previous = old;
+
+    LV_LOG_USER("Band plan: %zu bands, %zu segments in %llu ms", plan->count, plan->seg_count, (unsigned long long) (get_time() - start));
+}
+
+/**
+ * Inside the writing statement, the change is not committed yet
+ */
+static void on_update(void *arg, int op, const char *database, const char *table, sqlite3_int64 rowid) {
+    if (strcmp(table, "bands") == 0) {
+        atomic_store_explicit(&dirty, true, memory_order_release);
+    }
+}
+
+/**
+ * On the writer thread after the commit, with the write lock released. Replaces
+ * the auto checkpoint hook, so it checkpoints the same way
+ */
+static int on_commit(void *arg, sqlite3 *handle, const char *database, int pages) {
+    if (atomic_exchange(&dirty, false)) {
+        pthread_mutex_lock(&build_mutex);
+        rebuild();
+        pthread_mutex_unlock(&build_mutex);
+    }
+
+    if (pages >= WAL_AUTOCHECKPOINT) {
+        sqlite3_wal_checkpoint(handle, database);
+    }
+
+    return SQLITE_OK;
+}
+
+static const band_plan_t * plan_get() {
+    const band_plan_t *plan = atomic_load_explicit(&current, memory_order_acquire);
+
+    return plan ? plan : &empty;
+}
+
+void band_plan_init(sqlite3 *database) {
+    db = database;
+
+    int rc = sqlite3_prepare_v2(db, "SELECT id, name, start_freq, stop_freq, type FROM bands", -1, &read_all_stmt, 0);
+
+    if (rc != SQLITE_OK) {
+        LV_LOG_ERROR("Failed prepare read all bands statement: %s", sqlite3_errmsg(db));
+        exit(1);
+    }
+
+    pthread_mutex_lock(&build_mutex);
+    rebuild();
+    pthread_mutex_unlock(&build_mutex);
+
+    sqlite3_update_hook(db, on_update, NULL);
+    sqlite3_wal_hook(db, on_commit, NULL);
+}
+
+const band_info_t *get_band_info_by_pk(int32_t band_id) {
+    if (band_id == BAND_UNDEFINED) {
+        return &undefined;
+    }
+
+    const band_plan_t   *plan = plan_get();
+    size_t              lo = 0;
+    size_t              hi = plan->count;
+
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+
+        if (plan->by_id[mid]->id < band_id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo < plan->count && plan->by_id[lo]->id == band_id) {
+        return plan->by_id[lo];
+    }
+
+    LV_LOG_USER("No info for band with id: %i", band_id);
+    return NULL;
+}
+
+const band_info_t *get_band_info_by_freq(uint32_t freq) {
+    const band_plan_t   *plan = plan_get();
+    size_t              lo = 0;
+    size_t              hi = plan->seg_count - 1;
+
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+
+        if (plan->seg_hi[mid] < freq) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return plan->seg_band[lo];
+}
+
+const band_info_t *get_band_info_next(uint32_t freq, bool up, int32_t cur_id) {
+    const band_plan_t   *plan = plan_get();
+    size_t              lo = 0;
+    size_t              hi = plan->active_count;
+
+    /* First band with start_freq >= freq */
+
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+
+        if (plan->active[mid]->start_freq < freq) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (up) {
+        for (size_t i = lo; i < plan->active_count; i++) {
+            if (plan->active[i]->id != cur_id) {
+                return plan->active[i];
+            }
+        }
+    } else {
+        /* Bands with start_freq == freq may end at freq too */
+
+        while (lo < plan->active_count && plan->active[lo]->start_freq == freq) {
+            lo++;
+        }
+
+        for (size_t i = lo; i > 0; i--) {
+            const band_info_t *band = plan->active[i - 1];
+
+            if (band->stop_freq <= freq && band->id != cur_id) {
+                return band;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+const band_info_t *cfg_band_plan_get(size_t *count) {
+    const band_plan_t *plan = plan_get();
+
+    *count = plan->count;
+
+    return plan->bands;
+}
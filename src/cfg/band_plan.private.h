@@ -0,0 +1,30 @@
+#pragma once
+
+#include "band.h"
+
+#include <sqlite3.h>
+
+/*
+ * Band plan from the bands table, built once and rebuilt by the writer after
+ * a change of the table commits. Lookups are a single atomic load from any
+ * thread. Returned bands are valid until the second rebuild, so they are
+ * not kept between calls
+ */
+
+void band_plan_init(sqlite3 *database);
+
+/**
+ * Any band type. BAND_UNDEFINED gives the whole range without a name
+ */
+const band_info_t *get_band_info_by_pk(int32_t band_id);
+
+/**
+ * Band with type 1 over (start_freq, stop_freq], the higher id on overlap.
+ * Outside of them the gap between the neighbour bands with BAND_UNDEFINED id
+ */
+const band_info_t *get_band_info_by_freq(uint32_t freq);
+
+/**
+ * Band with type 1 starting from freq up or ending to freq down, except cur_id
+ */
+const band_info_t *get_band_info_next(uint32_t freq, bool up, int32_t cur_id);
@@ -7,9 +7,11 @@
 #include "transverter.private.h"
 #include "memory.private.h"
 #include "digital_modes.private.h"
+#include "snapshot.private.h"
 
 #include "../lvgl/lvgl.h"
 #include "../util.h"
+#include "../params/db.h"
 #include <aether_radio/x6200_control/control.h>
 
 #include <stdio.h>
@@ -21,6 +23,9 @@ cfg_cur_t cfg_cur;
 
 static band_info_t cur_band_info;
 
+static pthread_mutex_t  save_mutex = PTHREAD_MUTEX_INITIALIZER;
+static cfg_save_stat_t  save_stat;
+
 static int init_params_cfg(sqlite3 *db);
 static void bind_observers();
 
@@ -55,6 +60,7 @@ static void on_cur_fft_width_change(Subject *subj, void *user_data);
 
 int cfg_init(sqlite3 *db) {
     int rc;
+    uint64_t start = get_time();
 
     rc = init_params_cfg(db);
     if (rc != 0) {
@@ -84,6 +90,9 @@ int cfg_init(sqlite3 *db) {
     cfg_digital_modes_init(db);
 
     bind_observers();
+    cfg_snapshot_init();
+
+    LV_LOG_USER("Config loaded in %llu ms", (unsigned long long) (get_time() - start));
 
     pthread_t thread;
     pthread_create(&thread, NULL, params_save_thread, NULL);
@@ -199,28 +208,43 @@ int load_items_from_db(cfg_item_t *cfg_arr, uint32_t count) {
     return rc;
 }
 
+bool cfg_db_begin() {
+    return database_begin();
+}
+
+void cfg_db_commit() {
+    database_commit();
+}
+
 /**
  * Save items to db
  */
 
-void save_item_to_db(cfg_item_t *item, bool force) {
-    int rc;
+bool save_item_to_db(cfg_item_t *item, bool force) {
+    int  rc;
+    bool saved = false;
     pthread_mutex_lock(&item->dirty->mux);
     if ((item->dirty->val == ITEM_STATE_CHANGED) || force) {
         rc = item->save(item);
         if (rc != 0) {
             LV_LOG_USER("Can't save %s (pk=%i)", item->db_name, item->pk);
+        } else {
+            saved = true;
         }
         item->dirty->val = ITEM_STATE_CLEAN;
     }
     pthread_mutex_unlock(&item->dirty->mux);
+    return saved;
 }
 
-void save_items_to_db(cfg_item_t *cfg_arr, uint32_t cfg_size) {
-    int rc;
+uint32_t save_items_to_db(cfg_item_t *cfg_arr, uint32_t cfg_size) {
+    uint32_t count = 0;
     for (size_t i = 0; i < cfg_size; i++) {
-        save_item_to_db(&cfg_arr[i], false);
+        if (save_item_to_db(&cfg_arr[i], false)) {
+            count++;
+        }
     }
+    return count;
 }
 
 /**
@@ -239,30 +263,54 @@ void fill_cfg_item_float(cfg_item_t *item, Subject * val, float db_scale, const
 
 
 /**
- * Save thread
+ * Save all changed items in one transaction
  */
-static void *params_save_thread(void *arg) {
-    cfg_item_t *cfg_arr;
-    cfg_arr           = (cfg_item_t *)&cfg;
-    uint32_t cfg_size = sizeof(cfg) / sizeof(cfg_item_t);
+static void save_changed(void) {
+    uint64_t start = get_time();
+    uint32_t writes = 0;
 
-    cfg_item_t *cfg_band_arr;
-    cfg_band_arr           = (cfg_item_t *)&cfg_band;
-    uint32_t cfg_band_size = sizeof(cfg_band) / sizeof(cfg_item_t);
+    if (!cfg_db_begin()) {
+        return;
+    }
+    writes += save_items_to_db((cfg_item_t *)&cfg, sizeof(cfg) / sizeof(cfg_item_t));
+    writes += save_items_to_db((cfg_item_t *)&cfg_band, sizeof(cfg_band) / sizeof(cfg_item_t));
+    writes += save_items_to_db((cfg_item_t *)&cfg_mode, sizeof(cfg_mode) / sizeof(cfg_item_t));
+    writes += save_items_to_db((cfg_item_t *)&cfg_transverters, sizeof(cfg_transverters) / sizeof(cfg_item_t));
+    cfg_db_commit();
+
+    if (writes) {
+        uint32_t ms = get_time() - start;
+
+        save_stat.flushes++;
+        save_stat.writes += writes;
+        save_stat.last_writes = writes;
+        save_stat.last_ms = ms;
+        LV_LOG_USER("Saved %u items in %u ms", writes, ms);
+    }
+}
 
-    cfg_item_t *cfg_mode_arr;
-    cfg_mode_arr           = (cfg_item_t *)&cfg_mode;
-    uint32_t cfg_mode_size = sizeof(cfg_mode) / sizeof(cfg_item_t);
+void cfg_flush() {
+    pthread_mutex_lock(&save_mutex);
+    save_changed();
+    pthread_mutex_unlock(&save_mutex);
+    database_sync();
+}
 
-    cfg_item_t *cfg_transverter_arr;
-    cfg_transverter_arr           = (cfg_item_t *)&cfg_transverters;
-    uint32_t cfg_transverter_size = sizeof(cfg_transverters) / sizeof(cfg_item_t);
+cfg_save_stat_t cfg_get_save_stat() {
+    pthread_mutex_lock(&save_mutex);
+    cfg_save_stat_t stat = save_stat;
+    pthread_mutex_unlock(&save_mutex);
+    return stat;
+}
 
+/**
+ * Save thread
+ */
+static void *params_save_thread(void *arg) {
     while (true) {
-        save_items_to_db(cfg_arr, cfg_size);
-        save_items_to_db(cfg_band_arr, cfg_band_size);
-        save_items_to_db(cfg_mode_arr, cfg_mode_size);
-        save_items_to_db(cfg_transverter_arr, cfg_transverter_size);
+        pthread_mutex_lock(&save_mutex);
+        save_changed();
+        pthread_mutex_unlock(&save_mutex);
         sleep_usec(10000000);
     }
 }
@@ -271,6 +319,8 @@ static void *params_save_thread(void *arg) {
  * Initialization functions
  */
 static int init_params_cfg(sqlite3 *db) {
+    int rc;
+
     /* Init db modules */
     cfg_params_init(db);
 
@@ -294,6 +344,8 @@ static int init_params_cfg(sqlite3 *db) {
     fill_cfg_item(&cfg.key_train, subject_create_int(false), "key_train");
     fill_cfg_item(&cfg.qsk_time, subject_create_int(100), "qsk_time");
     fill_cfg_item_float(&cfg.key_ratio, subject_create_float(3.0f), 0.1f, "key_ratio");
+    fill_cfg_item(&cfg.key_farnsworth, subject_create_int(0), "key_farnsworth");
+    fill_cfg_item(&cfg.key_weight, subject_create_int(50), "key_weight");
 
     /* CW decoder */
     fill_cfg_item(&cfg.cw_decoder, subject_create_int(true), "cw_decoder");
@@ -362,7 +414,10 @@ static int init_params_cfg(sqlite3 *db) {
     cfg_item_t *cfg_arr  = (cfg_item_t *)&cfg;
     uint32_t    cfg_size = sizeof(cfg) / sizeof(*cfg_arr);
     init_items(cfg_arr, cfg_size, cfg_params_load_item, cfg_params_save_item);
-    return load_items_from_db(cfg_arr, cfg_size);
+    cfg_params_preload();
+    rc = load_items_from_db(cfg_arr, cfg_size);
+    cfg_params_preload_free();
+    return rc;
 }
 
 static void bind_observers() {
@@ -40,6 +40,8 @@ typedef struct {
     cfg_item_t key_train;
     cfg_item_t qsk_time;
     cfg_item_t key_ratio;
+    cfg_item_t key_farnsworth;
+    cfg_item_t key_weight;
 
     /* CW decoder */
     cfg_item_t cw_decoder;
@@ -114,6 +116,20 @@ typedef struct {
 
 extern cfg_cur_t cfg_cur;
 
+typedef struct {
+    uint32_t flushes;
+    uint32_t writes;
+    uint32_t last_writes;
+    uint32_t last_ms;
+} cfg_save_stat_t;
+
 int cfg_init(sqlite3 *db);
 
+/**
+ * Save changed items and sync the database, before power off
+ */
+void cfg_flush();
+
+cfg_save_stat_t cfg_get_save_stat();
+
 const char * cfg_dnf_label_get();
@@ -19,8 +19,14 @@ struct dirty_t {
 void init_items(cfg_item_t *cfg_arr, uint32_t count, int (*load)(struct cfg_item_t *item),
                 int (*save)(struct cfg_item_t *item));
 int  load_items_from_db(cfg_item_t *cfg_arr, uint32_t count);
-void save_item_to_db(cfg_item_t *item, bool force);
-void save_items_to_db(cfg_item_t *cfg_arr, uint32_t cfg_size);
+/**
+ * Transaction on the params db, serialized with other threads
+ */
+bool cfg_db_begin();
+void cfg_db_commit();
+
+bool     save_item_to_db(cfg_item_t *item, bool force);
+uint32_t save_items_to_db(cfg_item_t *cfg_arr, uint32_t cfg_size);
 
 void fill_cfg_item_float(cfg_item_t *item, Subject * val, float db_scale, const char * db_name);
 void fill_cfg_item(cfg_item_t *item, Subject * val, const char * db_name);
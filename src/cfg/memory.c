@@ -91,19 +91,22 @@ bool cfg_memory_load(int32_t id) {
     if (!mem_data.freq.loaded) {
         return false;
     }
-    band_info_t *band_info = get_band_info_by_freq(mem_data.freq.val);
+    const band_info_t *band_info = get_band_info_by_freq(mem_data.freq.val);
     int32_t band_id;
     if (!band_info) {
         band_id = BAND_UNDEFINED;
     } else {
         band_id = band_info->id;
     }
+    /* Band params are saved and loaded first, then overridden by the memory values */
+    subject_transaction_begin();
     subject_set_int(cfg.band_id.val, band_id);
     subject_set_int(cfg_cur.fg_freq, mem_data.freq.val);
     if (mem_data.mode.loaded) subject_set_int(cfg_cur.mode, mem_data.mode.val);
     if (mem_data.agc.loaded) subject_set_int(cfg_cur.agc, mem_data.agc.val);
     if (mem_data.att.loaded) subject_set_int(cfg_cur.att, mem_data.att.val);
     if (mem_data.pre.loaded) subject_set_int(cfg_cur.pre, mem_data.pre.val);
+    subject_transaction_commit();
     return true;
 }
 
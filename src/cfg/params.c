@@ -3,6 +3,8 @@
  */
 #include "params.private.h"
 
+#include "values.private.h"
+
 #include "../lvgl/lvgl.h"
 
 #include <stdio.h>
@@ -15,6 +17,7 @@ static sqlite3_stmt *insert_stmt;
 static sqlite3_stmt *read_stmt;
 static pthread_mutex_t write_mutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t read_mutex = PTHREAD_MUTEX_INITIALIZER;
+static db_values_t    *preload;
 
 
 void cfg_params_init(sqlite3 *database) {
@@ -33,8 +36,67 @@ void cfg_params_init(sqlite3 *database) {
 }
 
 
+/**
+ * Bulk load of the whole table, items are bound from memory until freed
+ */
+void cfg_params_preload() {
+    sqlite3_stmt *stmt;
+    int          rc = sqlite3_prepare_v2(db, "SELECT name, val FROM params", -1, &stmt, 0);
+    if (rc != SQLITE_OK) {
+        LV_LOG_ERROR("Failed prepare preload statement: %s", sqlite3_errmsg(db));
+        return;
+    }
+    preload = db_values_load(stmt);
+    sqlite3_finalize(stmt);
+    if (preload) {
+        LV_LOG_USER("Preloaded %u params", db_values_count(preload));
+    }
+}
+
+void cfg_params_preload_free() {
+    if (preload) {
+        db_values_free(preload);
+        preload = NULL;
+    }
+}
+
+static int set_item(cfg_item_t *item, int64_t int_val, double real_val) {
+    float val;
+    switch (subject_get_dtype(item->val)) {
+        case DTYPE_INT:
+            LV_LOG_USER("Loaded %s=%i (pk=%i)", item->db_name, (int32_t)int_val, item->pk);
+            subject_set_int(item->val, int_val);
+            break;
+        case DTYPE_UINT64:
+            LV_LOG_USER("Loaded %s=%llu (pk=%i)", item->db_name, (uint64_t)int_val, item->pk);
+            subject_set_uint64(item->val, int_val);
+            break;
+        case DTYPE_FLOAT:
+            if (item->db_scale != 0) {
+                val = (int32_t)int_val * item->db_scale;
+            } else {
+                val = real_val;
+            }
+            LV_LOG_USER("Loaded %s=%f (pk=%i)", item->db_name, val, item->pk);
+            subject_set_float(item->val, val);
+            break;
+        default:
+            LV_LOG_WARN("Unknown item %s dtype: %u, can't load", item->db_name, subject_get_dtype(item->val));
+            return -1;
+    }
+    return 0;
+}
+
 int cfg_params_load_item(cfg_item_t *item) {
     int rc;
+    if (preload) {
+        const db_value_t *value = db_values_get(preload, item->db_name);
+        if (!value) {
+            LV_LOG_WARN("No results for load %s", item->db_name);
+            return -1;
+        }
+        return set_item(item, value->int_val, value->real_val);
+    }
     pthread_mutex_lock(&read_mutex);
     rc = sqlite3_bind_text(read_stmt, sqlite3_bind_parameter_index(read_stmt, ":name"), item->db_name, strlen(item->db_name), 0);
     if (rc != SQLITE_OK) {
@@ -42,37 +104,9 @@ int cfg_params_load_item(cfg_item_t *item) {
         pthread_mutex_unlock(&read_mutex);
         return rc;
     }
-    int32_t int_val;
-    uint64_t uint64_val;
     rc = sqlite3_step(read_stmt);
     if (rc == SQLITE_ROW) {
-        switch (subject_get_dtype(item->val)) {
-            case DTYPE_INT:
-                int_val = sqlite3_column_int(read_stmt, 0);
-                LV_LOG_USER("Loaded %s=%i (pk=%i)", item->db_name, int_val, item->pk);
-                subject_set_int(item->val, int_val);
-                break;
-            case DTYPE_UINT64:
-                uint64_val = sqlite3_column_int64(read_stmt, 0);
-                LV_LOG_USER("Loaded %s=%llu (pk=%i)", item->db_name, uint64_val, item->pk);
-                subject_set_uint64(item->val, uint64_val);
-                break;
-            case DTYPE_FLOAT: ;
-                float val;
-                if (item->db_scale != 0) {
-                    val = sqlite3_column_int(read_stmt, 0) * item->db_scale;
-                } else {
-                    val = sqlite3_column_double(read_stmt, 0);
-                }
-                LV_LOG_USER("Loaded %s=%f (pk=%i)", item->db_name, val, item->pk);
-                subject_set_float(item->val, val);
-                break;
-            default:
-                LV_LOG_WARN("Unknown item %s dtype: %u, can't load", item->db_name, subject_get_dtype(item->val));
-                pthread_mutex_unlock(&read_mutex);
-                return -1;
-        }
-        rc = 0;
+        rc = set_item(item, sqlite3_column_int64(read_stmt, 0), sqlite3_column_double(read_stmt, 0));
     } else {
         LV_LOG_WARN("No results for load %s", item->db_name);
         rc = -1;
@@ -6,6 +6,9 @@
 
 void cfg_params_init(sqlite3 *db);
 
+void cfg_params_preload();
+void cfg_params_preload_free();
+
 int cfg_params_load_item(cfg_item_t *item);
 
 int cfg_params_save_item(cfg_item_t *item);
@@ -0,0 +1,140 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "snapshot.private.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+/*
+ * Snapshot is kept as words with relaxed atomic access, seq is odd while
+ * the words are written
+ */
+
+#define WORDS   (sizeof(cfg_snapshot_t) / sizeof(uint32_t))
+
+_Static_assert(sizeof(cfg_snapshot_t) % sizeof(uint32_t) == 0, "Snapshot is not a whole number of words");
+
+static atomic_uint      seq;
+static atomic_uint      words[WORDS];
+static pthread_mutex_t  publish_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void fill_vfo(cfg_snapshot_vfo_t *vfo, struct vfo_params *params) {
+    vfo->freq = subject_get_int(params->freq.val);
+    vfo->mode = subject_get_int(params->mode.val);
+    vfo->agc = subject_get_int(params->agc.val);
+    vfo->att = subject_get_int(params->att.val);
+    vfo->pre = subject_get_int(params->pre.val);
+}
+
+static void store(const cfg_snapshot_t *snap) {
+    uint32_t    buf[WORDS];
+    uint32_t    n = atomic_load_explicit(&seq, memory_order_relaxed);
+
+    memcpy(buf, snap, sizeof(buf));
+
+    atomic_store_explicit(&seq, n + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    for (size_t i = 0; i < WORDS; i++) {
+        atomic_store_explicit(&words[i], buf[i], memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&seq, n + 2, memory_order_release);
+}
+
+/**
+ * Called when the change settles. Subjects are read under the mutex, so
+ * the last publication has the last values
+ */
+static void publish(void) {
+    cfg_snapshot_t snap;
+
+    memset(&snap, 0, sizeof(snap));
+    pthread_mutex_lock(&publish_mutex);
+
+    snap.version = atomic_load_explicit(&seq, memory_order_relaxed) / 2 + 1;
+
+    snap.fg_freq = subject_get_int(cfg_cur.fg_freq);
+    snap.bg_freq = subject_get_int(cfg_cur.bg_freq);
+    snap.freq_shift = subject_get_int(cfg_cur.freq_shift);
+    snap.mode = subject_get_int(cfg_cur.mode);
+    snap.agc = subject_get_int(cfg_cur.agc);
+    snap.att = subject_get_int(cfg_cur.att);
+    snap.pre = subject_get_int(cfg_cur.pre);
+    snap.filter_low = subject_get_int(cfg_cur.filter.low);
+    snap.filter_high = subject_get_int(cfg_cur.filter.high);
+    snap.fft_width = subject_get_int(cfg_cur.fft_width);
+
+    snap.vfo = subject_get_int(cfg_cur.band->vfo.val);
+    snap.split = subject_get_int(cfg_cur.band->split.val);
+    fill_vfo(&snap.vfo_a, &cfg_cur.band->vfo_a);
+    fill_vfo(&snap.vfo_b, &cfg_cur.band->vfo_b);
+
+    snap.key_train = subject_get_int(cfg.key_train.val);
+
+    store(&snap);
+    pthread_mutex_unlock(&publish_mutex);
+}
+
+static void on_change(Subject *subj, void *user_data) {
+    subject_after_commit(publish);
+}
+
+static void watch_vfo(struct vfo_params *params) {
+    subject_add_observer(params->freq.val, on_change, NULL);
+    subject_add_observer(params->mode.val, on_change, NULL);
+    subject_add_observer(params->agc.val, on_change, NULL);
+    subject_add_observer(params->att.val, on_change, NULL);
+    subject_add_observer(params->pre.val, on_change, NULL);
+}
+
+void cfg_snapshot_init(void) {
+    subject_add_observer(cfg_cur.fg_freq, on_change, NULL);
+    subject_add_observer(cfg_cur.bg_freq, on_change, NULL);
+    subject_add_observer(cfg_cur.freq_shift, on_change, NULL);
+    subject_add_observer(cfg_cur.mode, on_change, NULL);
+    subject_add_observer(cfg_cur.agc, on_change, NULL);
+    subject_add_observer(cfg_cur.att, on_change, NULL);
+    subject_add_observer(cfg_cur.pre, on_change, NULL);
+    subject_add_observer(cfg_cur.filter.low, on_change, NULL);
+    subject_add_observer(cfg_cur.filter.high, on_change, NULL);
+    subject_add_observer(cfg_cur.fft_width, on_change, NULL);
+
+    subject_add_observer(cfg_cur.band->vfo.val, on_change, NULL);
+    subject_add_observer(cfg_cur.band->split.val, on_change, NULL);
+    watch_vfo(&cfg_cur.band->vfo_a);
+    watch_vfo(&cfg_cur.band->vfo_b);
+
+    subject_add_observer(cfg.key_train.val, on_change, NULL);
+
+    publish();
+}
+
+void cfg_snapshot_get(cfg_snapshot_t *snap) {
+    uint32_t    buf[WORDS];
+    uint32_t    begin, end;
+
+    do {
+        begin = atomic_load_explicit(&seq, memory_order_acquire);
+
+        for (size_t i = 0; i < WORDS; i++) {
+            buf[i] = atomic_load_explicit(&words[i], memory_order_relaxed);
+        }
+
+        atomic_thread_fence(memory_order_acquire);
+        end = atomic_load_explicit(&seq, memory_order_relaxed);
+    } while ((begin & 1) || begin != end);
+
+    memcpy(snap, buf, sizeof(buf));
+}
+
+uint32_t cfg_snapshot_version(void) {
+    return atomic_load_explicit(&seq, memory_order_acquire) / 2;
+}
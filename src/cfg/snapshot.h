@@ -0,0 +1,55 @@
+#pragma once
+
+#include "cfg.h"
+
+#include <aether_radio/x6200_control/control.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Copy of the values read on hot paths (radio, DSP and CAT threads). It
+ * is published when a change settles: at once for a single change, at the
+ * end of the outer transaction otherwise. Publication is a seqlock, a reader
+ * copies the snapshot and retries if a publication was in progress, so it
+ * sees a consistent state without locks and never blocks the writer
+ */
+
+typedef struct {
+    int32_t         freq;
+    x6200_mode_t    mode;
+    x6200_agc_t     agc;
+    x6200_att_t     att;
+    x6200_pre_t     pre;
+} cfg_snapshot_vfo_t;
+
+typedef struct {
+    uint32_t            version;
+
+    int32_t             fg_freq;
+    int32_t             bg_freq;
+    int32_t             freq_shift;
+    x6200_mode_t        mode;
+    x6200_agc_t         agc;
+    x6200_att_t         att;
+    x6200_pre_t         pre;
+    int32_t             filter_low;
+    int32_t             filter_high;
+    uint32_t            fft_width;
+
+    x6200_vfo_t         vfo;
+    bool                split;
+    cfg_snapshot_vfo_t  vfo_a;
+    cfg_snapshot_vfo_t  vfo_b;
+
+    bool                key_train;
+} cfg_snapshot_t;
+
+/**
+ * Copy of the last published snapshot
+ */
+void cfg_snapshot_get(cfg_snapshot_t *snap);
+
+/**
+ * Number of publications
+ */
+uint32_t cfg_snapshot_version(void);
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "snapshot.h"
+
+void cfg_snapshot_init(void);
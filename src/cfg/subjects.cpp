@@ -2,11 +2,14 @@
 
 extern "C" {
     #include "../lvgl/lvgl.h"
+    #include "../wakeup.h"
     #include <stdint.h>
     #include <stdio.h>
     #include <stdlib.h>
 }
 
+#define TX_MAX_ROUNDS   16                      /* Observers changing each other in a loop */
+
 Observer::~Observer() {
     subj->unsubscribe(this);
 }
@@ -15,29 +18,99 @@ void Observer::notify() {
     this->fn(subj, user_data);
 };
 
-std::list<ObserverDelayed*> ObserverDelayed::instances;
+/**
+ * Under mutex_subscribe of the subject. True if the call is left for later
+ */
+bool Observer::defer() {
+    return false;
+}
+
+std::atomic<ObserverDelayed*> ObserverDelayed::dirty = nullptr;
+ObserverDelayed *ObserverDelayed::taken = nullptr;
+std::thread::id ObserverDelayed::pinned;
 
 ObserverDelayed::~ObserverDelayed() {
-    auto item = std::find(instances.begin(), instances.end(), this);
-    instances.erase(item);
+    /* No other thread can push it after this */
+
+    subj->unsubscribe(this);
+
+    if (!queued) {
+        return;
+    }
+
+    /* Still pending, unlink from the taken list of the owner thread */
+
+    take_dirty();
+
+    for (ObserverDelayed **p = &taken; *p; p = &(*p)->next) {
+        if (*p == this) {
+            *p = next;
+            break;
+        }
+    }
 }
 
 void ObserverDelayed::notify() {
-    auto call_tid = std::this_thread::get_id();
-    if (call_tid != tid) {
-        changed = true;
-    } else {
+    if (!defer()) {
         this->Observer::notify();
-        changed = false;
     }
 }
 
-void ObserverDelayed::notify_delayed() {
-    for (auto item: ObserverDelayed::instances) {
-        if (item->changed) {
-            item->Observer::notify();
+bool ObserverDelayed::defer() {
+    if (std::this_thread::get_id() == tid) {
+        return false;
+    }
+
+    if (!queued.exchange(true)) {
+        next = dirty.load(std::memory_order_relaxed);
+
+        while (!dirty.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {
         }
+        wakeup_signal();
     }
+
+    return true;
+}
+
+/**
+ * Move pushed observers to the end of the taken list, oldest first
+ */
+void ObserverDelayed::take_dirty() {
+    ObserverDelayed *list = dirty.exchange(nullptr, std::memory_order_acquire);
+    ObserverDelayed *reversed = nullptr;
+
+    while (list) {
+        ObserverDelayed *item = list;
+
+        list = item->next;
+        item->next = reversed;
+        reversed = item;
+    }
+
+    ObserverDelayed **tail = &taken;
+
+    while (*tail) {
+        tail = &(*tail)->next;
+    }
+    *tail = reversed;
+}
+
+void ObserverDelayed::notify_delayed() {
+    take_dirty();
+
+    while (taken) {
+        ObserverDelayed *item = taken;
+
+        /* Change during the call queues it again */
+
+        taken = item->next;
+        item->queued = false;
+        item->Observer::notify();
+    }
+}
+
+void ObserverDelayed::pin_thread() {
+    pinned = std::this_thread::get_id();
 }
 
 Observer* Subject::subscribe(void (*fn)(Subject *, void *), void *user_data) {
@@ -57,7 +130,109 @@ ObserverDelayed *Subject::subscribe_delayed(void (*fn)(Subject *, void *), void
 }
 
 void Subject::unsubscribe(Observer *observer) {
-    observers.erase(std::find(observers.begin(), observers.end(), observer));
+    const std::lock_guard<std::mutex> lock(mutex_subscribe);
+
+    auto it = std::find(observers.begin(), observers.end(), observer);
+
+    if (it != observers.end()) {
+        observers.erase(it);
+    }
+}
+
+thread_local int Subject::tx_depth = 0;
+thread_local std::vector<Subject*> Subject::tx_changed;
+thread_local std::vector<void (*)(void)> Subject::tx_after;
+
+void Subject::notify_observers() {
+    if (tx_depth) {
+        if (std::find(tx_changed.begin(), tx_changed.end(), this) == tx_changed.end()) {
+            tx_changed.push_back(this);
+        }
+        return;
+    }
+
+    /* Mutex is released for the calls, they may subscribe or change this subject */
+
+    std::unique_lock<std::mutex> lock(mutex_subscribe);
+
+    for (auto it = observers.begin(); it != observers.end(); ++it) {
+        Observer *observer = *it;
+
+        if (!observer->defer()) {
+            lock.unlock();
+            observer->notify();
+            lock.lock();
+        }
+    }
+}
+
+void Subject::collect_observers(std::vector<Observer*> &out) {
+    const std::lock_guard<std::mutex> lock(mutex_subscribe);
+
+    for (auto observer : observers) {
+        if (!observer->defer() && std::find(out.begin(), out.end(), observer) == out.end()) {
+            out.push_back(observer);
+        }
+    }
+}
+
+void Subject::transaction_begin() {
+    tx_depth++;
+}
+
+void Subject::transaction_commit() {
+    if (tx_depth == 0) {
+        LV_LOG_ERROR("Subject transaction commit without begin");
+        return;
+    }
+
+    if (tx_depth > 1) {
+        tx_depth--;
+        return;
+    }
+
+    /* Depth is kept while dispatching, so cascaded changes go to the next round */
+
+    std::vector<Subject*>   changed;
+    std::vector<Observer*>  targets;
+
+    for (int round = 0; !tx_changed.empty(); round++) {
+        if (round == TX_MAX_ROUNDS) {
+            LV_LOG_ERROR("Subject transaction doesn't settle, %zu changes dropped", tx_changed.size());
+            tx_changed.clear();
+            break;
+        }
+
+        changed.swap(tx_changed);
+        tx_changed.clear();
+        targets.clear();
+
+        for (auto subj : changed) {
+            subj->collect_observers(targets);
+        }
+
+        for (auto observer : targets) {
+            observer->notify();
+        }
+    }
+
+    tx_depth = 0;
+
+    std::vector<void (*)(void)> after;
+
+    after.swap(tx_after);
+
+    for (auto fn : after) {
+        fn();
+    }
+}
+
+void Subject::after_commit(void (*fn)(void)) {
+    if (tx_depth == 0) {
+        fn();
+    } else if (std::find(tx_after.begin(), tx_after.end(), fn) == tx_after.end()) {
+        tx_after.push_back(fn);
+    }
 }
 
 data_type Subject::dtype() {
@@ -148,6 +323,22 @@ void observer_delayed_notify_all(void) {
     ObserverDelayed::notify_delayed();
 };
 
+void observer_delayed_pin_thread(void) {
+    ObserverDelayed::pin_thread();
+}
+
+void subject_transaction_begin(void) {
+    Subject::transaction_begin();
+}
+
+void subject_transaction_commit(void) {
+    Subject::transaction_commit();
+}
+
+void subject_after_commit(void (*fn)(void)) {
+    Subject::after_commit(fn);
+}
+
 // subject_t subject_init_int(int32_t val) {
 //     subject_t subj = (subject_t)malloc(sizeof(__subject));
 //     pthread_mutex_init(&subj->mutex_set, NULL);
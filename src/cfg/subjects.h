@@ -16,6 +16,7 @@ enum data_type {
 #include <type_traits>
 #include <thread>
 #include <atomic>
+#include <vector>
 
 class Subject;
 
@@ -30,33 +31,62 @@ class Observer {
     };
     virtual ~Observer();
     virtual void notify();
+    virtual bool defer();
 };
 
+/*
+ * Change from other thread pushes the observer onto a lock-free dirty
+ * stack, once until it is called. Main loop takes only the changed ones.
+ * The push is done under the subject's mutex_subscribe, so the observer
+ * can't be pushed after it is unsubscribed. The owner is the thread that
+ * made the observer, or the pinned one
+ */
 class ObserverDelayed: public Observer {
-    static std::list<ObserverDelayed*> instances;
+    static std::atomic<ObserverDelayed*> dirty;     /* Pushed by any thread */
+    static ObserverDelayed *taken;                  /* Taken by the owner thread, in order */
+    static std::thread::id pinned;
     std::thread::id tid;
-    std::atomic<bool> changed = false;
+    std::atomic<bool> queued = false;
+    ObserverDelayed *next = nullptr;
+
+    static void take_dirty();
     public:
     ObserverDelayed(Subject *subj, void (*fn)(Subject *, void *), void *user_data): Observer(subj, fn, user_data) {
-        tid = std::this_thread::get_id();
-        instances.push_back(this);
+        tid = pinned != std::thread::id() ? pinned : std::this_thread::get_id();
     };
     ~ObserverDelayed();
     void notify();
+    bool defer();
     static void notify_delayed();
+    static void pin_thread();
 
 };
 
+/*
+ * Changes inside a transaction only record the subject. Commit calls each
+ * observer of the changed subjects once, in order of the first change, with
+ * the final values. Changes made by these observers are delivered in the
+ * next round of the same commit
+ */
 class Subject {
     std::mutex mutex_subscribe;
+    static thread_local int tx_depth;
+    static thread_local std::vector<Subject*> tx_changed;
+    static thread_local std::vector<void (*)(void)> tx_after;
+
+    void collect_observers(std::vector<Observer*> &out);
     protected:
     std::list<Observer*> observers;
     data_type type;
+    void notify_observers();
     public:
     virtual data_type dtype();
     Observer* subscribe(void (*fn)(Subject *, void *), void *user_data=nullptr);
     ObserverDelayed* subscribe_delayed(void (*fn)(Subject *, void *), void *user_data=nullptr);
     void unsubscribe(Observer *o);
+    static void transaction_begin();
+    static void transaction_commit();
+    static void after_commit(void (*fn)(void));
 };
 
 template <typename T> class SubjectT : public Subject {
@@ -74,9 +104,7 @@ template <typename T> class SubjectT : public Subject {
     void set(T val) {
         if (this->val != val) {
             this->val = val;
-            for (auto observer : observers) {
-                observer->notify();
-            }
+            notify_observers();
         }
     };
     data_type dtype() {
@@ -138,6 +166,23 @@ void observer_delayed_del(ObserverDelayed *observer);
 
 void observer_delayed_notify_all(void);
 
+/**
+ * Delayed observers made from now on belong to the calling thread, whichever
+ * thread makes them. Before other threads are started
+ */
+void observer_delayed_pin_thread(void);
+
+/**
+ * Group changes of several subjects, nestable. Only the outer commit notifies
+ */
+void subject_transaction_begin(void);
+void subject_transaction_commit(void);
+
+/**
+ * Call fn once after the outer commit settles, or at once outside of a transaction
+ */
+void subject_after_commit(void (*fn)(void));
+
 #ifdef __cplusplus
 }
 #endif
@@ -55,7 +55,7 @@ static void test_load_band_by_freq() {
 }
 
 static void test_load_band_by_pk() {
-    band_info_t *info = get_band_info_by_pk(7);
+    const band_info_t *info = get_band_info_by_pk(7);
     assert(info->start_freq == 14070 * kHz && "Wrong start freq");
     assert(info->stop_freq == 14350 * kHz && "Wrong stop freq");
     assert(strcmp("20m SSB", info->name) == 0 && "Wrong name");
@@ -106,7 +106,7 @@ static void test_switch_band_up() {
         {600 * MHz,       -1,             -1},
     };
     for (size_t i = 0; i < ARRAY_SIZE(data); i++) {
-        band_info_t *band = get_band_info_next(data[i].freq, true, data[i].cur_id);
+        const band_info_t *band = get_band_info_next(data[i].freq, true, data[i].cur_id);
         if (data[i].expected_id < 0) {
             assert(band == NULL);
         } else {
@@ -133,7 +133,7 @@ static void test_switch_band_down() {
         {1000 * kHz,      -1,             -1},
     };
     for (size_t i = 0; i < ARRAY_SIZE(data); i++) {
-        band_info_t *band = get_band_info_next(data[i].freq, false, data[i].cur_id);
+        const band_info_t *band = get_band_info_next(data[i].freq, false, data[i].cur_id);
         if (data[i].expected_id < 0) {
             assert(band == NULL);
         } else {
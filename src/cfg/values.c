@@ -0,0 +1,109 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "values.private.h"
+
+#include "../lvgl/lvgl.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+struct db_values_t {
+    db_value_t  *items;
+    uint32_t    count;
+    int32_t     *index;                         /* Open addressing, -1 is empty */
+    uint32_t    mask;
+};
+
+static uint32_t hash(const char *str) {
+    uint32_t h = 2166136261u;
+
+    while (*str) {
+        h = (h ^ (uint8_t) *str++) * 16777619u;
+    }
+    return h;
+}
+
+db_values_t *db_values_load(sqlite3_stmt *stmt) {
+    db_values_t *values = calloc(1, sizeof(db_values_t));
+    uint32_t    cap = 64;
+    int         rc;
+
+    values->items = malloc(sizeof(db_value_t) * cap);
+
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        const char *name = (const char *) sqlite3_column_text(stmt, 0);
+
+        if (!name) {
+            continue;
+        }
+        if (values->count == cap) {
+            cap *= 2;
+            values->items = realloc(values->items, sizeof(db_value_t) * cap);
+        }
+
+        db_value_t *item = &values->items[values->count++];
+
+        item->name = strdup(name);
+        item->int_val = sqlite3_column_int64(stmt, 1);
+        item->real_val = sqlite3_column_double(stmt, 1);
+    }
+    sqlite3_reset(stmt);
+
+    if (rc != SQLITE_DONE) {
+        LV_LOG_ERROR("Error while reading rows: %s", sqlite3_errmsg(sqlite3_db_handle(stmt)));
+        db_values_free(values);
+        return NULL;
+    }
+
+    uint32_t size = 16;
+
+    while (size < values->count * 2) {
+        size *= 2;
+    }
+    values->mask = size - 1;
+    values->index = malloc(sizeof(int32_t) * size);
+    memset(values->index, 0xFF, sizeof(int32_t) * size);
+
+    for (uint32_t i = 0; i < values->count; i++) {
+        uint32_t pos = hash(values->items[i].name) & values->mask;
+
+        while (values->index[pos] >= 0) {
+            pos = (pos + 1) & values->mask;
+        }
+        values->index[pos] = i;
+    }
+    return values;
+}
+
+const db_value_t *db_values_get(db_values_t *values, const char *name) {
+    uint32_t pos = hash(name) & values->mask;
+
+    while (values->index[pos] >= 0) {
+        db_value_t *item = &values->items[values->index[pos]];
+
+        if (strcmp(item->name, name) == 0) {
+            return item;
+        }
+        pos = (pos + 1) & values->mask;
+    }
+    return NULL;
+}
+
+uint32_t db_values_count(db_values_t *values) {
+    return values->count;
+}
+
+void db_values_free(db_values_t *values) {
+    for (uint32_t i = 0; i < values->count; i++) {
+        free(values->items[i].name);
+    }
+    free(values->items);
+    free(values->index);
+    free(values);
+}
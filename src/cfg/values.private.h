@@ -0,0 +1,28 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <stdint.h>
+
+/*
+ * Rows (name, val) of one query, kept in memory and found by name. Items
+ * are bound from it instead of a SELECT per item
+ */
+
+typedef struct {
+    char    *name;
+    int64_t int_val;
+    double  real_val;
+} db_value_t;
+
+typedef struct db_values_t db_values_t;
+
+/**
+ * Step the bound statement to the end and reset it. NULL on error
+ */
+db_values_t *db_values_load(sqlite3_stmt *stmt);
+
+const db_value_t *db_values_get(db_values_t *values, const char *name);
+
+uint32_t db_values_count(db_values_t *values);
+
+void db_values_free(db_values_t *values);
@@ -20,6 +20,7 @@ extern "C" {
     #include "audio.h"
     #include "params/params.h"
     #include "cw_decoder.h"
+    #include "cw_frontend.h"
     #include "pannel.h"
     #include "meter.h"
     #include "cw_tune_ui.h"
@@ -31,27 +32,16 @@ typedef struct {
     float       val;
 } fft_item_t;
 
-#define NUM_STAGES 6
-#define DECIM_FACTOR (1LL << NUM_STAGES)
-#define FFT 128
+#define DECIM_FACTOR CW_FRONTEND_DECIM
+#define FFT CW_FRONTEND_FFT
 #define MAX_CW_BW 500
 
 static bool ready = false;
 
 static fft_item_t fft_items[FFT];
 
-static dds_cccf  ds_dec;
-static wrms_t    wrms;
-static cbuffercf input_cbuf;
-static cbuffercf rms_cbuf;
-static wdelayf   rms_delay;
-
-static cbuffercf fft_cbuf;
-static fftplan   fft_plan;
-static float     window[FFT];
-static cfloat    fft_time[FFT];
-static cfloat    fft_freq[FFT];
-static float     audio_psd_squared[FFT];
+static cw_frontend_t    frontend;
+static const float      *audio_psd_squared;
 
 static float peak_filtered;
 static float noise_filtered;
@@ -72,12 +62,17 @@ static bool    cw_tune;
 static pthread_mutex_t  cw_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 static void dds_dec_init();
+static void on_fft(const float *psd, void *user);
+static void on_rms(float rms_db, float delayed_db, void *user);
 
 static void on_key_tone_change(Subject *subj, void *user_data);
 static void on_val_float_change(Subject *subj, void *user_data);
 static void on_val_bool_change(Subject *subj, void *user_data);
 
 void cw_init() {
+    cw_decoder_init();
+    frontend = cw_frontend_create(on_fft, on_rms, NULL);
+
     cfg.key_tone.val->subscribe(on_key_tone_change)->notify();
     cfg.cw_decoder_peak_beta.val->subscribe(on_val_float_change, (void*)&cw_decoder_peak_beta)->notify();
     cfg.cw_decoder_noise_beta.val->subscribe(on_val_float_change, (void*)&cw_decoder_noise_beta)->notify();
@@ -86,26 +81,6 @@ void cw_init() {
     cfg.cw_decoder.val->subscribe(on_val_bool_change, (void*)&cw_decoder)->notify();
     cfg.cw_tune.val->subscribe(on_val_bool_change, (void*)&cw_tune)->notify();
 
-    input_cbuf = cbuffercf_create(10000);
-    wrms = wrms_create(16, 4);
-    rms_cbuf = cbuffercf_create(4000 / 8 * 2);
-    fft_cbuf = cbuffercf_create(4000 / 8 * 2);
-
-    // Window for FFT
-    float scale = 0.0f;
-    for (size_t i = 0; i < FFT; i++) {
-        window[i] = liquid_hann(i, FFT);
-        scale += window[i] * window[i];
-    }
-    scale = 1.0f / sqrtf(scale);
-    // scale window and copy
-    for (size_t i=0; i<FFT; i++)
-        window[i] *= scale;
-
-    fft_plan = fft_create_plan(FFT, fft_time, fft_freq, LIQUID_FFT_FORWARD, 0);
-
-    rms_delay = wdelayf_create(FFT / wrms_delay(wrms));
-
     peak_filtered = -10.0f;
     noise_filtered = -20.0f;
 
@@ -114,12 +89,9 @@ void cw_init() {
 
 static void dds_dec_init() {
     pthread_mutex_lock(&cw_mutex);
-    if (ds_dec != NULL) {
-        dds_cccf_destroy(ds_dec);
-    }
     float rel_freq = (float) key_tone / AUDIO_CAPTURE_RATE;
     float bw = (float) MAX_CW_BW / AUDIO_CAPTURE_RATE;
-    ds_dec = dds_cccf_create(NUM_STAGES, rel_freq, bw, 60.0f);
+    cw_frontend_set_tone(frontend, rel_freq, bw);
     pthread_mutex_unlock(&cw_mutex);
 }
 
@@ -204,6 +176,22 @@ static bool decode(float rms_db) {
 }
 
 
+static void on_fft(const float *psd, void *user) {
+    audio_psd_squared = psd;
+    update_thresholds();
+
+    size_t max_pos = argmax((float *) psd, FFT);
+    // Fix fft order
+    float peak_freq = (((float) (FFT - (max_pos + FFT / 2) % FFT) / FFT) - 0.5f) * ((float) AUDIO_CAPTURE_RATE / DECIM_FACTOR);
+    update_peak_freq(peak_freq);
+}
+
+static void on_rms(float rms_db, float delayed_db, void *user) {
+    rms_db_min = LV_MIN(rms_db_min, rms_db);
+    rms_db_max = LV_MAX(rms_db_max, rms_db);
+    cw_decoder_signal(decode(delayed_db), 1000.0f / AUDIO_CAPTURE_RATE * cw_frontend_rms_period());
+}
+
 void cw_put_audio_samples(unsigned int n, cfloat *samples) {
     if (!ready) {
         return;
@@ -211,59 +199,10 @@ void cw_put_audio_samples(unsigned int n, cfloat *samples) {
     if ((!cw_decoder) && (!cw_tune)) {
         return;
     }
-    cfloat sample;
-    float rms_db, peak_freq;
-    size_t max_pos;
-
-    // fill input buffer
-    cbuffercf_write(input_cbuf, samples, n);
-
-    // Downsample and freq shift
-    const size_t desired_num = (1<<NUM_STAGES);
-    while (cbuffercf_size(input_cbuf) >= desired_num) {
-        unsigned int n;
-        cfloat *buf;
-        cbuffercf_read(input_cbuf, desired_num, &buf, &n);
-        pthread_mutex_lock(&cw_mutex);
-        dds_cccf_decim_execute(ds_dec, buf, &sample);
-        pthread_mutex_unlock(&cw_mutex);
-        cbuffercf_release(input_cbuf, desired_num);
-        cbuffercf_push(rms_cbuf, sample);
-        cbuffercf_push(fft_cbuf, sample);
-
-        // Process FFT
-        while (cbuffercf_size(fft_cbuf) >= FFT) {
-            for (size_t i = 0; i < FFT; i++) {
-                cbuffercf_pop(fft_cbuf, &fft_time[i]);
-                fft_time[i] *= window[i];
-            }
-            fft_execute(fft_plan);
-
-            for (size_t i = 0; i < FFT; i++) {
-                audio_psd_squared[i] = std::real(fft_freq[i] * std::conj(fft_freq[i]));
-            }
-            update_thresholds();
-
-            max_pos = argmax(audio_psd_squared, FFT);
-            // Fix fft order
-            peak_freq = (((float) (FFT - (max_pos + FFT / 2) % FFT) / FFT) - 0.5f) * ((float) AUDIO_CAPTURE_RATE / DECIM_FACTOR);
-            update_peak_freq(peak_freq);
-        }
 
-        // Process RMS
-        while (cbuffercf_size(rms_cbuf)) {
-            cbuffercf_pop(rms_cbuf, &sample);
-            wrms_pushcf(wrms, sample);
-            if (wrms_ready(wrms)) {
-                rms_db = wrms_get_val(wrms);
-                rms_db_min = LV_MIN(rms_db_min, rms_db);
-                rms_db_max = LV_MAX(rms_db_max, rms_db);
-                wdelayf_push(rms_delay, rms_db);
-                wdelayf_read(rms_delay, &rms_db);
-                cw_decoder_signal(decode(rms_db), 1000.0f / AUDIO_CAPTURE_RATE * DECIM_FACTOR * wrms_delay(wrms));
-            }
-        }
-    }
+    pthread_mutex_lock(&cw_mutex);
+    cw_frontend_process(frontend, n, samples);
+    pthread_mutex_unlock(&cw_mutex);
 }
 
 // bool cw_change_decoder(int16_t df) {
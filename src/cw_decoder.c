@@ -9,296 +9,281 @@
 /* Based on idea Michael A. Maynard, a.k.a. "K4ICY" */
 
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include "lvgl/lvgl.h"
 #include "cw_decoder.h"
 #include "pannel.h"
 
 #define HIST_SIZE       10
 
-static uint32_t debounce_factor = 15;
-static uint32_t thr_mean = 139;
-
-static uint32_t time_track = 0;
-
-static int32_t  key_line_event_prev = 0;
-static int32_t  key_line_event_new = 0;
-static uint32_t key_line_ref = 0;
-
-static uint32_t event_hist_index = 0;
-static uint32_t short_event_hist[HIST_SIZE];
-static uint32_t long_event_hist[HIST_SIZE];
-static uint32_t space_event_hist[HIST_SIZE];
-
-static uint64_t long_event_avr = 0;
-static uint64_t short_event_avr = 0;
-static uint64_t space_event_avr = 0;
-
-static uint16_t wpm_old;
-static uint32_t wpm;
-
-static uint32_t space_duration = 0;
-static uint32_t space_duration_prev = 0;
-static uint32_t space_duration_ref;
-
-static uint32_t word_space_duration = 0;
-static uint32_t word_space_duration_ref = 0;
-static float    word_space_timing = 3.0f;
-
-static bool     key_line = false;
-
-static float    compare_factor = 2.0;
-
-static bool     character_step = false;
-static bool     word_step = false;
-static char     elements[128];
-
-cw_characters_t cw_characters[] = {
-    { .morse = ".-",        .character = "A" },
-    { .morse = "-...",      .character = "B" },
-    { .morse = "-.-.",      .character = "C" },
-    { .morse = "-..",       .character = "D" },
-    { .morse = ".",         .character = "E" },
-    { .morse = "..-.",      .character = "F" },
-    { .morse = "--.",       .character = "G" },
-    { .morse = "....",      .character = "H" },
-    { .morse = "..",        .character = "I" },
-    { .morse = ".---",      .character = "J" },
-    { .morse = "-.-",       .character = "K" },
-    { .morse = ".-..",      .character = "L" },
-    { .morse = "--",        .character = "M" },
-    { .morse = "-.",        .character = "N" },
-    { .morse = "---",       .character = "O" },
-    { .morse = ".--.",      .character = "P" },
-    { .morse = "--.-",      .character = "Q" },
-    { .morse = ".-.",       .character = "R" },
-    { .morse = "...",       .character = "S" },
-    { .morse = "-",         .character = "T" },
-    { .morse = "..-",       .character = "U" },
-    { .morse = "...-",      .character = "V" },
-    { .morse = ".--",       .character = "W" },
-    { .morse = "-..-",      .character = "X" },
-    { .morse = "-.--",      .character = "Y" },
-    { .morse = "--..",      .character = "Z" },
-
-    { .morse = ".----",     .character = "1" },
-    { .morse = "..---",     .character = "2" },
-    { .morse = "...--",     .character = "3" },
-    { .morse = "....-",     .character = "4" },
-    { .morse = ".....",     .character = "5" },
-    { .morse = "-....",     .character = "6" },
-    { .morse = "--...",     .character = "7" },
-    { .morse = "---..",     .character = "8" },
-    { .morse = "----.",     .character = "9" },
-    { .morse = "-----",     .character = "0" },
-
-    { .morse = "-.-.--",    .character = "!" },
-    { .morse = "..--.",     .character = "!" },
-    { .morse = ".-..-.",    .character = "\"" },
-    { .morse = "...-..-",   .character = "$" },
-    { .morse = ".----.",    .character = "'" },
-    { .morse = "--..--",    .character = "," },
-    { .morse = "-....-",    .character = "-" },
-    { .morse = ".-.-.-",    .character = "." },
-    { .morse = "-..-.",     .character = "/" },
-    { .morse = "---...",    .character = ":" },
-    { .morse = "-.-.-.",    .character = ";" },
-    { .morse = "-...-",     .character = "=" },
-    { .morse = "..--..",    .character = "?" },
-    { .morse = ".--.-.",    .character = "@" },
-    { .morse = "..--.-",    .character = "_" },
-
-    { .morse = ".-.-.",     .character = "<AR>" },
-    { .morse = ".-...",     .character = "<AS>" },
-    { .morse = "-...-.-",   .character = "<BK>" },
-    { .morse = "-.-..-..",  .character = "<CL>" },
-    { .morse = "-.-.-",     .character = "<CT>" },
-    { .morse = "-.--.",     .character = "<KN>" },
-    { .morse = "...-.-",    .character = "<SK>" },
-    { .morse = "...-.",     .character = "<SN>" },
-    { .morse = "...---...", .character = "<SOS>" },
-    { .morse = "-.-.--.-",  .character = "<CQ>" },
-
-    { .morse = "......",    .character = "<ERR>" },
-    { .morse = ".......",   .character = "<ERR>" },
-    { .morse = "........",  .character = "<ERR>" },
-    { .morse = NULL }
+struct cw_decoder_s {
+    cw_decoder_text_cb_t    text_cb;
+    void                    *user;
+
+    uint32_t    debounce_factor;
+    uint32_t    thr_mean;
+
+    uint32_t    time_track;
+
+    int32_t     key_line_event_prev;
+    int32_t     key_line_event_new;
+    uint32_t    key_line_ref;
+
+    uint32_t    event_hist_index;
+    uint32_t    short_event_hist[HIST_SIZE];
+    uint32_t    long_event_hist[HIST_SIZE];
+    uint32_t    space_event_hist[HIST_SIZE];
+
+    uint64_t    long_event_avr;
+    uint64_t    short_event_avr;
+    uint64_t    space_event_avr;
+
+    uint16_t    wpm_old;
+    uint32_t    wpm;
+
+    uint32_t    space_duration;
+    uint32_t    space_duration_prev;
+    uint32_t    space_duration_ref;
+
+    uint32_t    word_space_duration;
+    uint32_t    word_space_duration_ref;
+    float       word_space_timing;
+
+    bool        key_line;
+
+    float       compare_factor;
+
+    bool        character_step;
+    bool        word_step;
+    cw_morse_t  elements;
+
+    cw_morse_alphabet_t alphabet;
 };
 
+/* Decoder of the main receiver, output to the pannel */
+
+static struct cw_decoder_s  *main_decoder = NULL;
+
+
+static void pannel_text_cb(const char *text, void *user) {
+    pannel_add_text(text);
+}
+
 void cw_decoder_init() {
+    main_decoder = cw_decoder_create(pannel_text_cb, NULL);
+}
+
+cw_decoder_t cw_decoder_create(cw_decoder_text_cb_t text_cb, void *user) {
+    cw_decoder_t dec = malloc(sizeof(struct cw_decoder_s));
+
+    dec->text_cb = text_cb;
+    dec->user = user;
+    dec->alphabet = CW_MORSE_LATIN;
+    cw_decoder_reset(dec);
+
+    return dec;
 }
 
-static void cw_decoder_ans(const char *ans) {
-    pannel_add_text(ans);
+void cw_decoder_destroy(cw_decoder_t dec) {
+    free(dec);
 }
 
-static void cw_decoder_wpm(uint16_t wpm) {
+void cw_decoder_reset(cw_decoder_t dec) {
+    cw_decoder_text_cb_t    text_cb = dec->text_cb;
+    void                    *user = dec->user;
+    cw_morse_alphabet_t     alphabet = dec->alphabet;
+
+    memset(dec, 0, sizeof(*dec));
+
+    dec->text_cb = text_cb;
+    dec->user = user;
+    dec->alphabet = alphabet;
+    dec->debounce_factor = 15;
+    dec->thr_mean = 139;
+    dec->word_space_timing = 3.0f;
+    dec->compare_factor = 2.0f;
 }
 
-static void cw_decoder_dict() {
-    cw_characters_t *character = &cw_characters[0];
+void cw_decoder_set_alphabet(cw_decoder_t dec, cw_morse_alphabet_t alphabet) {
+    dec->alphabet = alphabet;
+}
 
-    while (character->morse) {
-        if (strcmp(elements, character->morse) == 0) {
-            cw_decoder_ans(character->character);
-            return;
-        }
+uint32_t cw_decoder_get_wpm(cw_decoder_t dec) {
+    return dec->wpm;
+}
 
-        character++;
+static void cw_decoder_ans(cw_decoder_t dec, const char *ans) {
+    if (dec->text_cb) {
+        dec->text_cb(ans, dec->user);
     }
+}
 
-    cw_decoder_ans("<?>");
+static void cw_decoder_wpm(cw_decoder_t dec, uint16_t wpm) {
 }
 
-static void cw_decoder_calc_wpm() {
-    wpm_old = wpm;
-    wpm = (6000 * 1.06) / (long_event_avr + short_event_avr + space_event_avr);
+static void cw_decoder_dict(cw_decoder_t dec) {
+    const char *character = cw_morse_decode(dec->elements, dec->alphabet);
 
-    if (wpm != wpm_old) {
-        cw_decoder_wpm(wpm);
+    cw_decoder_ans(dec, character ? character : "<?>");
+}
+
+static void cw_decoder_calc_wpm(cw_decoder_t dec) {
+    dec->wpm_old = dec->wpm;
+    dec->wpm = (6000 * 1.06) / (dec->long_event_avr + dec->short_event_avr + dec->space_event_avr);
+
+    if (dec->wpm != dec->wpm_old) {
+        cw_decoder_wpm(dec, dec->wpm);
     }
 }
 
-static void cw_decoder_dot_dash(uint16_t short_event, uint16_t long_event) {
+static void cw_decoder_dot_dash(cw_decoder_t dec, uint16_t short_event, uint16_t long_event) {
+    uint32_t index = dec->event_hist_index;
+
     /* Find out which one is the Dot and which is the Dash and roll them into a moving average of each */
 
-    long_event_hist[event_hist_index] = long_event;
-    short_event_hist[event_hist_index] = short_event;
+    dec->long_event_hist[index] = long_event;
+    dec->short_event_hist[index] = short_event;
 
     /* Keep a moving average of the intra-element space duration */
 
-    space_event_hist[event_hist_index] = space_duration_prev;
+    dec->space_event_hist[index] = dec->space_duration_prev;
 
     /* Keep a moving averages */
 
-    long_event_avr = 0;
-    short_event_avr = 0;
-    space_event_avr = 0;
+    dec->long_event_avr = 0;
+    dec->short_event_avr = 0;
+    dec->space_event_avr = 0;
 
     for (uint8_t i = 0; i < HIST_SIZE; i++) {
-        long_event_avr += long_event_hist[i];
-        short_event_avr += short_event_hist[i];
-        space_event_avr += space_event_hist[i];
+        dec->long_event_avr += dec->long_event_hist[i];
+        dec->short_event_avr += dec->short_event_hist[i];
+        dec->space_event_avr += dec->space_event_hist[i];
     }
 
-    long_event_avr /= HIST_SIZE;
-    short_event_avr /= HIST_SIZE;
-    space_event_avr /= HIST_SIZE;
+    dec->long_event_avr /= HIST_SIZE;
+    dec->short_event_avr /= HIST_SIZE;
+    dec->space_event_avr /= HIST_SIZE;
 
     /* Find threshold mean */
 
-    thr_mean = sqrt(short_event_avr * long_event_avr);
+    dec->thr_mean = sqrt(dec->short_event_avr * dec->long_event_avr);
 
     /* Bootstrap threshold values - - - If any are below or above known Dot/Dash pair ranges then move them instantly */
 
-    if (thr_mean < short_event_hist[event_hist_index] || thr_mean > long_event_hist[event_hist_index]) {
-        thr_mean = sqrt(short_event_hist[event_hist_index] * long_event_hist[event_hist_index]);
+    if (dec->thr_mean < dec->short_event_hist[index] || dec->thr_mean > dec->long_event_hist[index]) {
+        dec->thr_mean = sqrt(dec->short_event_hist[index] * dec->long_event_hist[index]);
 
-        long_event_avr = long_event_hist[event_hist_index];
-        short_event_avr = short_event_hist[event_hist_index];
+        dec->long_event_avr = dec->long_event_hist[index];
+        dec->short_event_avr = dec->short_event_hist[index];
 
         for (uint8_t i = 0; i < HIST_SIZE; i++) {
-            long_event_hist[i] = long_event_avr;
-            short_event_hist[i] = short_event_avr;
+            dec->long_event_hist[i] = dec->long_event_avr;
+            dec->short_event_hist[i] = dec->short_event_avr;
         }
     }
 
-    event_hist_index++;
+    dec->event_hist_index++;
 
-    if (event_hist_index > HIST_SIZE - 1)
-        event_hist_index = 0;
+    if (dec->event_hist_index > HIST_SIZE - 1)
+        dec->event_hist_index = 0;
 
-    cw_decoder_calc_wpm();
+    cw_decoder_calc_wpm(dec);
 }
 
 
-static void cw_decoder_inner_space() {
-    space_duration_prev = space_duration;
-    space_duration = time_track - space_duration_ref;
+static void cw_decoder_inner_space(cw_decoder_t dec) {
+    dec->space_duration_prev = dec->space_duration;
+    dec->space_duration = dec->time_track - dec->space_duration_ref;
 
     /* DECODE collected string of elements */
 
     /* check to see if inter-element space duration threshold has been exceeded - then decode   */
     /* it is assumed that the intra-space is longer than a Dot but shorter than a Dash          */
 
-    if (space_duration >= thr_mean) {
-        space_duration_ref = time_track;
+    if (dec->space_duration >= dec->thr_mean) {
+        dec->space_duration_ref = dec->time_track;
 
-        if (character_step) {
-            cw_decoder_dict();
-            strcpy(elements, "");
+        if (dec->character_step) {
+            cw_decoder_dict(dec);
+            cw_morse_clear(&dec->elements);
 
-            character_step = false;
+            dec->character_step = false;
         }
     }
 }
 
-static void cw_decoder_word_space() {
-    word_space_duration = time_track - word_space_duration_ref;
+static void cw_decoder_word_space(cw_decoder_t dec) {
+    dec->word_space_duration = dec->time_track - dec->word_space_duration_ref;
 
-    if (word_space_duration >= thr_mean * word_space_timing) {
-        word_space_duration_ref = time_track;
+    if (dec->word_space_duration >= dec->thr_mean * dec->word_space_timing) {
+        dec->word_space_duration_ref = dec->time_track;
 
-        if (word_step) {
-            cw_decoder_ans(" ");
-            word_step = false;
+        if (dec->word_step) {
+            cw_decoder_ans(dec, " ");
+            dec->word_step = false;
         }
     }
 }
 
-void cw_decoder_signal(bool on, float ms) {
-    time_track += (ms + 0.5f);
+void cw_decoder_put(cw_decoder_t dec, bool on, float ms) {
+    dec->time_track += (ms + 0.5f);
 
     /* Key down */
 
     if (on) {
-        if (!key_line) {
-            key_line_ref = time_track;
-            word_space_duration_ref = time_track;
+        if (!dec->key_line) {
+            dec->key_line_ref = dec->time_track;
+            dec->word_space_duration_ref = dec->time_track;
 
-            key_line = true;
+            dec->key_line = true;
         }
     }
 
     /* Key up */
 
     if (!on) {
-        if (time_track - key_line_ref < debounce_factor) {
-            key_line = false;
+        if (dec->time_track - dec->key_line_ref < dec->debounce_factor) {
+            dec->key_line = false;
             return;
         }
 
-        if (key_line) {
-            key_line = false;
-            key_line_event_prev = key_line_event_new;
-            key_line_event_new = time_track - key_line_ref;
+        if (dec->key_line) {
+            dec->key_line = false;
+            dec->key_line_event_prev = dec->key_line_event_new;
+            dec->key_line_event_new = dec->time_track - dec->key_line_ref;
+
+            int32_t event_new = dec->key_line_event_new;
+            int32_t event_prev = dec->key_line_event_prev;
 
             /* If the Current Duration Event Compared to the Previous Event appears to be a Dot / Dash pair [ roughly (>2):1 ] */
 
-            if (key_line_event_new >= key_line_event_prev * compare_factor && space_duration_prev <= key_line_event_prev * compare_factor) {
-                cw_decoder_dot_dash(key_line_event_new, key_line_event_prev);
-            } else if (key_line_event_prev >= key_line_event_new * compare_factor && space_duration_prev <= key_line_event_new * compare_factor) {
-                cw_decoder_dot_dash(key_line_event_prev, key_line_event_new);
+            if (event_new >= event_prev * dec->compare_factor && dec->space_duration_prev <= event_prev * dec->compare_factor) {
+                cw_decoder_dot_dash(dec, event_new, event_prev);
+            } else if (event_prev >= event_new * dec->compare_factor && dec->space_duration_prev <= event_new * dec->compare_factor) {
+                cw_decoder_dot_dash(dec, event_prev, event_new);
             }
 
             /* Reset space durations */
 
-            space_duration_ref = time_track;
-            word_space_duration_ref = time_track;
+            dec->space_duration_ref = dec->time_track;
+            dec->word_space_duration_ref = dec->time_track;
 
             /* Classify and add most likely Dots or Dashes to a string for eventual character decoding */
 
-            if (key_line_event_new <= thr_mean) {
-                strcat(elements, ".");
-            } else {
-                strcat(elements, "-");
-            }
+            cw_morse_push(&dec->elements, event_new > dec->thr_mean);
 
-            character_step = true;
-            word_step = true;
+            dec->character_step = true;
+            dec->word_step = true;
         }
 
-        cw_decoder_inner_space();
-        cw_decoder_word_space();
+        cw_decoder_inner_space(dec);
+        cw_decoder_word_space(dec);
     }
 }
 
+void cw_decoder_signal(bool on, float ms) {
+    if (main_decoder) {
+        cw_decoder_put(main_decoder, on, ms);
+    }
+}
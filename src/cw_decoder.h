@@ -8,14 +8,31 @@
 
 #pragma once
 
+#include "cw_morse.h"
+
 #include <stdbool.h>
+#include <stdint.h>
+
+typedef struct cw_decoder_s * cw_decoder_t;
+
+typedef void (*cw_decoder_text_cb_t)(const char *text, void *user);
 
-typedef struct {
-    char    *morse;
-    char    *character;
-} cw_characters_t;
+/**
+ * Independent decoder with own timing state
+ */
+cw_decoder_t cw_decoder_create(cw_decoder_text_cb_t text_cb, void *user);
+void cw_decoder_destroy(cw_decoder_t dec);
+void cw_decoder_reset(cw_decoder_t dec);
+void cw_decoder_set_alphabet(cw_decoder_t dec, cw_morse_alphabet_t alphabet);
 
-extern cw_characters_t cw_characters[];
+/**
+ * Key state for the last ms milliseconds
+ */
+void cw_decoder_put(cw_decoder_t dec, bool on, float ms);
+uint32_t cw_decoder_get_wpm(cw_decoder_t dec);
 
+/**
+ * Decoder of the main receiver, text goes to the pannel
+ */
 void cw_decoder_init();
 void cw_decoder_signal(bool on, float ms);
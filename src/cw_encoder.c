@@ -7,7 +7,7 @@
  */
 #include "cw_encoder.h"
 
-#include "cw_decoder.h"
+#include "cw_keyer.h"
 #include "params/params.h"
 #include "cfg/cfg.h"
 #include "radio.h"
@@ -22,93 +22,72 @@
 #include <sched.h>
 
 
+#define KEYER_PRIORITY  20
+
 static cw_encoder_state_t   state = CW_ENCODER_IDLE;
 static pthread_t            thread;
+static cw_keyer_t           keyer;
 
 static char                 *current_msg = NULL;
 static char                 *current_char = NULL;
 
-static uint8_t get_morse(char *str, char **morse) {
-    cw_characters_t *character = &cw_characters[0];
-
-    while (character->morse) {
-        uint8_t char_len = strlen(character->character);
+static void key_cb(bool on, void *user) {
+    radio_set_morse_key(on);
+}
 
-        if (strncasecmp(character->character, str, char_len) == 0) {
-            *morse = character->morse;
+static void error_cb(bool on, int64_t error, void *user) {
+    LV_LOG_TRACE("Key %s error %lld us", on ? "down" : "up", (long long) error / 1000);
+}
 
-            return char_len;
-        }
+static void keyer_init() {
+    cw_keyer_params_t params = {
+        .wpm = subject_get_int(cfg.key_speed.val),
+        .farnsworth_wpm = subject_get_int(cfg.key_farnsworth.val),
+        .ratio = subject_get_float(cfg.key_ratio.val),
+        .weight = subject_get_int(cfg.key_weight.val)
+    };
 
-        character++;
-    }
-
-    return 0;
+    cw_keyer_init(&keyer, &params, key_cb, NULL);
+    keyer.error_cb = error_cb;
 }
 
-static void send_morse(char *str, time_t dit_nsec, time_t dah_nsec) {
-    struct timespec t;
-    t.tv_sec = 0;
-    while (*str) {
-        switch (*str) {
-            case '.':
-                t.tv_nsec = dit_nsec;
-                radio_set_morse_key(true);
-                nanosleep(&t, NULL);
-                radio_set_morse_key(false);
-                break;
+static void keyer_stat() {
+    cw_keyer_stat_t *stat = &keyer.stat;
 
-            case '-':
-                t.tv_nsec = dah_nsec;
-                radio_set_morse_key(true);
-                nanosleep(&t, NULL);
-                radio_set_morse_key(false);
-                break;
-
-            default:
-                break;
-        }
-        str++;
-        t.tv_nsec = dit_nsec;
-        nanosleep(&t, NULL);
+    if (stat->edges) {
+        LV_LOG_USER("CW keyer: %u edges, error avg %.2f ms, max %.2f ms",
+            stat->edges, stat->error_sum / 1000000.0 / stat->edges, stat->error_max / 1000000.0);
     }
-    t.tv_nsec = dah_nsec - dit_nsec;
-    nanosleep(&t, NULL);
 }
 
 static void * endecode_thread(void *arg) {
     pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
     pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL);
 
-
-    time_t dit_nsec = 20000000L / (subject_get_int(cfg.key_speed.val)) * 60;
-    time_t dah_nsec = dit_nsec * subject_get_float(cfg.key_ratio.val);
-    time_t world_space_nsec = dit_nsec * 7;
-
-    struct timespec t;
-
-    t.tv_sec = 0;
+    keyer_init();
+    cw_keyer_start(&keyer);
 
     while (true) {
-        char    *morse;
-        uint8_t len;
+        cw_morse_t  morse;
+        size_t      len;
 
         if (*current_char == ' ') {
             current_char++;
-            t.tv_nsec = world_space_nsec - dah_nsec;
-            nanosleep(&t, NULL);
+            cw_keyer_word_space(&keyer);
         } else {
-            len = get_morse(current_char, &morse);
+            len = cw_morse_encode(current_char, &morse);
             if (len) {
-                send_morse(morse, dit_nsec, dah_nsec);
+                cw_keyer_send(&keyer, morse);
                 current_char += len;
             } else {
                 current_char++;
-                t.tv_nsec = world_space_nsec - dah_nsec;
-                nanosleep(&t, NULL);
+                cw_keyer_word_space(&keyer);
             }
         }
         if (*current_char == 0) {
+            cw_keyer_wait(&keyer);
+            keyer_stat();
+
             if (state == CW_ENCODER_SEND) {
                 state = CW_ENCODER_IDLE;
 
@@ -122,9 +101,12 @@ static void * endecode_thread(void *arg) {
 
                 state = CW_ENCODER_BEACON;
                 current_char = current_msg;
+                cw_keyer_start(&keyer);
             }
         }
     }
+
+    return NULL;
 }
 
 void cw_encoder_stop() {
@@ -148,15 +130,22 @@ void cw_encoder_send(const char *text, bool beacon) {
     current_char = current_msg;
     state = beacon ? CW_ENCODER_BEACON : CW_ENCODER_SEND;
 
-    int rc;
-    pthread_attr_t attr;
-    struct sched_param param;
-    rc = pthread_attr_init (&attr);
-    rc = pthread_attr_getschedparam (&attr, &param);
-    param.sched_priority += 5;
-    rc = pthread_attr_setschedparam (&attr, &param);
+    /* Real-time thread for the key timing, falls back to a normal one without privileges */
+
+    pthread_attr_t      attr;
+    struct sched_param  param = { .sched_priority = KEYER_PRIORITY };
+
+    pthread_attr_init(&attr);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+    pthread_attr_setschedparam(&attr, &param);
+
+    if (pthread_create(&thread, &attr, endecode_thread, NULL) != 0) {
+        LV_LOG_WARN("Can't start real-time keyer thread");
+        pthread_create(&thread, NULL, endecode_thread, NULL);
+    }
 
-    pthread_create(&thread, &attr, endecode_thread, NULL);
+    pthread_attr_destroy(&attr);
 }
 
 cw_encoder_state_t cw_encoder_state() {
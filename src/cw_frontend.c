@@ -0,0 +1,166 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "cw_frontend.h"
+#include "fft_registry.h"
+
+#include <liquid/liquid.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Same math as the former per-sample chain (cbuffercf -> dds_cccf ->
+ * cbuffercf -> wrms -> wdelayf), so the envelope values are bit-identical:
+ * the window sum is done in the same order, the delay line has the same length.
+ */
+
+struct cw_frontend_s {
+    dds_cccf                dds;
+
+    cfloat                  pending[CW_FRONTEND_DECIM];
+    size_t                  pending_n;
+
+    fft_registry_plan_t     *plan;
+    const float             *window;
+    float                   psd[CW_FRONTEND_FFT];
+    size_t                  fft_pos;
+
+    float                   rms[CW_FRONTEND_RMS_SIZE];    /* dB, ring */
+    size_t                  rms_pos;
+    size_t                  rms_step;
+
+    float                   delay[CW_FRONTEND_RMS_DELAY + 1];
+    size_t                  delay_pos;
+
+    cw_frontend_fft_cb_t    fft_cb;
+    cw_frontend_rms_cb_t    rms_cb;
+    void                    *user;
+};
+
+cw_frontend_t cw_frontend_create(cw_frontend_fft_cb_t fft_cb, cw_frontend_rms_cb_t rms_cb, void *user) {
+    cw_frontend_t fe = calloc(1, sizeof(struct cw_frontend_s));
+
+    fe->fft_cb = fft_cb;
+    fe->rms_cb = rms_cb;
+    fe->user = user;
+
+    fe->window = fft_registry_window_get(CW_FRONTEND_FFT, FFT_WINDOW_HANN_POWER);
+    fe->plan = fft_registry_plan_get(CW_FRONTEND_FFT, LIQUID_FFT_FORWARD);
+
+    return fe;
+}
+
+void cw_frontend_destroy(cw_frontend_t fe) {
+    if (fe->dds) {
+        dds_cccf_destroy(fe->dds);
+    }
+    fft_registry_window_put(fe->window);
+    fft_registry_plan_put(fe->plan);
+    free(fe);
+}
+
+void cw_frontend_set_tone(cw_frontend_t fe, float rel_freq, float rel_bw) {
+    if (fe->dds) {
+        dds_cccf_destroy(fe->dds);
+    }
+    fe->dds = dds_cccf_create(CW_FRONTEND_STAGES, rel_freq, rel_bw, 60.0f);
+}
+
+static void process_fft(cw_frontend_t fe) {
+    cfloat *freq = fe->plan->freq;
+
+    fft_execute(fe->plan->plan);
+
+    for (size_t i = 0; i < CW_FRONTEND_FFT; i++) {
+        fe->psd[i] = crealf(freq[i] * conjf(freq[i]));
+    }
+
+    fe->fft_cb(fe->psd, fe->user);
+}
+
+static void process_rms(cw_frontend_t fe, cfloat x) {
+    float x_db = 10.0f * log10f(cabsf(x));
+
+    if (x_db < -121.0f) {
+        x_db = -121.0f;
+    }
+
+    fe->rms[fe->rms_pos] = x_db;
+    fe->rms_pos = (fe->rms_pos + 1) % CW_FRONTEND_RMS_SIZE;
+
+    if (++fe->rms_step < CW_FRONTEND_RMS_STEP) {
+        return;
+    }
+    fe->rms_step = 0;
+
+    /* Oldest first, as windowf_read */
+    float rms = 0.0f;
+
+    for (size_t i = 0; i < CW_FRONTEND_RMS_SIZE; i++) {
+        rms += fe->rms[(fe->rms_pos + i) % CW_FRONTEND_RMS_SIZE];
+    }
+    rms = rms / CW_FRONTEND_RMS_SIZE;
+
+    /* Delay line, as wdelayf */
+    fe->delay[fe->delay_pos] = rms;
+    fe->delay_pos = (fe->delay_pos + 1) % (CW_FRONTEND_RMS_DELAY + 1);
+
+    fe->rms_cb(rms, fe->delay[fe->delay_pos], fe->user);
+}
+
+static void process_decimated(cw_frontend_t fe, cfloat *in) {
+    cfloat sample;
+
+    dds_cccf_decim_execute(fe->dds, in, &sample);
+
+    fe->plan->time[fe->fft_pos] = sample * fe->window[fe->fft_pos];
+
+    if (++fe->fft_pos == CW_FRONTEND_FFT) {
+        fe->fft_pos = 0;
+        process_fft(fe);
+    }
+
+    process_rms(fe, sample);
+}
+
+void cw_frontend_process(cw_frontend_t fe, size_t n, cfloat *samples) {
+    if (!fe->dds) {
+        return;
+    }
+
+    /* Tail of the previous buffer */
+    if (fe->pending_n) {
+        size_t part = CW_FRONTEND_DECIM - fe->pending_n;
+
+        if (part > n) {
+            part = n;
+        }
+
+        memcpy(&fe->pending[fe->pending_n], samples, part * sizeof(cfloat));
+        fe->pending_n += part;
+        samples += part;
+        n -= part;
+
+        if (fe->pending_n < CW_FRONTEND_DECIM) {
+            return;
+        }
+
+        process_decimated(fe, fe->pending);
+        fe->pending_n = 0;
+    }
+
+    while (n >= CW_FRONTEND_DECIM) {
+        process_decimated(fe, samples);
+        samples += CW_FRONTEND_DECIM;
+        n -= CW_FRONTEND_DECIM;
+    }
+
+    memcpy(fe->pending, samples, n * sizeof(cfloat));
+    fe->pending_n = n;
+}
@@ -0,0 +1,60 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include "helpers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * CW decoder front end: shift the tone to 0 Hz and decimate, FFT of the
+ * decimated signal and smoothed envelope in dB. Works on whole buffers,
+ * results are passed to callbacks in the order of samples.
+ */
+
+#define CW_FRONTEND_STAGES      6
+#define CW_FRONTEND_DECIM       (1 << CW_FRONTEND_STAGES)
+#define CW_FRONTEND_FFT         128
+#define CW_FRONTEND_RMS_SIZE    16
+#define CW_FRONTEND_RMS_STEP    4
+#define CW_FRONTEND_RMS_DELAY   (CW_FRONTEND_FFT / CW_FRONTEND_RMS_STEP)
+
+typedef struct cw_frontend_s * cw_frontend_t;
+
+typedef void (*cw_frontend_fft_cb_t)(const float *psd, void *user);
+/**
+ * Envelope, dB, and the same delayed by one FFT frame
+ */
+typedef void (*cw_frontend_rms_cb_t)(float rms_db, float delayed_db, void *user);
+
+cw_frontend_t cw_frontend_create(cw_frontend_fft_cb_t fft_cb, cw_frontend_rms_cb_t rms_cb, void *user);
+void cw_frontend_destroy(cw_frontend_t fe);
+
+/**
+ * Tone and bandwidth, relative to the sample rate
+ */
+void cw_frontend_set_tone(cw_frontend_t fe, float rel_freq, float rel_bw);
+
+void cw_frontend_process(cw_frontend_t fe, size_t n, cfloat *samples);
+
+/**
+ * Time between envelope values, in input samples
+ */
+static inline size_t cw_frontend_rms_period() {
+    return CW_FRONTEND_DECIM * CW_FRONTEND_RMS_STEP;
+}
+
+#ifdef __cplusplus
+}
+#endif
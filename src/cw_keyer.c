@@ -0,0 +1,109 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "cw_keyer.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define NSEC    1000000000LL
+
+static uint64_t now_ns() {
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t) t.tv_sec * NSEC + t.tv_nsec;
+}
+
+static void sleep_until(uint64_t deadline) {
+    struct timespec t = {
+        .tv_sec = deadline / NSEC,
+        .tv_nsec = deadline % NSEC
+    };
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL) == EINTR) {
+    }
+}
+
+void cw_keyer_durations(const cw_keyer_params_t *params, cw_keyer_durations_t *d) {
+    uint64_t    dit = 1200 * 1000000ULL / params->wpm;
+    uint64_t    char_gap = dit * 3;
+    uint64_t    word_gap = dit * 7;
+    uint32_t    fw = params->farnsworth_wpm;
+
+    /* ARRL Farnsworth: characters at wpm, extra time goes to the spaces */
+
+    if (fw && fw < params->wpm) {
+        double ta = (60.0 * params->wpm - 37.2 * fw) / (fw * params->wpm) * NSEC;
+
+        char_gap = ta * 3.0 / 19.0;
+        word_gap = ta * 7.0 / 19.0;
+    }
+
+    /* Weighting moves time from the following space to the key down */
+
+    int64_t weight = (int64_t) dit * ((int32_t) params->weight - 50) / 50;
+
+    d->dit = dit + weight;
+    d->dah = dit * params->ratio + weight;
+    d->element_space = dit - weight;
+    d->char_space = char_gap - weight;
+    d->word_space = word_gap - weight;
+}
+
+void cw_keyer_init(cw_keyer_t *keyer, const cw_keyer_params_t *params, cw_keyer_key_cb_t key_cb, void *user) {
+    memset(keyer, 0, sizeof(*keyer));
+
+    cw_keyer_durations(params, &keyer->d);
+    keyer->key_cb = key_cb;
+    keyer->user = user;
+}
+
+void cw_keyer_start(cw_keyer_t *keyer) {
+    memset(&keyer->stat, 0, sizeof(keyer->stat));
+    keyer->next = now_ns();
+}
+
+static void edge(cw_keyer_t *keyer, bool on) {
+    sleep_until(keyer->next);
+
+    int64_t error = (int64_t) (now_ns() - keyer->next);
+
+    keyer->key_cb(on, keyer->user);
+
+    keyer->stat.edges++;
+    keyer->stat.error_sum += llabs(error);
+
+    if (llabs(error) > llabs(keyer->stat.error_max)) {
+        keyer->stat.error_max = error;
+    }
+
+    if (keyer->error_cb) {
+        keyer->error_cb(on, error, keyer->user);
+    }
+}
+
+void cw_keyer_send(cw_keyer_t *keyer, cw_morse_t morse) {
+    for (uint8_t i = 0; i < morse.len; i++) {
+        edge(keyer, true);
+        keyer->next += cw_morse_dah(morse, i) ? keyer->d.dah : keyer->d.dit;
+
+        edge(keyer, false);
+        keyer->next += (i == morse.len - 1) ? keyer->d.char_space : keyer->d.element_space;
+    }
+}
+
+void cw_keyer_word_space(cw_keyer_t *keyer) {
+    keyer->next += keyer->d.word_space - keyer->d.char_space;
+}
+
+void cw_keyer_wait(cw_keyer_t *keyer) {
+    sleep_until(keyer->next);
+}
@@ -0,0 +1,88 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include "cw_morse.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Keyer with absolute deadlines. Every key edge time is counted from the
+ * start of the message, so wake up latency does not accumulate.
+ */
+
+typedef struct {
+    uint32_t    wpm;                /* Character speed */
+    uint32_t    farnsworth_wpm;     /* Effective speed of spacing, 0 - off */
+    float       ratio;              /* Dah to dit */
+    uint32_t    weight;             /* Key down part, %. 50 - standard */
+} cw_keyer_params_t;
+
+/* ns */
+typedef struct {
+    uint64_t    dit;
+    uint64_t    dah;
+    uint64_t    element_space;
+    uint64_t    char_space;         /* After the last element, instead of element_space */
+    uint64_t    word_space;         /* Same, at the end of a word */
+} cw_keyer_durations_t;
+
+typedef void (*cw_keyer_key_cb_t)(bool on, void *user);
+/**
+ * Wake up error of the key edge, ns. Positive if late
+ */
+typedef void (*cw_keyer_error_cb_t)(bool on, int64_t error, void *user);
+
+typedef struct {
+    uint32_t    edges;
+    int64_t     error_max;          /* By absolute value */
+    int64_t     error_sum;          /* Of absolute values */
+} cw_keyer_stat_t;
+
+typedef struct {
+    cw_keyer_durations_t    d;
+    cw_keyer_key_cb_t       key_cb;
+    cw_keyer_error_cb_t     error_cb;
+    void                    *user;
+    uint64_t                next;   /* CLOCK_MONOTONIC deadline of the next edge */
+    cw_keyer_stat_t         stat;
+} cw_keyer_t;
+
+void cw_keyer_durations(const cw_keyer_params_t *params, cw_keyer_durations_t *d);
+
+void cw_keyer_init(cw_keyer_t *keyer, const cw_keyer_params_t *params, cw_keyer_key_cb_t key_cb, void *user);
+
+/**
+ * Count deadlines from now and reset statistics
+ */
+void cw_keyer_start(cw_keyer_t *keyer);
+
+/**
+ * Character with the following character space
+ */
+void cw_keyer_send(cw_keyer_t *keyer, cw_morse_t morse);
+
+/**
+ * Extend the last character space to the word space
+ */
+void cw_keyer_word_space(cw_keyer_t *keyer);
+
+/**
+ * Wait for the end of the last space
+ */
+void cw_keyer_wait(cw_keyer_t *keyer);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,275 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "cw_morse.h"
+
+#include <ctype.h>
+#include <pthread.h>
+#include <string.h>
+#include <strings.h>
+
+#define INDEX_SIZE  (1 << (CW_MORSE_MAX_LEN + 1))
+
+cw_characters_t cw_characters[] = {
+    { .morse = ".-",        .character = "A" },
+    { .morse = "-...",      .character = "B" },
+    { .morse = "-.-.",      .character = "C" },
+    { .morse = "-..",       .character = "D" },
+    { .morse = ".",         .character = "E" },
+    { .morse = "..-.",      .character = "F" },
+    { .morse = "--.",       .character = "G" },
+    { .morse = "....",      .character = "H" },
+    { .morse = "..",        .character = "I" },
+    { .morse = ".---",      .character = "J" },
+    { .morse = "-.-",       .character = "K" },
+    { .morse = ".-..",      .character = "L" },
+    { .morse = "--",        .character = "M" },
+    { .morse = "-.",        .character = "N" },
+    { .morse = "---",       .character = "O" },
+    { .morse = ".--.",      .character = "P" },
+    { .morse = "--.-",      .character = "Q" },
+    { .morse = ".-.",       .character = "R" },
+    { .morse = "...",       .character = "S" },
+    { .morse = "-",         .character = "T" },
+    { .morse = "..-",       .character = "U" },
+    { .morse = "...-",      .character = "V" },
+    { .morse = ".--",       .character = "W" },
+    { .morse = "-..-",      .character = "X" },
+    { .morse = "-.--",      .character = "Y" },
+    { .morse = "--..",      .character = "Z" },
+
+    { .morse = ".----",     .character = "1" },
+    { .morse = "..---",     .character = "2" },
+    { .morse = "...--",     .character = "3" },
+    { .morse = "....-",     .character = "4" },
+    { .morse = ".....",     .character = "5" },
+    { .morse = "-....",     .character = "6" },
+    { .morse = "--...",     .character = "7" },
+    { .morse = "---..",     .character = "8" },
+    { .morse = "----.",     .character = "9" },
+    { .morse = "-----",     .character = "0" },
+
+    { .morse = "-.-.--",    .character = "!" },
+    { .morse = "..--.",     .character = "!" },
+    { .morse = ".-..-.",    .character = "\"" },
+    { .morse = "...-..-",   .character = "$" },
+    { .morse = ".----.",    .character = "'" },
+    { .morse = "--..--",    .character = "," },
+    { .morse = "-....-",    .character = "-" },
+    { .morse = ".-.-.-",    .character = "." },
+    { .morse = "-..-.",     .character = "/" },
+    { .morse = "---...",    .character = ":" },
+    { .morse = "-.-.-.",    .character = ";" },
+    { .morse = "-...-",     .character = "=" },
+    { .morse = "..--..",    .character = "?" },
+    { .morse = ".--.-.",    .character = "@" },
+    { .morse = "..--.-",    .character = "_" },
+    { .morse = NULL }
+};
+
+cw_characters_t cw_prosigns[] = {
+    { .morse = ".-.-.",     .character = "<AR>" },
+    { .morse = ".-...",     .character = "<AS>" },
+    { .morse = "-...-.-",   .character = "<BK>" },
+    { .morse = "-.-..-..",  .character = "<CL>" },
+    { .morse = "-.-.-",     .character = "<CT>" },
+    { .morse = "-.--.",     .character = "<KN>" },
+    { .morse = "...-.-",    .character = "<SK>" },
+    { .morse = "...-.",     .character = "<SN>" },
+    { .morse = "...---...", .character = "<SOS>" },
+    { .morse = "-.-.--.-",  .character = "<CQ>" },
+
+    { .morse = "......",    .character = "<ERR>" },
+    { .morse = ".......",   .character = "<ERR>" },
+    { .morse = "........",  .character = "<ERR>" },
+    { .morse = NULL }
+};
+
+cw_characters_t cw_characters_cyrillic[] = {
+    { .morse = ".-",       .character = "А" },
+    { .morse = "-...",     .character = "Б" },
+    { .morse = ".--",      .character = "В" },
+    { .morse = "--.",      .character = "Г" },
+    { .morse = "-..",      .character = "Д" },
+    { .morse = ".",        .character = "Е" },
+    { .morse = "...-",     .character = "Ж" },
+    { .morse = "--..",     .character = "З" },
+    { .morse = "..",       .character = "И" },
+    { .morse = ".---",     .character = "Й" },
+    { .morse = "-.-",      .character = "К" },
+    { .morse = ".-..",     .character = "Л" },
+    { .morse = "--",       .character = "М" },
+    { .morse = "-.",       .character = "Н" },
+    { .morse = "---",      .character = "О" },
+    { .morse = ".--.",     .character = "П" },
+    { .morse = ".-.",      .character = "Р" },
+    { .morse = "...",      .character = "С" },
+    { .morse = "-",        .character = "Т" },
+    { .morse = "..-",      .character = "У" },
+    { .morse = "..-.",     .character = "Ф" },
+    { .morse = "....",     .character = "Х" },
+    { .morse = "-.-.",     .character = "Ц" },
+    { .morse = "---.",     .character = "Ч" },
+    { .morse = "----",     .character = "Ш" },
+    { .morse = "--.-",     .character = "Щ" },
+    { .morse = "--.--",    .character = "Ъ" },
+    { .morse = "-.--",     .character = "Ы" },
+    { .morse = "-..-",     .character = "Ь" },
+    { .morse = "..-..",    .character = "Э" },
+    { .morse = "..--",     .character = "Ю" },
+    { .morse = ".-.-",     .character = "Я" },
+    { .morse = NULL }
+};
+
+/* Code with the length marker bit: unique for all lengths */
+
+#define CYR_FIRST   0x0410      /* А */
+#define CYR_LAST    0x044F      /* я */
+#define CYR_YO      0x0401      /* Ё, sent as Е */
+#define CYR_YO_LOW  0x0451
+
+static const char       *latin_index[INDEX_SIZE];
+static const char       *cyrillic_index[INDEX_SIZE];
+static cw_morse_t       ascii_index[128];
+static cw_morse_t       cyr_index[CYR_LAST - CYR_FIRST + 1];    /* Both cases by code point */
+
+static pthread_once_t   index_once = PTHREAD_ONCE_INIT;
+
+static inline uint16_t code_index(cw_morse_t m) {
+    return (1 << m.len) | m.bits;
+}
+
+/**
+ * First entry wins, so alphabet letters are added before the common part
+ */
+static void add_table(const char **index, const cw_characters_t *table, bool skip_letters) {
+    for (const cw_characters_t *c = table; c->morse; c++) {
+        if (skip_letters && isalpha((unsigned char) c->character[0])) {
+            continue;
+        }
+
+        uint16_t i = code_index(cw_morse_from_string(c->morse));
+
+        if (!index[i]) {
+            index[i] = c->character;
+        }
+    }
+}
+
+/**
+ * Code point of the 2 bytes UTF-8 sequence, 0 for others
+ */
+static uint16_t utf8_code(const char *str) {
+    unsigned char c0 = str[0];
+    unsigned char c1 = c0 ? str[1] : 0;
+
+    if ((c0 & 0xE0) == 0xC0 && (c1 & 0xC0) == 0x80) {
+        return ((c0 & 0x1F) << 6) | (c1 & 0x3F);
+    }
+
+    return 0;
+}
+
+static void build_index() {
+    add_table(latin_index, cw_characters, false);
+    add_table(latin_index, cw_prosigns, false);
+
+    add_table(cyrillic_index, cw_characters_cyrillic, false);
+    add_table(cyrillic_index, cw_characters, true);
+    add_table(cyrillic_index, cw_prosigns, false);
+
+    for (const cw_characters_t *c = cw_characters; c->morse; c++) {
+        cw_morse_t *m = &ascii_index[toupper((unsigned char) c->character[0])];
+
+        if (!m->len) {
+            *m = cw_morse_from_string(c->morse);
+        }
+    }
+
+    /* Upper case letters are 0x20 below the lower case ones */
+
+    for (const cw_characters_t *c = cw_characters_cyrillic; c->morse; c++) {
+        uint16_t code = utf8_code(c->character);
+
+        if (code >= CYR_FIRST && code + 0x20 <= CYR_LAST) {
+            cyr_index[code - CYR_FIRST] = cw_morse_from_string(c->morse);
+            cyr_index[code + 0x20 - CYR_FIRST] = cyr_index[code - CYR_FIRST];
+        }
+    }
+}
+
+cw_morse_t cw_morse_from_string(const char *morse) {
+    cw_morse_t m;
+
+    cw_morse_clear(&m);
+
+    while (*morse) {
+        cw_morse_push(&m, *morse == '-');
+        morse++;
+    }
+
+    return m;
+}
+
+const char * cw_morse_decode(cw_morse_t m, cw_morse_alphabet_t alphabet) {
+    if (m.len == 0 || m.len > CW_MORSE_MAX_LEN) {
+        return NULL;
+    }
+
+    pthread_once(&index_once, build_index);
+
+    return (alphabet == CW_MORSE_CYRILLIC ? cyrillic_index : latin_index)[code_index(m)];
+}
+
+static size_t find_prefix(const cw_characters_t *table, const char *str, cw_morse_t *m) {
+    for (const cw_characters_t *c = table; c->morse; c++) {
+        size_t len = strlen(c->character);
+
+        if (strncasecmp(c->character, str, len) == 0) {
+            *m = cw_morse_from_string(c->morse);
+            return len;
+        }
+    }
+
+    return 0;
+}
+
+size_t cw_morse_encode(const char *str, cw_morse_t *m) {
+    unsigned char   c = str[0];
+    size_t          len;
+
+    pthread_once(&index_once, build_index);
+
+    if (c == '<' && (len = find_prefix(cw_prosigns, str, m))) {
+        return len;
+    }
+
+    if (c < 128) {
+        c = toupper(c);
+
+        if (ascii_index[c].len) {
+            *m = ascii_index[c];
+            return 1;
+        }
+
+        return 0;
+    }
+
+    uint16_t code = utf8_code(str);
+
+    if (code == CYR_YO || code == CYR_YO_LOW) {
+        code = utf8_code("Е");
+    }
+
+    if (code >= CYR_FIRST && code <= CYR_LAST && cyr_index[code - CYR_FIRST].len) {
+        *m = cyr_index[code - CYR_FIRST];
+        return 2;
+    }
+
+    return 0;
+}
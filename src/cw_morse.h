@@ -0,0 +1,85 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Morse code as bits: dah is 1, first element is the highest bit. Together
+ * with the length it gives an index into direct lookup tables.
+ */
+
+#define CW_MORSE_MAX_LEN    9
+
+typedef struct {
+    char    *morse;
+    char    *character;
+} cw_characters_t;
+
+typedef enum {
+    CW_MORSE_LATIN = 0,
+    CW_MORSE_CYRILLIC,
+} cw_morse_alphabet_t;
+
+typedef struct {
+    uint16_t    bits;
+    uint8_t     len;
+} cw_morse_t;
+
+/* Letters, digits and punctuation */
+extern cw_characters_t cw_characters[];
+/* Prosigns, shared by all alphabets */
+extern cw_characters_t cw_prosigns[];
+/* Russian letters, UTF-8. Digits and punctuation are taken from cw_characters */
+extern cw_characters_t cw_characters_cyrillic[];
+
+static inline void cw_morse_clear(cw_morse_t *m) {
+    m->bits = 0;
+    m->len = 0;
+}
+
+/**
+ * Add element. Code longer than CW_MORSE_MAX_LEN decodes to nothing
+ */
+static inline void cw_morse_push(cw_morse_t *m, bool dah) {
+    if (m->len <= CW_MORSE_MAX_LEN) {
+        m->bits = (m->bits << 1) | dah;
+        m->len++;
+    }
+}
+
+static inline bool cw_morse_dah(cw_morse_t m, uint8_t n) {
+    return (m.bits >> (m.len - 1 - n)) & 1;
+}
+
+/**
+ * Code from the ".-" string
+ */
+cw_morse_t cw_morse_from_string(const char *morse);
+
+/**
+ * Character for the code or NULL
+ */
+const char * cw_morse_decode(cw_morse_t m, cw_morse_alphabet_t alphabet);
+
+/**
+ * Code of the character (Latin, Cyrillic or prosign) at the start of str,
+ * letters in any case. Returns number of consumed bytes, 0 if unknown
+ */
+size_t cw_morse_encode(const char *str, cw_morse_t *m);
+
+#ifdef __cplusplus
+}
+#endif
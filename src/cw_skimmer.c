@@ -0,0 +1,369 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "cw_skimmer.h"
+
+#include "audio.h"
+#include "cw_decoder.h"
+#include "vmath.h"
+
+#include "lvgl/lvgl.h"
+
+#include <liquid/liquid.h>
+
+#include <ctype.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DECIM           8
+#define CHANNELS        64                          /* 86 Hz spacing after decimation */
+#define CH_STEP         (CHANNELS / 2)              /* Input samples per filterbank run */
+#define CH_FIRST        3                           /* 260 Hz */
+#define CH_LAST         31                          /* 2670 Hz, analytic audio has no negative frequencies */
+
+#define NEW_SNR         12.0f                       /* Start track on peak above noise, dB */
+#define NEW_FRAMES      5                           /* ... held that long, so keying clicks and noise do not start it */
+#define MIN_SNR         6.0f                        /* Key is up below this, dB */
+#define KEY_DEPTH       6.0f                        /* Key threshold below the peak at most, dB */
+#define HYST            1.5f                        /* Key threshold hysteresis, dB */
+#define PEAK_DECAY      0.02f                       /* dB per frame */
+#define TIMEOUT_MS      10000
+#define WARMUP          32                          /* Frames until the filters are filled */
+
+typedef struct {
+    bool                active;
+    int                 ch;
+    float               peak;
+    bool                on;
+    uint32_t            idle;                       /* Frames since last key down */
+    cw_decoder_t        dec;
+    char                word[CW_SKIMMER_CALL];
+    cw_skimmer_entry_t  entry;
+} track_t;
+
+static pthread_mutex_t  mux = PTHREAD_MUTEX_INITIALIZER;
+static bool             run = false;
+
+static firdecim_crcf    decim = NULL;
+static firpfbch2_crcf   chan = NULL;
+
+static cfloat           decim_buf[DECIM];
+static size_t           decim_count;
+static cfloat           chan_buf[CH_STEP];
+static size_t           chan_count;
+static cfloat           chan_out[CHANNELS];
+
+static float            power[CHANNELS];
+static float            level[CHANNELS];            /* dB */
+static float            noise[CHANNELS];            /* dB */
+static uint8_t          above[CHANNELS];            /* Frames of the peak above NEW_SNR */
+static uint32_t         frames;
+
+static track_t          tracks[CW_SKIMMER_TRACKS];
+
+static const float      spacing = (float) AUDIO_CAPTURE_RATE / DECIM / CHANNELS;
+static const float      frame_ms = 1000.0f * DECIM * CH_STEP / AUDIO_CAPTURE_RATE;
+
+/**
+ * Prefix with a letter, digit and letters suffix: R2RFE, 2E0ABC, UA9XYZ. Not 5NN
+ */
+static bool is_call_part(const char *s, size_t len) {
+    if (len < 3) {
+        return false;
+    }
+
+    size_t suffix = 0;
+
+    while (suffix < len && isalpha((unsigned char) s[len - 1 - suffix])) {
+        suffix++;
+    }
+
+    size_t prefix = len - suffix - 1;
+
+    if (suffix < 1 || suffix > 4 || prefix < 1 || prefix > 3 || !isdigit((unsigned char) s[prefix])) {
+        return false;
+    }
+
+    bool letter = false;
+
+    for (size_t i = 0; i < prefix; i++) {
+        if (!isalnum((unsigned char) s[i])) {
+            return false;
+        }
+        letter |= isalpha((unsigned char) s[i]);
+    }
+
+    return letter;
+}
+
+static bool is_callsign(const char *word) {
+    const char *part = word;
+
+    while (true) {
+        const char  *end = strchr(part, '/');
+        size_t      len = end ? end - part : strlen(part);
+
+        if (is_call_part(part, len)) {
+            return true;
+        }
+
+        if (!end) {
+            return false;
+        }
+
+        part = end + 1;
+    }
+}
+
+static void append_text(char *buf, size_t size, const char *text) {
+    size_t len = strlen(buf);
+    size_t add = strlen(text);
+
+    if (add >= size) {
+        return;
+    }
+
+    if (len + add >= size) {
+        size_t drop = len + add - (size - 1);
+
+        memmove(buf, buf + drop, len - drop + 1);
+        len -= drop;
+    }
+
+    memcpy(buf + len, text, add + 1);
+}
+
+static void text_cb(const char *text, void *user) {
+    track_t *track = (track_t *) user;
+
+    append_text(track->entry.text, sizeof(track->entry.text), text);
+
+    if (strcmp(text, " ") == 0) {
+        if (is_callsign(track->word)) {
+            strcpy(track->entry.call, track->word);
+        }
+        track->word[0] = 0;
+    } else if (text[0] == '<' || strlen(track->word) + strlen(text) >= sizeof(track->word)) {
+        track->word[0] = 0;
+    } else {
+        strcat(track->word, text);
+    }
+}
+
+static track_t * find_track(int ch) {
+    for (size_t i = 0; i < CW_SKIMMER_TRACKS; i++) {
+        track_t *track = &tracks[i];
+
+        if (track->active && abs(track->ch - ch) <= 1) {
+            return track;
+        }
+    }
+
+    return NULL;
+}
+
+static void start_track(int ch) {
+    for (size_t i = 0; i < CW_SKIMMER_TRACKS; i++) {
+        track_t *track = &tracks[i];
+
+        if (!track->active) {
+            track->active = true;
+            track->ch = ch;
+            track->peak = level[ch];
+            track->on = false;
+            track->idle = 0;
+            track->word[0] = 0;
+
+            memset(&track->entry, 0, sizeof(track->entry));
+            track->entry.freq = ch * spacing;
+            cw_decoder_reset(track->dec);
+            return;
+        }
+    }
+}
+
+static void update_track(track_t *track) {
+    int     ch = track->ch;
+    float   x = level[ch];
+
+    if (x > track->peak) {
+        track->peak = x;
+    } else {
+        track->peak -= PEAK_DECAY;
+    }
+
+    /* Key down tails of the channel filter are too long to wait for the noise floor on strong signals */
+
+    float snr = track->peak - noise[ch];
+    float thr = track->peak - fminf(snr * 0.5f, KEY_DEPTH) + (track->on ? -HYST : HYST);
+
+    track->on = snr > MIN_SNR && x > thr;
+    track->entry.snr = snr;
+
+    if (track->on) {
+        track->idle = 0;
+
+        /* Parabolic interpolation between channels, only around the peak. Otherwise it runs away */
+
+        float l = level[ch - 1];
+        float r = level[ch + 1];
+        float d = l - 2.0f * x + r;
+
+        track->entry.freq = (x >= l && x >= r && d < 0.0f ? ch + 0.5f * (l - r) / d : ch) * spacing;
+    } else if (++track->idle > TIMEOUT_MS / frame_ms) {
+        track->active = false;
+        return;
+    }
+
+    cw_decoder_put(track->dec, track->on, frame_ms);
+    track->entry.wpm = cw_decoder_get_wpm(track->dec);
+}
+
+static void process_frame() {
+    for (int ch = CH_FIRST - 1; ch <= CH_LAST + 1; ch++) {
+        cfloat  y = chan_out[ch];
+        float   p = crealf(y) * crealf(y) + cimagf(y) * cimagf(y);
+
+        power[ch] = (power[ch] + p) * 0.5f;
+        level[ch] = power[ch] + 1e-12f;
+    }
+
+    vmath_power_to_db(&level[CH_FIRST - 1], &level[CH_FIRST - 1], CH_LAST - CH_FIRST + 3);
+
+    for (int ch = CH_FIRST - 1; ch <= CH_LAST + 1; ch++) {
+        if (frames < WARMUP) {
+            noise[ch] = level[ch];
+        } else {
+            /* Follow the floor quickly down and slowly up, so keyed signal does not lift it */
+            noise[ch] += (level[ch] - noise[ch]) * (level[ch] < noise[ch] ? 0.1f : 0.002f);
+        }
+    }
+
+    if (frames < WARMUP) {
+        frames++;
+        return;
+    }
+
+    for (size_t i = 0; i < CW_SKIMMER_TRACKS; i++) {
+        if (tracks[i].active) {
+            update_track(&tracks[i]);
+        }
+    }
+
+    for (int ch = CH_FIRST; ch <= CH_LAST; ch++) {
+        if (level[ch] - noise[ch] > NEW_SNR && level[ch] >= level[ch - 1] && level[ch] >= level[ch + 1]) {
+            if (above[ch] < NEW_FRAMES) {
+                above[ch]++;
+            }
+        } else {
+            above[ch] = 0;
+        }
+
+        if (above[ch] == NEW_FRAMES && !find_track(ch)) {
+            start_track(ch);
+        }
+    }
+}
+
+void cw_skimmer_start() {
+    pthread_mutex_lock(&mux);
+
+    if (!run) {
+        decim = firdecim_crcf_create_kaiser(DECIM, 8, 60.0f);
+        chan = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, CHANNELS, 4, 60.0f);
+
+        for (size_t i = 0; i < CW_SKIMMER_TRACKS; i++) {
+            tracks[i].active = false;
+            tracks[i].dec = cw_decoder_create(text_cb, &tracks[i]);
+        }
+
+        memset(power, 0, sizeof(power));
+        memset(above, 0, sizeof(above));
+        decim_count = 0;
+        chan_count = 0;
+        frames = 0;
+        run = true;
+
+        LV_LOG_USER("CW skimmer: %i channels, %.1f Hz, frame %.2f ms", CH_LAST - CH_FIRST + 1, spacing, frame_ms);
+    }
+
+    pthread_mutex_unlock(&mux);
+}
+
+void cw_skimmer_stop() {
+    pthread_mutex_lock(&mux);
+
+    if (run) {
+        run = false;
+
+        firdecim_crcf_destroy(decim);
+        firpfbch2_crcf_destroy(chan);
+
+        for (size_t i = 0; i < CW_SKIMMER_TRACKS; i++) {
+            cw_decoder_destroy(tracks[i].dec);
+            tracks[i].dec = NULL;
+            tracks[i].active = false;
+        }
+    }
+
+    pthread_mutex_unlock(&mux);
+}
+
+void cw_skimmer_put_audio_samples(unsigned int n, cfloat *samples) {
+    pthread_mutex_lock(&mux);
+
+    if (run) {
+        for (unsigned int i = 0; i < n; i++) {
+            decim_buf[decim_count++] = samples[i];
+
+            if (decim_count < DECIM) {
+                continue;
+            }
+
+            decim_count = 0;
+            firdecim_crcf_execute(decim, decim_buf, &chan_buf[chan_count++]);
+
+            if (chan_count < CH_STEP) {
+                continue;
+            }
+
+            chan_count = 0;
+            firpfbch2_crcf_execute(chan, chan_buf, chan_out);
+            process_frame();
+        }
+    }
+
+    pthread_mutex_unlock(&mux);
+}
+
+static int compare_freq(const void *p1, const void *p2) {
+    const cw_skimmer_entry_t *a = p1;
+    const cw_skimmer_entry_t *b = p2;
+
+    return (a->freq > b->freq) - (a->freq < b->freq);
+}
+
+size_t cw_skimmer_get(cw_skimmer_entry_t *entries, size_t max) {
+    size_t count = 0;
+
+    pthread_mutex_lock(&mux);
+
+    for (size_t i = 0; i < CW_SKIMMER_TRACKS && count < max; i++) {
+        if (tracks[i].active) {
+            entries[count++] = tracks[i].entry;
+        }
+    }
+
+    pthread_mutex_unlock(&mux);
+
+    qsort(entries, count, sizeof(cw_skimmer_entry_t), compare_freq);
+
+    return count;
+}
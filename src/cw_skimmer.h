@@ -0,0 +1,52 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include "helpers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Multi-channel CW skimmer. Audio is decimated and split by a polyphase
+ * filterbank into narrow channels; the channelizer cost does not depend on
+ * the number of decoded signals. Peaks above the noise floor get a track
+ * with own decoder.
+ */
+
+#define CW_SKIMMER_TRACKS   16
+#define CW_SKIMMER_CALL     16
+#define CW_SKIMMER_TEXT     48
+
+typedef struct {
+    float       freq;                       /* Audio frequency, Hz */
+    float       snr;
+    uint32_t    wpm;
+    char        call[CW_SKIMMER_CALL];      /* Last seen callsign */
+    char        text[CW_SKIMMER_TEXT];      /* Tail of the decoded text */
+} cw_skimmer_entry_t;
+
+void cw_skimmer_start();
+void cw_skimmer_stop();
+
+void cw_skimmer_put_audio_samples(unsigned int n, cfloat *samples);
+
+/**
+ * Copy active tracks sorted by frequency. Returns number of entries
+ */
+size_t cw_skimmer_get(cw_skimmer_entry_t *entries, size_t max);
+
+#ifdef __cplusplus
+}
+#endif
@@ -55,9 +55,9 @@ void dialog_destruct() {
     }
 }
 
-void dialog_send(lv_event_code_t event_code, void *param) {
+void dialog_send(lv_event_code_t event_code, const void *param, size_t param_size) {
     if (dialog_is_run()) {
-        event_send(current_dialog->obj, event_code, param);
+        event_send(current_dialog->obj, event_code, param, param_size);
     }
 }
 
@@ -0,0 +1,220 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "dialog_cw_skimmer.h"
+
+#include "cw_skimmer.h"
+#include "dialog.h"
+#include "styles.h"
+#include "params/params.h"
+#include "cfg/subjects.h"
+#include "keyboard.h"
+#include "buttons.h"
+#include "msg.h"
+
+#include <stdio.h>
+
+#define UPDATE_MS 500
+
+static lv_obj_t             *table;
+static lv_timer_t           *update_timer;
+static cw_skimmer_entry_t   entries[CW_SKIMMER_TRACKS];
+static size_t               entries_count = 0;
+
+static void construct_cb(lv_obj_t *parent);
+static void destruct_cb();
+static void key_cb(lv_event_t * e);
+static void audio_cb(unsigned int n, cfloat *samples);
+
+static void tune_cb(button_item_t *item);
+static void clear_cb(button_item_t *item);
+
+static button_item_t btn_tune = {
+    .type  = BTN_TEXT,
+    .label = "Tune",
+    .press = tune_cb,
+};
+static button_item_t btn_clear = {
+    .type  = BTN_TEXT,
+    .label = "Clear",
+    .press = clear_cb,
+};
+
+static buttons_page_t btn_page = {
+    {
+     &btn_tune,
+     &btn_clear,
+     }
+};
+
+static dialog_t             dialog = {
+    .run = false,
+    .construct_cb = construct_cb,
+    .destruct_cb = destruct_cb,
+    .audio_cb = audio_cb,
+    .btn_page = &btn_page,
+    .key_cb = NULL
+};
+
+dialog_t                    *dialog_cw_skimmer = &dialog;
+
+/**
+ * Audio to RF offset direction and the audio tone of the dial frequency
+ */
+static int32_t sideband(int32_t *tone) {
+    x6200_mode_t mode = subject_get_int(cfg_cur.mode);
+
+    *tone = 0;
+
+    switch (mode) {
+        case x6200_mode_lsb:
+        case x6200_mode_lsb_dig:
+            return -1;
+
+        case x6200_mode_cw:
+            *tone = subject_get_int(cfg.key_tone.val);
+            return 1;
+
+        case x6200_mode_cwr:
+            *tone = subject_get_int(cfg.key_tone.val);
+            return -1;
+
+        default:
+            return 1;
+    }
+}
+
+static void update_table() {
+    int32_t tone;
+    int32_t sign = sideband(&tone);
+    int32_t freq = subject_get_int(cfg_cur.fg_freq);
+
+    entries_count = cw_skimmer_get(entries, CW_SKIMMER_TRACKS);
+
+    if (entries_count == 0) {
+        lv_table_set_row_cnt(table, 1);
+
+        for (uint16_t col = 0; col < 4; col++) {
+            lv_table_set_cell_value(table, 0, col, "");
+        }
+        return;
+    }
+
+    lv_table_set_row_cnt(table, entries_count);
+
+    for (size_t i = 0; i < entries_count; i++) {
+        cw_skimmer_entry_t  *entry = &entries[i];
+        int32_t             rf = freq + sign * ((int32_t) entry->freq - tone);
+
+        lv_table_set_cell_value_fmt(table, i, 0, "%i.%02i", rf / 1000, (rf % 1000) / 10);
+        lv_table_set_cell_value_fmt(table, i, 1, "%i", entry->wpm);
+        lv_table_set_cell_value(table, i, 2, entry->call);
+        lv_table_set_cell_value(table, i, 3, entry->text);
+    }
+}
+
+static void update_cb(lv_timer_t *timer) {
+    update_table();
+}
+
+static void construct_cb(lv_obj_t *parent) {
+    dialog.obj = dialog_init(parent);
+
+    table = lv_table_create(dialog.obj);
+
+    lv_obj_remove_style(table, NULL, LV_STATE_ANY | LV_PART_MAIN);
+
+    lv_obj_set_size(table, 775, 320);
+
+    lv_table_set_col_cnt(table, 4);
+    lv_table_set_col_width(table, 0, 140);
+    lv_table_set_col_width(table, 1, 60);
+    lv_table_set_col_width(table, 2, 160);
+    lv_table_set_col_width(table, 3, 410);
+
+    lv_obj_set_style_border_width(table, 0, LV_PART_ITEMS);
+
+    lv_obj_set_style_bg_opa(table, LV_OPA_TRANSP, LV_PART_ITEMS);
+    lv_obj_set_style_text_color(table, lv_color_white(), LV_PART_ITEMS);
+    lv_obj_set_style_pad_top(table, 5, LV_PART_ITEMS);
+    lv_obj_set_style_pad_bottom(table, 5, LV_PART_ITEMS);
+    lv_obj_set_style_pad_left(table, 0, LV_PART_ITEMS);
+    lv_obj_set_style_pad_right(table, 0, LV_PART_ITEMS);
+
+    lv_obj_set_style_text_color(table, lv_color_black(), LV_PART_ITEMS | LV_STATE_EDITED);
+    lv_obj_set_style_bg_color(table, lv_color_white(), LV_PART_ITEMS | LV_STATE_EDITED);
+    lv_obj_set_style_bg_opa(table, 128, LV_PART_ITEMS | LV_STATE_EDITED);
+
+    lv_obj_add_event_cb(table, key_cb, LV_EVENT_KEY, NULL);
+    lv_group_add_obj(keyboard_group, table);
+    lv_group_set_editing(keyboard_group, true);
+
+    lv_obj_align(table, LV_ALIGN_TOP_MID, 0, 10);
+
+    cw_skimmer_start();
+    update_table();
+
+    update_timer = lv_timer_create(update_cb, UPDATE_MS, NULL);
+}
+
+static void destruct_cb() {
+    lv_timer_del(update_timer);
+    cw_skimmer_stop();
+}
+
+static void audio_cb(unsigned int n, cfloat *samples) {
+    cw_skimmer_put_audio_samples(n, samples);
+}
+
+static void key_cb(lv_event_t * e) {
+    uint32_t key = *((uint32_t *)lv_event_get_param(e));
+
+    switch (key) {
+        case LV_KEY_ESC:
+            dialog_destruct(&dialog);
+            break;
+
+        case KEY_VOL_LEFT_EDIT:
+        case KEY_VOL_LEFT_SELECT:
+            radio_change_vol(-1);
+            break;
+
+        case KEY_VOL_RIGHT_EDIT:
+        case KEY_VOL_RIGHT_SELECT:
+            radio_change_vol(1);
+            break;
+    }
+}
+
+/**
+ * Move the selected signal to the key tone
+ */
+static void tune_cb(button_item_t *item) {
+    uint16_t row = 0;
+    uint16_t col = 0;
+
+    lv_table_get_selected_cell(table, &row, &col);
+
+    if (row == LV_TABLE_CELL_NONE || row >= entries_count) {
+        return;
+    }
+
+    int32_t tone;
+    int32_t sign = sideband(&tone);
+    int32_t key_tone = subject_get_int(cfg.key_tone.val);
+    int32_t freq = subject_get_int(cfg_cur.fg_freq);
+
+    subject_set_int(cfg_cur.fg_freq, freq + sign * ((int32_t) entries[row].freq - key_tone));
+    msg_update_text_fmt("Tuned to %s", entries[row].call[0] ? entries[row].call : "signal");
+}
+
+static void clear_cb(button_item_t *item) {
+    cw_skimmer_stop();
+    cw_skimmer_start();
+    update_table();
+}
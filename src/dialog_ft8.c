@@ -18,6 +18,7 @@
 #include "cfg/digital_modes.h"
 #include "radio.h"
 #include "audio.h"
+#include "fft_registry.h"
 #include "keyboard.h"
 #include "events.h"
 #include "buttons.h"
@@ -49,8 +50,7 @@
 #include <errno.h>
 #include <ctype.h>
 
-#define DECIM           6
-#define SAMPLE_RATE     (AUDIO_CAPTURE_RATE / DECIM)
+#define SAMPLE_RATE     (AUDIO_CAPTURE_RATE / FTX_WORKER_DECIM)
 
 #define WIDTH           771
 
@@ -129,7 +129,6 @@ static pthread_mutex_t      audio_mutex = PTHREAD_MUTEX_INITIALIZER;
 static cbuffercf            audio_buf;
 static pthread_t            thread;
 
-static firdecim_crcf        decim;
 static float complex        *decim_buf;
 
 static adif_log             ft8_log;
@@ -235,7 +234,7 @@ static void worker_init() {
     /* Waterfall */
     waterfall_nfft = (uint16_t)(WIDTH * SAMPLE_RATE / (filter_high - filter_low));
 
-    waterfall_sg = spgramcf_create(waterfall_nfft, LIQUID_WINDOW_HANN, waterfall_nfft, waterfall_nfft / 2);
+    waterfall_sg = fft_registry_spgram_get(waterfall_nfft, LIQUID_WINDOW_HANN, waterfall_nfft, waterfall_nfft / 2);
     waterfall_psd = (float *) malloc(waterfall_nfft * sizeof(float));
     waterfall_time = get_time();
 
@@ -253,7 +252,7 @@ static void worker_done() {
     ftx_worker_free();
     free(decim_buf);
 
-    spgramcf_destroy(waterfall_sg);
+    fft_registry_spgram_put(waterfall_sg);
     free(waterfall_psd);
 
     ftx_qso_processor_delete(qso_processor);
@@ -476,7 +475,6 @@ static void destruct_cb() {
     keyboard_close();
     worker_done();
 
-    firdecim_crcf_destroy(decim);
     free(audio_buf);
 
     mem_load(MEM_BACKUP_ID);
@@ -599,8 +597,6 @@ static void construct_cb(lv_obj_t *parent) {
     lv_obj_add_event_cb(dialog.obj, band_cb, EVENT_BAND_UP, NULL);
     lv_obj_add_event_cb(dialog.obj, band_cb, EVENT_BAND_DOWN, NULL);
 
-    decim = firdecim_crcf_create_kaiser(DECIM, 8, 40.0f);
-    firdecim_crcf_set_scale(decim, 1.0f / DECIM);
     audio_buf = cbuffercf_create(AUDIO_CAPTURE_RATE * 3);
 
     /* Waterfall */
@@ -1196,14 +1192,14 @@ static void rx_worker(bool new_slot, slot_info_t *s_info) {
     unsigned int   n;
     float complex *buf;
     const int block_size = ftx_worker_get_block_size();
-    const size_t   size = block_size * DECIM;
+    const size_t   size = block_size * FTX_WORKER_DECIM;
 
     pthread_mutex_lock(&audio_mutex);
 
     while (cbuffercf_size(audio_buf) > size) {
         cbuffercf_read(audio_buf, size, &buf, &n);
 
-        firdecim_crcf_execute_block(decim, buf, block_size, decim_buf);
+        ftx_worker_decimate(buf, block_size, decim_buf);
         cbuffercf_release(audio_buf, size);
 
         waterfall_process(decim_buf, block_size);
@@ -703,6 +703,8 @@ static action_items_t long_action_items[] = {
     { .label = " APP GPS ", .action = ACTION_APP_GPS },
     { .label = " APP Settings", .action = ACTION_APP_SETTINGS },
     { .label = " APP Recorder", .action = ACTION_APP_RECORDER },
+    { .label = " APP CW Skimmer", .action = ACTION_APP_CW_SKIMMER },
+    { .label = " APP PSK", .action = ACTION_APP_PSK },
     { .label = " QTH Grid", .action = ACTION_APP_QTH },
     { .label = NULL, .action = ACTION_NONE }
 };
@@ -970,6 +972,28 @@ static uint8_t make_audio_gain(uint8_t row) {
     return row + 1;
 }
 
+/* Recorder */
+
+static uint8_t make_recorder(uint8_t row) {
+    lv_obj_t    *obj;
+
+    row_dsc[row] = 54;
+
+    obj = lv_label_create(grid);
+
+    lv_label_set_text(obj, "Pre-record, s");
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 0, 1, LV_GRID_ALIGN_CENTER, row, 1);
+
+    obj = spinbox_uint8(grid, &params.rec_pre_time);
+
+    lv_spinbox_set_digit_format(obj, 2, 0);
+    lv_spinbox_set_digit_step_direction(obj, LV_DIR_LEFT);
+    lv_obj_set_size(obj, SMALL_2, 56);
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 1, 2, LV_GRID_ALIGN_CENTER, row, 1);
+
+    return row + 1;
+}
+
 /* Transverter */
 
 static void transverter_from_update_cb(lv_event_t * e) {
@@ -1384,6 +1408,7 @@ static void construct_cb(lv_obj_t *parent) {
 
     row = make_delimiter(row);
     row = make_audio_gain(row);
+    row = make_recorder(row);
 
     row = make_delimiter(row);
     row = make_voice(row);
@@ -126,7 +126,7 @@ static void do_step(float vswr) {
     }
     data_filtered[filtered_index] = avg / 5.0f;
 
-    event_send(chart, LV_EVENT_REFRESH, NULL);
+    event_send(chart, LV_EVENT_REFRESH, NULL, 0);
 
     freq_index++;
 
@@ -364,7 +364,7 @@ void dialog_swrscan_span_cb(button_item_t *item) {
     subject_set_int(cfg.swrscan_span.val, span);
 
     do_init();
-    event_send(chart, LV_EVENT_REFRESH, NULL);
+    event_send(chart, LV_EVENT_REFRESH, NULL, 0);
 }
 
 void set_span(Subject *subj, void *user_data) {
@@ -7,6 +7,7 @@
  */
 
 #include "dsp.h"
+#include "psd.h"
 
 #include "cw.h"
 #include "util.h"
@@ -20,10 +21,12 @@
 extern "C" {
     #include "audio.h"
     #include "cfg/cfg.h"
+    #include "cfg/snapshot.h"
     #include "dialog_msg_voice.h"
     #include "meter.h"
     #include "recorder.h"
     #include "rtty.h"
+    #include "psk.h"
     #include "spectrum.h"
     #include "waterfall.h"
 
@@ -38,80 +41,9 @@ extern "C" {
 #define ANF_INTERVAL_MS 500
 #define ANF_HIST_LEN 3
 
-template <size_t input_size, size_t output_size> class AveragedPSD {
-  private:
-    int8_t                         count;
-    std::array<float, input_size>  psd;
-    std::array<float, output_size> averaged;
-
-    size_t positions[output_size];
-    float offsets[output_size];
-
-    std::mutex mutex;
-
-    void lerp_averaged() {
-        if (output_size == input_size) {
-            for (size_t i = 0; i < output_size; i++) {
-                averaged[i] = psd[i];
-            }
-        } else {
-            float a, b;
-            for (size_t i = 0; i < output_size; i++) {
-                a = psd[positions[i]];
-                b = psd[positions[i] + 1];
-                averaged[i] = a + (b - a) * offsets[i];
-            }
-        }
-    }
-
-  public:
-    AveragedPSD() {
-        for (size_t i = 0; i < output_size; i++) {
-            float f = (float)i / output_size * input_size;
-            positions[i] = f;
-            offsets[i] = f - positions[i];
-        }
-    }
-
-    void reset() {
-        const std::lock_guard<std::mutex> lock(mutex);
-        count = 0;
-        psd.fill(0.0f);
-    };
-
-    void add_samples(float *samples) {
-        for (size_t i = 0; i < psd.size(); i++)
-        {
-            // dB to power
-            psd[i] += powf(10.0f, samples[i] * 0.1f);
-        }
-        count++;
-    };
-
-    std::array<float, output_size> *get() {
-        {
-            const std::lock_guard<std::mutex> lock(mutex);
-            if (!count) {
-                return nullptr;
-            }
-            liquid_vectorf_mulscalar(psd.data(), psd.size(), 1.0f / count, psd.data());
-            lerp_averaged();
-        }
-
-        for (size_t i = 0; i < averaged.size(); i++) {
-            averaged[i] = 10.0f * log10f(averaged[i] + 1e-12f);
-        }
-
-        reset();
-        return &averaged;
-    };
-};
-
 static AveragedPSD<RADIO_SAMPLES, SPECTRUM_NFFT> spectrum_avg_psd;
 static AveragedPSD<RADIO_SAMPLES, RADIO_SAMPLES> waterfall_avg_psd;
 
-static uint32_t       fft_width = FFT_FULL_WIDTH;
-
 static float          spectrum_psd[SPECTRUM_NFFT];
 static float          spectrum_psd_filtered[SPECTRUM_NFFT];
 static float          spectrum_beta   = 0.7f;
@@ -135,12 +67,8 @@ static cfloat  *audio;
 static bool ready = false;
 static bool last_tx = false;
 
-static x6200_mode_t cur_mode;
-
-static void dsp_update_min_max(float *data_buf, uint16_t size);
+static void dsp_update_min_max(float *data_buf, uint16_t size, uint32_t fft_width);
 static void on_cur_freq_change(Subject *subj, void *user_data);
-static void on_cur_mode_change(Subject *subj, void *user_data);
-static void on_fft_dec_change(Subject *subj, void *user_data);
 
 
 /* * */
@@ -155,9 +83,6 @@ void dsp_init() {
     audio_hilb = firhilbf_create(7, 60.0f);
 
     cfg_cur.fg_freq->subscribe(on_cur_freq_change);
-    cfg_cur.mode->subscribe(on_cur_mode_change)->notify();
-
-    cfg_cur.fft_width->subscribe(on_fft_dec_change)->notify();
     ready = true;
 }
 
@@ -209,7 +134,10 @@ void dsp_samples(float *buf_samples, uint16_t size, bool tx, int16_t dbm) {
             // update min/max
             if (!tx) {
                 // Ignore borders
-                dsp_update_min_max(waterfall_avg_data->data() + 8, waterfall_avg_data->size() - 16);
+                cfg_snapshot_t snap;
+
+                cfg_snapshot_get(&snap);
+                dsp_update_min_max(waterfall_avg_data->data() + 8, waterfall_avg_data->size() - 16, snap.fft_width);
             }
         }
     }
@@ -224,14 +152,6 @@ static void on_cur_freq_change(Subject *subj, void *user_data) {
     spectrum_avg_psd.reset();
 }
 
-static void on_cur_mode_change(Subject *subj, void *user_data) {
-    cur_mode = (x6200_mode_t)subject_get_int(cfg_cur.mode);
-}
-
-static void on_fft_dec_change(Subject *subj, void *user_data) {
-    fft_width = subject_get_int(cfg_cur.fft_width);
-}
-
 float dsp_get_spectrum_beta() {
     return spectrum_beta;
 }
@@ -250,17 +170,25 @@ void dsp_put_audio_samples(size_t nsamples, int16_t *samples) {
         return;
     }
 
-    if (recorder_is_on()) {
-        recorder_put_audio_samples(nsamples, samples);
-    }
+    // Recorder keeps samples for pre-record even when it is off
+    recorder_put_audio_samples(nsamples, samples);
 
     for (uint16_t i = 0; i < nsamples; i++)
         firhilbf_r2c_execute(audio_hilb, samples[i] / 32768.0f, &audio[i]);
 
+    cfg_snapshot_t snap;
+
+    cfg_snapshot_get(&snap);
+
+    x6200_mode_t cur_mode = snap.mode;
+
     if (rtty_get_state() == RTTY_RX) {
         rtty_put_audio_samples(nsamples, audio);
+    } else if (psk_get_state() == PSK_RX) {
+        psk_put_audio_samples(nsamples, audio);
     } else if (cur_mode == x6200_mode_cw || cur_mode == x6200_mode_cwr) {
         cw_put_audio_samples(nsamples, audio);
+        dialog_audio_samples(nsamples, audio);
     } else {
         dialog_audio_samples(nsamples, audio);
     }
@@ -273,42 +201,15 @@ static int compare_fft(const void *p1, const void *p2) {
     return (*i1 < *i2) ? -1 : 1;
 }
 
-static void dsp_update_min_max(float *data_buf, uint16_t size) {
+static void dsp_update_min_max(float *data_buf, uint16_t size, uint32_t fft_width) {
     if (min_max_delay) {
         min_max_delay--;
         return;
     }
 
-    // dB to power
-    float psd[size];
-    for (size_t i = 0; i < size; i++)
-    {
-        psd[i] = powf(10.0f, data_buf[i] * 0.1f);
-    }
-
     // Sum power within window
-    size_t window = roundf(2700.0f * RADIO_SAMPLES / fft_width);
-
-    const size_t psd_sum_size = size - window;
-    float psd_sum[psd_sum_size];
-    for (size_t i = 0; i < psd_sum_size; i++)
-    {
-        psd_sum[i] = 0.0f;
-        for (size_t j = 0; j < window; j++)
-        {
-            psd_sum[i] += psd[i + j];
-        }
-    }
-
-    float min = MAXFLOAT;
-    for (size_t i = 0; i < psd_sum_size; i++)
-    {
-        min = LV_MIN(min, psd_sum[i]);
-    }
-
-    min = LV_MAX(min, 1e-20f);
-
-    min = 10.0f * log10f(min);
+    size_t window = psd_noise_window(RADIO_SAMPLES, fft_width);
+    float  min = psd_window_min(data_buf, size, window);
 
     // Get Minimum Statistics offset for the noise level
     float offset;
@@ -7,10 +7,12 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <pthread.h>
 #include "events.h"
 #include "backlight.h"
 #include "keyboard.h"
+#include "wakeup.h"
 
 #define QUEUE_SIZE  64
 
@@ -25,16 +27,24 @@ uint32_t        EVENT_GPS;
 uint32_t        EVENT_BAND_UP;
 uint32_t        EVENT_BAND_DOWN;
 
+/* Pool of events is the queue itself, params are kept inline */
+
 typedef struct {
     lv_obj_t        *obj;
     lv_event_code_t event_code;
-    void            *param;
+    size_t          param_size;
+    union {
+        int32_t     diff;
+        int32_t     key;
+        uint8_t     data[EVENT_PARAM_SIZE];
+    } param;
 } item_t;
 
-static item_t           *queue[QUEUE_SIZE];
+static item_t           queue[QUEUE_SIZE];
 static uint8_t          queue_write = 0;
 static uint8_t          queue_read = 0;
-static pthread_mutex_t  queue_mux;
+static size_t           queue_peak = 0;
+static pthread_mutex_t  queue_mux = PTHREAD_MUTEX_INITIALIZER;
 
 void event_init() {
     EVENT_ROTARY = lv_event_register_id();
@@ -47,67 +57,121 @@ void event_init() {
     EVENT_GPS = lv_event_register_id();
     EVENT_BAND_UP = lv_event_register_id();
     EVENT_BAND_DOWN = lv_event_register_id();
-
-    for (uint8_t i = 0; i < QUEUE_SIZE; i++)
-        queue[i] = NULL;
-
-    pthread_mutex_init(&queue_mux, NULL);
 }
 
 void event_obj_check() {
-    while (queue_read != queue_write) {
+    item_t item;
+
+    while (true) {
         pthread_mutex_lock(&queue_mux);
+
+        if (queue_read == queue_write) {
+            pthread_mutex_unlock(&queue_mux);
+            break;
+        }
+
         queue_read = (queue_read + 1) % QUEUE_SIZE;
 
-        item_t *item = queue[queue_read];
-        queue[queue_read] = NULL;
+        /* Copy out, so the slot is free for senders during the dispatch */
+
+        item_t *slot = &queue[queue_read];
+
+        item.obj = slot->obj;
+        item.event_code = slot->event_code;
+        item.param_size = slot->param_size;
+        memcpy(&item.param, &slot->param, slot->param_size);
+
         pthread_mutex_unlock(&queue_mux);
 
-        if (item) {
-            if (!item->obj) {
-                item->obj = lv_scr_act();
-            }
-            if (item->event_code == LV_EVENT_REFRESH) {
-                lv_obj_invalidate(item->obj);
-            } else {
-                lv_event_send(item->obj, item->event_code, item->param);
-            }
-
-            if (item->param != NULL) {
-                free(item->param);
-            }
-
-            free(item);
+        if (!item.obj) {
+            item.obj = lv_scr_act();
+        }
+        if (item.event_code == LV_EVENT_REFRESH) {
+            lv_obj_invalidate(item.obj);
+        } else {
+            lv_event_send(item.obj, item.event_code, item.param_size ? &item.param : NULL);
         }
     }
 }
 
-void event_send(lv_obj_t *obj, lv_event_code_t event_code, void *param) {
-    pthread_mutex_lock(&queue_mux);
-
+static item_t * queue_next() {
     uint8_t next = (queue_write + 1) % QUEUE_SIZE;
 
-    if (queue[next]) {
-        pthread_mutex_unlock(&queue_mux);
-        LV_LOG_ERROR("Overflow");
+    if (next == queue_read) {
+        LV_LOG_ERROR("Overflow, peak depth %zu", queue_peak);
+        return NULL;
+    }
+
+    queue_write = next;
+
+    size_t depth = (queue_write + QUEUE_SIZE - queue_read) % QUEUE_SIZE;
+
+    if (depth > queue_peak) {
+        queue_peak = depth;
+    }
+
+    return &queue[next];
+}
+
+void event_send(lv_obj_t *obj, lv_event_code_t event_code, const void *param, size_t param_size) {
+    if (param_size > EVENT_PARAM_SIZE) {
+        LV_LOG_ERROR("Param is too big: %zu", param_size);
         return;
     }
 
-    item_t *item = malloc(sizeof(item_t));
+    pthread_mutex_lock(&queue_mux);
 
-    item->obj = obj;
-    item->event_code = event_code;
-    item->param = param;
+    item_t *item = queue_next();
 
-    queue[next] = item;
-    queue_write = next;
+    if (item) {
+        item->obj = obj;
+        item->event_code = event_code;
+        item->param_size = param_size;
+
+        if (param_size) {
+            memcpy(&item->param, param, param_size);
+        }
+    }
 
     pthread_mutex_unlock(&queue_mux);
+
+    if (item) {
+        wakeup_signal();
+    }
 }
 
 void event_send_key(int32_t key) {
-    int32_t *c = malloc(sizeof(int32_t));
-    *c = key;
+    event_send(lv_group_get_focused(keyboard_group), LV_EVENT_KEY, &key, sizeof(key));
+}
+
+void event_send_rotary(lv_obj_t *obj, int32_t diff) {
+    pthread_mutex_lock(&queue_mux);
+
+    item_t *item = &queue[queue_write];
+
+    /* Fast spin while the UI is busy comes as one event */
+
+    if (queue_read != queue_write && item->event_code == EVENT_ROTARY && item->obj == obj) {
+        item->param.diff += diff;
+    } else {
+        item = queue_next();
+
+        if (item) {
+            item->obj = obj;
+            item->event_code = EVENT_ROTARY;
+            item->param_size = sizeof(item->param.diff);
+            item->param.diff = diff;
+        }
+    }
+
+    pthread_mutex_unlock(&queue_mux);
+    wakeup_signal();
+}
+
+size_t event_get_peak_depth() {
+    pthread_mutex_lock(&queue_mux);
+    size_t res = queue_peak;
+    pthread_mutex_unlock(&queue_mux);
 
-    event_send(lv_group_get_focused(keyboard_group), LV_EVENT_KEY, c);
+    return res;
 }
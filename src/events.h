@@ -11,8 +11,12 @@
 #include "lvgl/lvgl.h"
 
 #include <unistd.h>
+#include <stddef.h>
 #include <stdint.h>
 
+/* Largest event param, it is copied into the queue */
+#define EVENT_PARAM_SIZE    160
+
 typedef enum {
     KEYPAD_UNKNOWN = 0,
 
@@ -134,5 +138,19 @@ extern uint32_t EVENT_BAND_DOWN;
 void event_init();
 
 void event_obj_check();
-void event_send(lv_obj_t *obj, lv_event_code_t event_code, void *param);
+
+/**
+ * Queue event for the UI thread. Param is copied, so it may be on the stack
+ */
+void event_send(lv_obj_t *obj, lv_event_code_t event_code, const void *param, size_t param_size);
 void event_send_key(int32_t key);
+
+/**
+ * EVENT_ROTARY with int32_t diff. Pending diff to the same object is summed
+ */
+void event_send_rotary(lv_obj_t *obj, int32_t diff);
+
+/**
+ * Most events waiting in the queue since start
+ */
+size_t event_get_peak_depth();
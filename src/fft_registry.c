@@ -0,0 +1,205 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "fft_registry.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+typedef enum {
+    KIND_PLAN,
+    KIND_WINDOW,
+    KIND_SPGRAM
+} kind_t;
+
+typedef struct entry_s {
+    struct entry_s      *next;
+    kind_t              kind;
+    uint32_t            size;
+    int                 type;       /* Direction, window type or spgram window type */
+    uint32_t            len;        /* Spgram window length and delay */
+    uint32_t            delay;
+    uint32_t            refs;
+
+    union {
+        fft_registry_plan_t plan;
+        float               *window;
+        spgramcf            sg;
+    };
+} entry_t;
+
+static pthread_mutex_t  mux = PTHREAD_MUTEX_INITIALIZER;
+static entry_t          *entries = NULL;
+
+static entry_t * find(kind_t kind, uint32_t size, int type, uint32_t len, uint32_t delay, bool shared) {
+    for (entry_t *e = entries; e; e = e->next) {
+        if (e->kind == kind && e->size == size && e->type == type && e->len == len && e->delay == delay && (shared || e->refs == 0)) {
+            return e;
+        }
+    }
+
+    return NULL;
+}
+
+static entry_t * add(kind_t kind, uint32_t size, int type, uint32_t len, uint32_t delay) {
+    entry_t *e = calloc(1, sizeof(entry_t));
+
+    e->kind = kind;
+    e->size = size;
+    e->type = type;
+    e->len = len;
+    e->delay = delay;
+    e->next = entries;
+    entries = e;
+
+    return e;
+}
+
+fft_registry_plan_t * fft_registry_plan_get(uint32_t size, int dir) {
+    pthread_mutex_lock(&mux);
+
+    entry_t *e = find(KIND_PLAN, size, dir, 0, 0, false);
+
+    if (!e) {
+        e = add(KIND_PLAN, size, dir, 0, 0);
+
+        e->plan.size = size;
+        e->plan.time = calloc(size, sizeof(cfloat));
+        e->plan.freq = calloc(size, sizeof(cfloat));
+        e->plan.plan = fft_create_plan(size, e->plan.time, e->plan.freq, dir, 0);
+    }
+
+    e->refs++;
+    pthread_mutex_unlock(&mux);
+
+    return &e->plan;
+}
+
+void fft_registry_plan_put(fft_registry_plan_t *plan) {
+    pthread_mutex_lock(&mux);
+
+    for (entry_t *e = entries; e; e = e->next) {
+        if (e->kind == KIND_PLAN && &e->plan == plan) {
+            e->refs--;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&mux);
+}
+
+static float * window_create(uint32_t size, fft_window_t type) {
+    float *w = malloc(size * sizeof(float));
+    float scale = 0.0f;
+
+    for (uint32_t i = 0; i < size; i++) {
+        w[i] = liquid_hann(i, size);
+    }
+
+    switch (type) {
+        case FFT_WINDOW_HANN:
+            break;
+
+        case FFT_WINDOW_HANN_POWER:
+            for (uint32_t i = 0; i < size; i++) {
+                scale += w[i] * w[i];
+            }
+            scale = 1.0f / sqrtf(scale);
+
+            for (uint32_t i = 0; i < size; i++) {
+                w[i] *= scale;
+            }
+            break;
+
+        case FFT_WINDOW_HANN_AMPLITUDE:
+            scale = 2.0f / size;
+
+            for (uint32_t i = 0; i < size; i++) {
+                w[i] *= scale;
+            }
+            break;
+    }
+
+    return w;
+}
+
+const float * fft_registry_window_get(uint32_t size, fft_window_t type) {
+    pthread_mutex_lock(&mux);
+
+    entry_t *e = find(KIND_WINDOW, size, type, 0, 0, true);
+
+    if (!e) {
+        e = add(KIND_WINDOW, size, type, 0, 0);
+        e->window = window_create(size, type);
+    }
+
+    e->refs++;
+    pthread_mutex_unlock(&mux);
+
+    return e->window;
+}
+
+void fft_registry_window_put(const float *window) {
+    pthread_mutex_lock(&mux);
+
+    for (entry_t *e = entries; e; e = e->next) {
+        if (e->kind == KIND_WINDOW && e->window == window) {
+            e->refs--;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&mux);
+}
+
+spgramcf fft_registry_spgram_get(uint32_t nfft, int wtype, uint32_t window_len, uint32_t delay) {
+    pthread_mutex_lock(&mux);
+
+    entry_t *e = find(KIND_SPGRAM, nfft, wtype, window_len, delay, false);
+
+    if (e) {
+        spgramcf_reset(e->sg);
+    } else {
+        e = add(KIND_SPGRAM, nfft, wtype, window_len, delay);
+        e->sg = spgramcf_create(nfft, wtype, window_len, delay);
+    }
+
+    e->refs++;
+    pthread_mutex_unlock(&mux);
+
+    return e->sg;
+}
+
+void fft_registry_spgram_put(spgramcf sg) {
+    pthread_mutex_lock(&mux);
+
+    for (entry_t *e = entries; e; e = e->next) {
+        if (e->kind == KIND_SPGRAM && e->sg == sg) {
+            e->refs--;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&mux);
+}
+
+void fft_registry_get_stat(fft_registry_stat_t *stat) {
+    pthread_mutex_lock(&mux);
+
+    stat->entries = 0;
+    stat->refs = 0;
+
+    for (entry_t *e = entries; e; e = e->next) {
+        stat->entries++;
+        stat->refs += e->refs;
+    }
+
+    pthread_mutex_unlock(&mux);
+}
@@ -0,0 +1,66 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include "helpers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <liquid/liquid.h>
+#include <stdint.h>
+
+/*
+ * Process-wide store of FFT plans, windows and spectrogram objects. Windows
+ * are read-only and shared by all users. Plans and spectrograms have their
+ * own buffers and state, so a user gets a free one of the size and it goes
+ * back to the pool on put. Nothing is freed, so reopening a decoder skips
+ * the setup. Pools grow only to the most users of a size at the same time.
+ * Thread safe
+ */
+
+typedef enum {
+    FFT_WINDOW_HANN = 0,
+    FFT_WINDOW_HANN_POWER,          /* Unit power: w / sqrt(sum w^2) */
+    FFT_WINDOW_HANN_AMPLITUDE,      /* w * 2 / n */
+} fft_window_t;
+
+typedef struct {
+    fftplan     plan;
+    cfloat      *time;              /* Input, bound to the plan */
+    cfloat      *freq;              /* Output */
+    uint32_t    size;
+} fft_registry_plan_t;
+
+/**
+ * Plan with buffers, dir is LIQUID_FFT_FORWARD or LIQUID_FFT_BACKWARD
+ */
+fft_registry_plan_t * fft_registry_plan_get(uint32_t size, int dir);
+void fft_registry_plan_put(fft_registry_plan_t *plan);
+
+const float * fft_registry_window_get(uint32_t size, fft_window_t type);
+void fft_registry_window_put(const float *window);
+
+/**
+ * Spectrogram is reset on get
+ */
+spgramcf fft_registry_spgram_get(uint32_t nfft, int wtype, uint32_t window_len, uint32_t delay);
+void fft_registry_spgram_put(spgramcf sg);
+
+typedef struct {
+    uint32_t    entries;            /* Plans, windows and spectrograms made */
+    uint32_t    refs;               /* Held by users */
+} fft_registry_stat_t;
+
+void fft_registry_get_stat(fft_registry_stat_t *stat);
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,6 +9,8 @@
 #include "worker.h"
 
 #include "../util.h"
+#include "../fft_registry.h"
+#include "../vmath.h"
 #include "gfsk.h"
 
 #include "lvgl/lvgl.h"
@@ -31,11 +33,11 @@
 #define DECODE_BLOCK_STRIDE 2    // Try to decode each N block
 #define EARLY_LDPC_ITERATIONS 25 // LDPC iterations on early decoding
 
-static float complex *time_buf;
-static float complex *freq_buf;
-static fftplan        fft;
-static windowcf       frame_window;
-static complex float *rx_window = NULL;
+static firdecim_crcf        decim;
+static fft_registry_plan_t  *fft;
+static windowcf             frame_window;
+static const float          *rx_window = NULL;
+static float                *fft_db = NULL;
 
 static float symbol_period;
 static int   block_size;
@@ -106,19 +108,14 @@ void ftx_worker_init(int sample_rate, ftx_protocol_t protocol) {
     find_candidates_at = n_tones - sync_num;
 
     /* FT8 DSP */
+    decim = firdecim_crcf_create_kaiser(FTX_WORKER_DECIM, 8, 40.0f);
+    firdecim_crcf_set_scale(decim, 1.0f / FTX_WORKER_DECIM);
+
     nfft = block_size * FREQ_OSR;
-    float fft_norm = 2.0f / nfft;
-    time_buf = (float complex *)malloc(nfft * sizeof(float complex));
-    freq_buf = (float complex *)malloc(nfft * sizeof(float complex));
-    fft = fft_create_plan(nfft, time_buf, freq_buf, LIQUID_FFT_FORWARD, 0);
+    fft = fft_registry_plan_get(nfft, LIQUID_FFT_FORWARD);
     frame_window = windowcf_create(nfft);
-
-    rx_window = malloc(nfft * sizeof(complex float));
-    float window_norm = 2.0f / nfft;
-
-    for (uint16_t i = 0; i < nfft; i++) {
-        rx_window[i] = liquid_hann(i, nfft) * window_norm;
-    }
+    rx_window = fft_registry_window_get(nfft, FFT_WINDOW_HANN_AMPLITUDE);
+    fft_db = (float *)malloc(nfft * sizeof(float));
 
     ftx_worker_reset();
 }
@@ -127,14 +124,13 @@ void ftx_worker_init(int sample_rate, ftx_protocol_t protocol) {
  * Cleanup worker
  */
 void ftx_worker_free() {
+    firdecim_crcf_destroy(decim);
     free(wf.mag);
     windowcf_destroy(frame_window);
 
-    free(time_buf);
-    free(freq_buf);
-    fft_destroy_plan(fft);
-
-    free(rx_window);
+    fft_registry_plan_put(fft);
+    fft_registry_window_put(rx_window);
+    free(fft_db);
     hashtable_delete();
 }
 
@@ -179,6 +175,10 @@ bool ftx_worker_generate_tx_samples(const char *text, const uint16_t signal_freq
     return true;
 }
 
+void ftx_worker_decimate(float complex *samples, uint32_t n_out, float complex *out) {
+    firdecim_crcf_execute_block(decim, samples, n_out, out);
+}
+
 void ftx_worker_put_rx_samples(float complex *samples, uint32_t n_samples) {
     if (wf.num_blocks >= wf.max_blocks) {
         LV_LOG_ERROR("FT8 wf is full");
@@ -200,17 +200,24 @@ void ftx_worker_put_rx_samples(float complex *samples, uint32_t n_samples) {
 
         windowcf_read(frame_window, &frame_ptr);
 
-        liquid_vectorcf_mul(rx_window, frame_ptr, nfft, time_buf);
+        for (int i = 0; i < nfft; i++) {
+            fft->time[i] = frame_ptr[i] * rx_window[i];
+        }
+
+        fft_execute(fft->plan);
+
+        for (int i = 0; i < nfft; i++) {
+            complex float freq = fft->freq[i];
+
+            fft_db[i] = crealf(freq * conjf(freq));
+        }
 
-        fft_execute(fft);
+        vmath_power_to_db(fft_db, fft_db, nfft);
 
         for (int freq_sub = 0; freq_sub < wf.freq_osr; freq_sub++)
             for (int bin = 0; bin < wf.num_bins; bin++) {
                 int           src_bin = (bin * wf.freq_osr) + freq_sub;
-                complex float freq = freq_buf[src_bin];
-                float         mag2 = crealf(freq * conjf(freq));
-                float         db = 10.0f * log10f(mag2);
-                int           scaled = (int16_t)(db * 2.0f + 240.0f);
+                int           scaled = (int16_t)(fft_db[src_bin] * 2.0f + 240.0f);
 
                 if (scaled < 0) {
                     scaled = 0;
@@ -14,6 +14,9 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+/// @brief Decimation of the captured audio to the worker sample rate
+#define FTX_WORKER_DECIM 6
+
 /// @brief Callback for decoded message
 typedef void (*decoded_msg_cb)(const char *text, int snr, float freq_hz, float time_sec, void *user_data);
 
@@ -38,6 +41,12 @@ void ftx_worker_reset();
 bool ftx_worker_generate_tx_samples(const char *text, const uint16_t signal_freq, const uint32_t sample_rate,
                                     int16_t **samples, uint32_t *n_samples);
 
+/// @brief Decimate captured audio to the worker sample rate
+/// @param[in] samples FTX_WORKER_DECIM * n_out audio samples
+/// @param[in] n_out count of output samples
+/// @param[out] out decimated samples
+void ftx_worker_decimate(float complex *samples, uint32_t n_out, float complex *out);
+
 /// @brief Process RX audio samples
 /// @param[in] samples audio samples
 /// @param[in] n_samples count of samples
@@ -7,8 +7,13 @@
  */
 
 #include <math.h>
+#include <string.h>
 #include "goertzel.h"
 
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
 void goertzel_bin_init(goertzel_t *goertzel, uint16_t bin, uint16_t bins) {
     float       w = (float) (2.0 * M_PI * bin) / (float) bins;
 
@@ -39,3 +44,106 @@ void goertzel_input(goertzel_t *goertzel, float input) {
 float goertzel_output(goertzel_t *goertzel) {
     return sqrt(goertzel->s2 * goertzel->s2 + goertzel->s1 * goertzel->s1 - goertzel->coef * goertzel->s1 * goertzel->s2);
 }
+
+void goertzel_bank_init(goertzel_bank_t *bank, uint16_t count) {
+    if (count > GOERTZEL_BANK_MAX) {
+        count = GOERTZEL_BANK_MAX;
+    }
+
+    memset(bank, 0, sizeof(*bank));
+    bank->count = count;
+}
+
+void goertzel_bank_bin_init(goertzel_bank_t *bank, uint16_t n, uint16_t bin, uint16_t bins) {
+    if (n >= GOERTZEL_BANK_MAX) {
+        return;
+    }
+
+    float w = (float) (2.0 * M_PI * bin) / (float) bins;
+
+    bank->coef[n] = 2.0f * cos(w);
+    bank->s1[n] = 0;
+    bank->s2[n] = 0;
+}
+
+void goertzel_bank_freq_init(goertzel_bank_t *bank, uint16_t n, uint32_t freq, uint32_t rate, uint16_t bins) {
+    if (n >= GOERTZEL_BANK_MAX) {
+        return;
+    }
+
+    uint16_t bin = freq * bins / rate;
+
+    goertzel_bank_bin_init(bank, n, bin, bins);
+}
+
+void goertzel_bank_reset(goertzel_bank_t *bank) {
+    memset(bank->s1, 0, sizeof(bank->s1));
+    memset(bank->s2, 0, sizeof(bank->s2));
+}
+
+/*
+ * One pass over the samples, each pair of them updates all tones by four.
+ * Tones are independent, so their multiply-adds hide each other's latency,
+ * and the state is loaded and stored once per pair. Unused tail tones have
+ * zero coefficients and cost nothing but the padding
+ */
+
+#ifdef __ARM_NEON
+
+static void input_pair(const float *coef, float *s1, float *s2, uint16_t count, float x0, float x1) {
+    float32x4_t x0_4 = vdupq_n_f32(x0);
+    float32x4_t x1_4 = vdupq_n_f32(x1);
+
+    for (uint16_t k = 0; k < count; k += 4) {
+        float32x4_t c = vld1q_f32(coef + k);
+        float32x4_t a = vld1q_f32(s1 + k);
+        float32x4_t b = vld1q_f32(s2 + k);
+        float32x4_t s0 = vmlaq_f32(vsubq_f32(x0_4, b), c, a);
+
+        vst1q_f32(s2 + k, s0);
+        vst1q_f32(s1 + k, vmlaq_f32(vsubq_f32(x1_4, a), c, s0));
+    }
+}
+
+#else
+
+static void input_pair(const float *coef, float *s1, float *s2, uint16_t count, float x0, float x1) {
+    for (uint16_t k = 0; k < count; k++) {
+        float a = s1[k];
+        float s0 = coef[k] * a - s2[k] + x0;
+
+        s2[k] = s0;
+        s1[k] = coef[k] * s0 - a + x1;
+    }
+}
+
+#endif
+
+void goertzel_bank_input(goertzel_bank_t *bank, const float *input, size_t len) {
+    uint16_t    count = (bank->count + 3) & ~3;
+    size_t      i;
+
+    for (i = 0; i + 1 < len; i += 2) {
+        input_pair(bank->coef, bank->s1, bank->s2, count, input[i], input[i + 1]);
+    }
+
+    /* Odd tail */
+
+    for (; i < len; i++) {
+        for (uint16_t k = 0; k < count; k++) {
+            float s0 = bank->coef[k] * bank->s1[k] - bank->s2[k] + input[i];
+
+            bank->s2[k] = bank->s1[k];
+            bank->s1[k] = s0;
+        }
+    }
+}
+
+void goertzel_bank_output(goertzel_bank_t *bank, float *out) {
+    for (uint16_t k = 0; k < bank->count; k++) {
+        float s1 = bank->s1[k];
+        float s2 = bank->s2[k];
+
+        out[k] = sqrtf(s2 * s2 + s1 * s1 - bank->coef[k] * s1 * s2);
+    }
+}
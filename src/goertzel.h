@@ -8,6 +8,11 @@
 
 #pragma once
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
 #include <stdint.h>
 
 typedef struct {
@@ -22,3 +27,37 @@ void goertzel_bin_init(goertzel_t *goertzel, uint16_t bin, uint16_t bins);
 void goertzel_input(goertzel_t *goertzel, float input);
 float goertzel_output(goertzel_t *goertzel);
 void goertzel_reset(goertzel_t *goertzel);
+
+/*
+ * Bank of tones over the same block. Each sample is read once and updates
+ * all filters, four at once with NEON
+ */
+
+#define GOERTZEL_BANK_MAX   64
+
+typedef struct {
+    uint16_t    count;
+    float       coef[GOERTZEL_BANK_MAX] __attribute__((aligned(16)));
+    float       s1[GOERTZEL_BANK_MAX] __attribute__((aligned(16)));
+    float       s2[GOERTZEL_BANK_MAX] __attribute__((aligned(16)));
+} goertzel_bank_t;
+
+void goertzel_bank_init(goertzel_bank_t *bank, uint16_t count);
+
+/**
+ * Tone n from GOERTZEL_BANK_MAX on is ignored
+ */
+void goertzel_bank_freq_init(goertzel_bank_t *bank, uint16_t n, uint32_t freq, uint32_t rate, uint16_t bins);
+void goertzel_bank_bin_init(goertzel_bank_t *bank, uint16_t n, uint16_t bin, uint16_t bins);
+
+void goertzel_bank_input(goertzel_bank_t *bank, const float *input, size_t len);
+
+/**
+ * Magnitudes of all tones, same as goertzel_output()
+ */
+void goertzel_bank_output(goertzel_bank_t *bank, float *out);
+void goertzel_bank_reset(goertzel_bank_t *bank);
+
+#ifdef __cplusplus
+}
+#endif
@@ -45,10 +45,17 @@ static void data_receive() {
             }
             status = GPS_STATUS_WORKING;
             if (dialog_gps->run) {
-                struct gps_data_t *msg = malloc(sizeof(struct gps_data_t));
-
-                memcpy(msg, &gpsdata, sizeof(*msg));
-                event_send(dialog_gps->obj, EVENT_GPS, msg);
+                event_gps_t msg = {
+                    .set = gpsdata.set,
+                    .satellites_visible = gpsdata.satellites_visible,
+                    .satellites_used = gpsdata.satellites_used,
+                    .mode = gpsdata.fix.mode,
+                    .time = gpsdata.fix.time,
+                    .latitude = gpsdata.fix.latitude,
+                    .longitude = gpsdata.fix.longitude
+                };
+
+                event_send(dialog_gps->obj, EVENT_GPS, &msg, sizeof(msg));
             }
         }
     }
@@ -17,6 +17,18 @@ typedef enum {
     GPS_STATUS_EXITED,
 } gps_status_t;
 
+/* EVENT_GPS param, only what the dialog shows */
+
+typedef struct {
+    gps_mask_t  set;
+    int         satellites_visible;
+    int         satellites_used;
+    int         mode;
+    timespec_t  time;
+    double      latitude;
+    double      longitude;
+} event_gps_t;
+
 void gps_init();
 
 gps_status_t gps_status();
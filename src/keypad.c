@@ -33,6 +33,9 @@ static void keypad_input_read(lv_indev_drv_t *drv, lv_indev_data_t *data) {
     keypad_t            *keypad = (keypad_t*) drv->user_data;
 
     if (read(keypad->fd, &in, sizeof(struct input_event)) > 0) {
+        /* Drain the queued events in one timer run */
+        data->continue_reading = 1;
+
         if (in.type == EV_KEY) {
             backlight_tick();
 
@@ -50,6 +53,7 @@ static void keypad_input_read(lv_indev_drv_t *drv, lv_indev_data_t *data) {
 
                 case BTN_TRIGGER_HAPPY27:
                     mfk->pressed = (in.value != 0);
+                    lv_timer_ready(mfk->indev->driver->read_timer);
                     return;
 
                 /* Front side */
@@ -11,7 +11,9 @@
 #include <unistd.h>
 #include <pthread.h>
 #include <time.h>
+#include <sys/epoll.h>
 #include <sys/time.h>
+#include <sys/timerfd.h>
 
 #include "main.h"
 #include "main_screen.h"
@@ -29,6 +31,7 @@
 #include "pannel.h"
 #include "cat.h"
 #include "rtty.h"
+#include "psk.h"
 #include "backlight.h"
 #include "events.h"
 #include "gps.h"
@@ -38,8 +41,16 @@
 #include "scheduler.h"
 #include "wifi.h"
 #include "usb_devices.h"
+#include "recorder.h"
+#include "audio_source.h"
+#include "bench.h"
+#include "wakeup.h"
+#include "boot.h"
+#include "voice.h"
 
 #define DISP_BUF_SIZE (800 * 480 * 4)
+#define MAX_EPOLL_EVENTS 8
+#define INPUT_POLL_PERIOD 100   /* ms, evdev indevs are read at once on epoll wakeup */
 
 rotary_t                    *vol;
 encoder_t                   *mfk;
@@ -49,22 +60,133 @@ static lv_color_t           buf[DISP_BUF_SIZE];
 static lv_disp_draw_buf_t   disp_buf;
 static lv_disp_drv_t        disp_drv;
 
+static int                  epoll_fd;
+static int                  timer_fd;
+
 void * tick_thread (void *args);
 
-int main(void) {
-    lv_init();
-    // lv_png_init();
+static void loop_add_fd(int fd, uint32_t events) {
+    struct epoll_event ev = { .events = events, .data.fd = fd };
 
-    fbdev_init();
-    audio_init();
-    event_init();
-    usb_devices_monitor_init();
+    if (fd >= 0 && epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        LV_LOG_ERROR("Can't add fd %i to epoll", fd);
+    }
+}
+
+/**
+ * Evdev fds are edge triggered, drivers drain them on the next indev read.
+ * Periodic read is kept only for long press and rotary steps
+ */
+static void loop_add_input(int fd, lv_indev_t *indev) {
+    loop_add_fd(fd, EPOLLIN | EPOLLET);
+    lv_timer_set_period(indev->driver->read_timer, INPUT_POLL_PERIOD);
+}
+
+static void loop_init() {
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+    wakeup_init();
+    loop_add_fd(wakeup_fd(), EPOLLIN);
+    loop_add_fd(timer_fd, EPOLLIN);
+}
+
+static void loop_arm_timer(uint32_t ms) {
+    struct itimerspec spec = { 0 };
+
+    if (ms != LV_NO_TIMER_READY) {
+        /* Zero value disarms the timer, so at least 1 ns */
+        spec.it_value.tv_sec = ms / 1000;
+        spec.it_value.tv_nsec = (ms % 1000) * 1000000L + 1;
+    }
+
+    timerfd_settime(timer_fd, 0, &spec, NULL);
+}
+
+/**
+ * Sleep until input, an item in the UI queues or the next LVGL timer
+ */
+static void loop_wait(uint32_t ms) {
+    struct epoll_event  events[MAX_EPOLL_EVENTS];
+    bool                input = false;
+
+    loop_arm_timer(ms);
+
+    int n = epoll_wait(epoll_fd, events, MAX_EPOLL_EVENTS, -1);
+
+    for (int i = 0; i < n; i++) {
+        int fd = events[i].data.fd;
+
+        if (fd == timer_fd) {
+            uint64_t expired;
+            ssize_t  res = read(timer_fd, &expired, sizeof(expired));
+
+            (void) res;
+        } else if (fd != wakeup_fd()) {
+            input = true;
+        }
+    }
+
+    if (input) {
+        lv_indev_t *indev = NULL;
+
+        while ((indev = lv_indev_get_next(indev))) {
+            lv_timer_ready(indev->driver->read_timer);
+        }
+    }
+}
+
+static bool                 bench;
+static uint64_t             boot_time;
+static lv_obj_t             *main_obj;
+
+static void init_audio() {
+    if (!bench) {
+        audio_init();
+    }
+}
+
+static void init_volume() {
+    audio_set_play_vol(params.play_gain_db_f.x);
+    audio_set_rec_vol(params.rec_gain_db_f.x);
+}
+
+/* Bench exits from the screen task, the radio side is not started for it */
+
+static void init_qso_log() {
+    if (bench) {
+        return;
+    }
+
+    if (!qso_log_init()) {
+        LV_LOG_ERROR("Can't init QSO log");
+    }
+    qso_log_import_adif("/mnt/incoming_log.adi");
+}
+
+static void init_voice() {
+    if (!bench) {
+        voice_init();
+    }
+}
+
+static void init_wifi() {
+    if (!bench) {
+        wifi_init();
+    }
+}
+
+static void init_display() {
+    if (!bench) {
+        fbdev_init();
+    }
 
     lv_disp_draw_buf_init(&disp_buf, buf, NULL, DISP_BUF_SIZE);
     lv_disp_drv_init(&disp_drv);
 
     disp_drv.draw_buf   = &disp_buf;
-    disp_drv.flush_cb   = fbdev_flush;
+    disp_drv.flush_cb   = bench ? bench_flush : fbdev_flush;
+    disp_drv.monitor_cb = bench ? bench_monitor : NULL;
     disp_drv.hor_res    = 480;
     disp_drv.ver_res    = 800;
     disp_drv.sw_rotate  = 1;
@@ -74,17 +196,35 @@ int main(void) {
 
     lv_disp_set_bg_color(lv_disp_get_default(), lv_color_black());
     lv_disp_set_bg_opa(lv_disp_get_default(), LV_OPA_COVER);
+}
 
+static void init_input() {
+    usb_devices_monitor_init();
     keyboard_init();
 
-    keypad_init("/dev/input/event0");
-    keypad_init("/dev/input/event4");
+    if (bench) {
+        static rotary_t     bench_vol, bench_mfk_inner;
+        static encoder_t    bench_mfk;
+
+        vol = &bench_vol;
+        mfk = &bench_mfk;
+        mfk_inner = &bench_mfk_inner;
+    } else {
+        keypad_t *keypad = keypad_init("/dev/input/event0");
+        keypad_t *keypad_inner = keypad_init("/dev/input/event4");
+        rotary_t *main_rotary = rotary_init("/dev/input/event1");
 
-    rotary_init("/dev/input/event1");
+        vol = rotary_init("/dev/input/event2");
+        mfk = encoder_init("/dev/input/event3");
+        mfk_inner = rotary_init("/dev/input/event4");
 
-    vol = rotary_init("/dev/input/event2");
-    mfk = encoder_init("/dev/input/event3");
-    mfk_inner = rotary_init("/dev/input/event4");
+        if (keypad) loop_add_input(keypad->fd, keypad->indev);
+        if (keypad_inner) loop_add_input(keypad_inner->fd, keypad_inner->indev);
+        if (main_rotary) loop_add_input(main_rotary->fd, main_rotary->indev);
+        if (vol) loop_add_input(vol->fd, vol->indev);
+        if (mfk) loop_add_input(mfk->fd, mfk->indev);
+        if (mfk_inner) loop_add_input(mfk_inner->fd, mfk_inner->indev);
+    }
 
     vol->left[ROT_VOL_EDIT_MODE] = KEY_VOL_LEFT_EDIT;
     vol->right[ROT_VOL_EDIT_MODE] = KEY_VOL_RIGHT_EDIT;
@@ -99,55 +239,132 @@ int main(void) {
     // EQ navigation - left -> down key (decrease)
     mfk_inner->left[ROT_MFK_INNER_INVERSE_MODE] = LV_KEY_DOWN;
     mfk_inner->right[ROT_MFK_INNER_INVERSE_MODE] = LV_KEY_UP;
+}
 
-    params_init();
-    audio_set_play_vol(params.play_gain_db_f.x);
-    audio_set_rec_vol(params.rec_gain_db_f.x);
+static void init_styles() {
     mfk_change_mode(0);
     vol_change_mode(0);
     styles_init(params.theme.x);
+}
 
-    dsp_init();
-    lv_obj_t *main_obj = main_screen();
+static void init_screen() {
+    main_obj = main_screen();
+
+    if (bench) {
+        bench_run(main_obj);
+    }
+
+#if 0
+    lv_obj_set_style_bg_opa(lv_scr_act(), LV_OPA_0, 0);
+    lv_scr_load_anim(main_obj, LV_SCR_LOAD_ANIM_FADE_IN, 250, 0, false);
+#else
+    lv_scr_load(main_obj);
+#endif
+
+    /* Don't wait for the radio and the main loop */
+
+    lv_refr_now(NULL);
+    LV_LOG_USER("First frame in %llu ms", (unsigned long long) (get_time() - boot_time));
+}
+
+static void init_radio() {
+    if (bench) {
+        return;
+    }
 
-    cw_init();
-    rtty_init();
     radio_init(
         &main_screen_notify_tx,
         &main_screen_notify_rx
     );
-    wifi_power_setup();
+}
+
+static void init_decoders() {
+    recorder_init();
+    cw_init();
+    rtty_init();
+    psk_init();
+}
+
+static void init_control() {
     backlight_init();
     cat_init();
     // pannel_visible();
-    gps_init();
-    if (!qso_log_init()) {
-        LV_LOG_ERROR("Can't init QSO log");
-    }
-    qso_log_import_adif("/mnt/incoming_log.adi");
+}
+
+enum {
+    TASK_AUDIO = 0,
+    TASK_PARAMS,
+    TASK_VOLUME,
+    TASK_QSO_LOG,
+    TASK_DISPLAY,
+    TASK_INPUT,
+    TASK_STYLES,
+    TASK_DSP,
+    TASK_SCREEN,
+    TASK_RADIO,
+    TASK_DECODERS,
+    TASK_GPS,
+    TASK_AUDIO_SOURCE,
+    TASK_CONTROL,
+    TASK_VOICE,
+    TASK_WIFI,
+};
+
+/*
+ * Slow tasks (PulseAudio, SQLite, RHVoice, NetworkManager) are off the main
+ * thread. Workers take the ready tasks in the table order, so the background
+ * ones are last to keep the critical path going. The radio subscribes to the
+ * subjects, which the main thread tasks set at the same time, so it stays on
+ * the main thread. SQLite is configured by params, before any other database
+ */
+
+static boot_task_t boot_tasks[] = {
+    [TASK_AUDIO]        = { "audio",        init_audio,         BOOT_WORKER,        0 },
+    [TASK_PARAMS]       = { "params",       params_init,        BOOT_WORKER,        0 },
+    [TASK_VOLUME]       = { "volume",       init_volume,        BOOT_WORKER,        BOOT_DEP(TASK_AUDIO) | BOOT_DEP(TASK_PARAMS) },
+    [TASK_QSO_LOG]      = { "qso_log",      init_qso_log,       BOOT_WORKER,        BOOT_DEP(TASK_PARAMS) },
+    [TASK_DISPLAY]      = { "display",      init_display,       BOOT_MAIN,          0 },
+    [TASK_INPUT]        = { "input",        init_input,         BOOT_MAIN,          BOOT_DEP(TASK_DISPLAY) },
+    [TASK_STYLES]       = { "styles",       init_styles,        BOOT_MAIN,          BOOT_DEP(TASK_PARAMS) | BOOT_DEP(TASK_INPUT) },
+    [TASK_DSP]          = { "dsp",          dsp_init,           BOOT_MAIN,          BOOT_DEP(TASK_PARAMS) },
+    [TASK_SCREEN]       = { "screen",       init_screen,        BOOT_MAIN,          BOOT_DEP(TASK_STYLES) | BOOT_DEP(TASK_DSP) },
+    [TASK_RADIO]        = { "radio",        init_radio,         BOOT_MAIN,          BOOT_DEP(TASK_SCREEN) },
+    [TASK_DECODERS]     = { "decoders",     init_decoders,      BOOT_MAIN,          BOOT_DEP(TASK_SCREEN) },
+    [TASK_GPS]          = { "gps",          gps_init,           BOOT_MAIN,          BOOT_DEP(TASK_INPUT) },
+    [TASK_AUDIO_SOURCE] = { "audio_source", audio_source_init,  BOOT_MAIN,          BOOT_DEP(TASK_DSP) },
+    [TASK_CONTROL]      = { "control",      init_control,       BOOT_MAIN,          BOOT_DEP(TASK_RADIO) },
+    [TASK_VOICE]        = { "voice",        init_voice,         BOOT_BACKGROUND,    0 },
+    [TASK_WIFI]         = { "wifi",         init_wifi,          BOOT_BACKGROUND,    0 },
+};
+
+int main(void) {
+    boot_time = get_time();
+    bench = bench_init();
+
+    lv_init();
+    // lv_png_init();
+
+    loop_init();
+    event_init();
+
+    /* Delayed observers are called by this loop, also the ones made by boot workers */
+    observer_delayed_pin_thread();
+
+    boot_run(boot_tasks, sizeof(boot_tasks) / sizeof(boot_tasks[0]));
 
     pthread_t thread;
     pthread_create(&thread, NULL, tick_thread, NULL);
     pthread_detach(thread);
 
-#if 0
-    lv_obj_set_style_bg_opa(lv_scr_act(), LV_OPA_0, 0);
-    lv_scr_load_anim(main_obj, LV_SCR_LOAD_ANIM_FADE_IN, 250, 0, false);
-#else
-    lv_scr_load(main_obj);
-#endif
-
-    int64_t next_loop_time, sleep_time, loop_start_time;
     while (1) {
-        loop_start_time = get_time();
+        wakeup_clear();
         observer_delayed_notify_all();
         event_obj_check();
         scheduler_work();
-        next_loop_time = lv_timer_handler() + loop_start_time;
-        sleep_time = next_loop_time - get_time();
-        if (sleep_time > 0) {
-            usleep(sleep_time * 1000);
-        }
+
+        uint32_t delay = lv_timer_handler();
+
+        loop_wait(delay);
     }
     return 0;
 }
@@ -28,6 +28,7 @@
 #include "main.h"
 #include "pannel.h"
 #include "rtty.h"
+#include "psk.h"
 #include "screenshot.h"
 #include "keyboard.h"
 #include "dialog.h"
@@ -43,6 +44,7 @@
 #include "dialog_callsign.h"
 #include "dialog_wifi.h"
 #include "dialog_eq.h"
+#include "dialog_cw_skimmer.h"
 #include "backlight.h"
 #include "buttons.h"
 #include "recorder.h"
@@ -115,6 +117,7 @@ static void apps_disable() {
     dialog_destruct();
 
     rtty_set_state(RTTY_OFF);
+    psk_set_state(PSK_OFF);
     pannel_visible();
 }
 
@@ -129,6 +132,13 @@ void main_screen_start_app(press_action_t app_action) {
             voice_say_text_fmt("Teletype window");
             break;
 
+        case ACTION_APP_PSK:
+            buttons_load_page(&buttons_page_psk);
+            psk_set_state(PSK_RX);
+            pannel_visible();
+            voice_say_text_fmt("PSK window");
+            break;
+
         case ACTION_APP_SETTINGS:
             dialog_construct(dialog_settings, obj);
             voice_say_text_fmt("Settings window");
@@ -164,6 +174,11 @@ void main_screen_start_app(press_action_t app_action) {
             voice_say_text_fmt("EQ window");
             break;
 
+        case ACTION_APP_CW_SKIMMER:
+            dialog_construct(dialog_cw_skimmer, obj);
+            voice_say_text_fmt("CW skimmer window");
+            break;
+
         default:
             break;
     }
@@ -230,6 +245,8 @@ void main_screen_action(press_action_t action) {
         case ACTION_APP_SETTINGS:
         case ACTION_APP_RECORDER:
         case ACTION_APP_WIFI:
+        case ACTION_APP_CW_SKIMMER:
+        case ACTION_APP_PSK:
             main_screen_start_app(action);
             break;
 
@@ -411,7 +428,7 @@ static void main_screen_keypad_cb(lv_event_t * e) {
                 if (!band_lock) {
                     cfg_band_load_next(true);
                 }
-                dialog_send(EVENT_BAND_UP, NULL);
+                dialog_send(EVENT_BAND_UP, NULL, 0);
             }
             break;
 
@@ -420,7 +437,7 @@ static void main_screen_keypad_cb(lv_event_t * e) {
                 if (!band_lock) {
                     cfg_band_load_next(false);
                 }
-                dialog_send(EVENT_BAND_DOWN, NULL);
+                dialog_send(EVENT_BAND_DOWN, NULL, 0);
             }
             break;
 
@@ -738,7 +755,7 @@ static void main_screen_hkey_cb(lv_event_t * e) {
                 if (!band_lock) {
                     cfg_band_load_next(true);
                 }
-                dialog_send(EVENT_BAND_UP, NULL);
+                dialog_send(EVENT_BAND_UP, NULL, 0);
             }
             break;
 
@@ -751,7 +768,7 @@ static void main_screen_hkey_cb(lv_event_t * e) {
                 if (!band_lock) {
                     cfg_band_load_next(false);
                 }
-                dialog_send(EVENT_BAND_DOWN, NULL);
+                dialog_send(EVENT_BAND_DOWN, NULL, 0);
             }
             break;
 
@@ -784,7 +801,7 @@ static void main_screen_radio_cb(lv_event_t * e) {
     lv_event_send(tx_info, code, NULL);
     lv_event_send(spectrum, code, NULL);
 
-    dialog_send(code, NULL);
+    dialog_send(code, NULL, 0);
 }
 
 static void main_screen_update_cb(lv_event_t * e) {
@@ -828,7 +845,6 @@ static void main_screen_rotary_cb(lv_event_t * e) {
 
     freq_shift(*diff);
     dialog_rotary(*diff);
-    free(diff);
 }
 
 static void spectrum_key_cb(lv_event_t * e) {
@@ -941,14 +957,14 @@ static void spectrum_key_cb(lv_event_t * e) {
             if (!band_lock) {
                 cfg_band_load_next(true);
             }
-            dialog_send(EVENT_BAND_UP, NULL);
+            dialog_send(EVENT_BAND_UP, NULL, 0);
             break;
 
         case KEYBOARD_PGDN:
             if (!band_lock) {
                 cfg_band_load_next(false);
             }
-            dialog_send(EVENT_BAND_DOWN, NULL);
+            dialog_send(EVENT_BAND_DOWN, NULL, 0);
             break;
 
         case HKEY_FINP:
@@ -1012,7 +1028,7 @@ void main_screen_lock_ab(bool lock) {
 
 void main_screen_set_freq(uint64_t freq) {
     subject_set_int(cfg_cur.fg_freq, freq);
-    event_send(lv_scr_act(), EVENT_SCREEN_UPDATE, NULL);
+    event_send(lv_scr_act(), EVENT_SCREEN_UPDATE, NULL, 0);
 }
 
 lv_obj_t * main_screen() {
@@ -1109,12 +1125,12 @@ lv_obj_t * main_screen() {
 
 void main_screen_notify_tx()
 {
-    event_send(obj, EVENT_RADIO_TX, NULL);
+    event_send(obj, EVENT_RADIO_TX, NULL, 0);
 }
 
 void main_screen_notify_rx()
 {
-    event_send(obj, EVENT_RADIO_RX, NULL);
+    event_send(obj, EVENT_RADIO_RX, NULL, 0);
 }
 
 static void on_fg_freq_change(Subject *subj, void *user_data) {
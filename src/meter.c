@@ -188,7 +188,7 @@ void meter_update(int16_t db, float beta) {
         meter_peak -= (now - meter_peak_time - METER_PEAK_HOLD) * METER_PEAK_SPEED / 1000;
     }
     meter_db = meter_db * beta + db * (1.0f - beta);
-    event_send(obj, LV_EVENT_REFRESH, NULL);
+    event_send(obj, LV_EVENT_REFRESH, NULL, 0);
 }
 
 void meter_set_noise(float db) {
@@ -23,6 +23,7 @@ extern "C" {
     #include "msg.h"
     #include "radio.h"
     #include "rtty.h"
+    #include "psk.h"
     #include "info.h"
     #include "backlight.h"
     #include "cw_tune_ui.h"
@@ -342,6 +343,43 @@ void mfk_update(int16_t diff, bool voice) {
             }
             break;
 
+        case MFK_KEY_FARNSWORTH:
+            i = subject_get_int(cfg.key_farnsworth.val);
+            if (diff) {
+                i = (i == 0 && diff > 0) ? 5 : clip(i + diff, 4, 50);
+                if (i < 5) {
+                    i = 0;
+                }
+                subject_set_int(cfg.key_farnsworth.val, i);
+            }
+            if (i) {
+                msg_update_text_fmt("#%3X Farnsworth: %i wpm", color, i);
+            } else {
+                msg_update_text_fmt("#%3X Farnsworth: Off", color);
+            }
+
+            if (diff) {
+                voice_say_int("CW Farnsworth speed", i);
+            } else if (voice) {
+                voice_say_text_fmt("CW Farnsworth speed");
+            }
+            break;
+
+        case MFK_KEY_WEIGHT:
+            i = subject_get_int(cfg.key_weight.val);
+            if (diff) {
+                i = clip(i + diff, 25, 75);
+                subject_set_int(cfg.key_weight.val, i);
+            }
+            msg_update_text_fmt("#%3X Key weight: %i%%", color, i);
+
+            if (diff) {
+                voice_say_int("CW key weight", i);
+            } else if (voice) {
+                voice_say_text_fmt("CW key weight");
+            }
+            break;
+
         case MFK_CHARGER:
             i = radio_change_charger(diff);
             str = params_charger_str_get((radio_charger_t)i);
@@ -723,10 +761,19 @@ void mfk_update(int16_t diff, bool voice) {
 
         case MFK_RTTY_RATE:
             f = rtty_change_rate(diff);
-            msg_update_text_fmt("#%3X RTTY rate: %.2f", color, f);
+
+            if (f == 0.0f) {
+                msg_update_text_fmt("#%3X RTTY rate: Auto", color);
+            } else {
+                msg_update_text_fmt("#%3X RTTY rate: %.2f", color, f);
+            }
 
             if (diff) {
-                voice_say_float2("Teletype rate", f);
+                if (f == 0.0f) {
+                    voice_say_text_fmt("Teletype rate auto");
+                } else {
+                    voice_say_float2("Teletype rate", f);
+                }
             } else if (voice) {
                 voice_say_text_fmt("Teletype rate");
             }
@@ -765,6 +812,39 @@ void mfk_update(int16_t diff, bool voice) {
             }
             break;
 
+        case MFK_PSK_RATE:
+            f = psk_change_rate(diff);
+            msg_update_text_fmt("#%3X PSK rate: %.2f", color, f);
+
+            if (diff) {
+                voice_say_float2("PSK rate", f);
+            } else if (voice) {
+                voice_say_text_fmt("PSK rate");
+            }
+            break;
+
+        case MFK_PSK_CENTER:
+            i = psk_change_center(diff);
+            msg_update_text_fmt("#%3X PSK center: %i Hz", color, i);
+
+            if (diff) {
+                voice_say_int("PSK frequency center", i);
+            } else if (voice) {
+                voice_say_text_fmt("PSK frequency center");
+            }
+            break;
+
+        case MFK_PSK_MULTI:
+            b = psk_change_multi(diff);
+            msg_update_text_fmt("#%3X PSK multi channel: %s", color, b ? "On" : "Off");
+
+            if (diff) {
+                voice_say_bool("PSK multi channel", b);
+            } else if (voice) {
+                voice_say_text_fmt("PSK multi channel switcher");
+            }
+            break;
+
         default:
             break;
     }
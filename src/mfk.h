@@ -65,6 +65,9 @@ typedef enum {
     MFK_PRE,
     MFK_COMP,
 
+    MFK_KEY_FARNSWORTH,
+    MFK_KEY_WEIGHT,
+
     MFK_LAST,
 
     /* APPs */
@@ -73,6 +76,10 @@ typedef enum {
     MFK_RTTY_SHIFT,
     MFK_RTTY_CENTER,
     MFK_RTTY_REVERSE,
+
+    MFK_PSK_RATE,
+    MFK_PSK_CENTER,
+    MFK_PSK_MULTI,
 } mfk_mode_t;
 
 typedef enum {
@@ -105,23 +105,25 @@ lv_obj_t * msg_init(lv_obj_t *parent) {
 void msg_update_text_fmt(const char * fmt, ...) {
     va_list args;
 
-    delayed_message_t * msg = (delayed_message_t *) malloc(sizeof(delayed_message_t));
-    msg->type = MSG_UPDATE;
+    delayed_message_t msg;
+
+    msg.type = MSG_UPDATE;
     va_start(args, fmt);
-    vsnprintf(msg->text, sizeof(msg->text), fmt, args);
+    vsnprintf(msg.text, sizeof(msg.text), fmt, args);
     va_end(args);
 
-    event_send(obj, EVENT_MSG_UPDATE, (void*)msg);
+    event_send(obj, EVENT_MSG_UPDATE, &msg, sizeof(msg));
 }
 
 void msg_schedule_text_fmt(const char * fmt, ...) {
     va_list args;
 
-    delayed_message_t * msg = (delayed_message_t *) malloc(sizeof(delayed_message_t));
-    msg->type = MSG_SCHEDULE;
+    delayed_message_t msg;
+
+    msg.type = MSG_SCHEDULE;
     va_start(args, fmt);
-    vsnprintf(msg->text, sizeof(msg->text), fmt, args);
+    vsnprintf(msg.text, sizeof(msg.text), fmt, args);
     va_end(args);
 
-    event_send(obj, EVENT_MSG_UPDATE, (void*)msg);
+    event_send(obj, EVENT_MSG_UPDATE, &msg, sizeof(msg));
 }
@@ -15,6 +15,7 @@
 #include "radio.h"
 #include "params/params.h"
 #include "rtty.h"
+#include "psk.h"
 
 static lv_obj_t     *obj;
 static char         buf[1024];
@@ -22,6 +23,27 @@ static char         tmp_buf[1024];
 static char         *last_line;
 
 static void update_visibility(Subject *subj, void *user_data);
+static void pannel_update_cb(const char *text);
+
+static void add_text(const char *text) {
+    for (const char *c = text; *c; c++) {
+        char str[2] = {*c, 0};
+
+        pannel_update_cb(str);
+    }
+}
+
+static void text_cb(lv_timer_t *t) {
+    char text[64];
+
+    if (rtty_get_text(text, sizeof(text))) {
+        add_text(text);
+    }
+
+    if (psk_get_text(text, sizeof(text))) {
+        add_text(text);
+    }
+}
 
 static void check_lines() {
     char        *second_line = NULL;
@@ -92,6 +114,8 @@ lv_obj_t * pannel_init(lv_obj_t *parent) {
 
     subject_add_delayed_observer(cfg_cur.mode, update_visibility, NULL);
     subject_add_delayed_observer_and_call(cfg.cw_decoder.val, update_visibility, NULL);
+
+    lv_timer_create(text_cb, 50, NULL);
     return obj;
 }
 
@@ -117,7 +141,7 @@ void pannel_visible() {
         case x6200_mode_lsb:
         case x6200_mode_usb_dig:
         case x6200_mode_lsb_dig:
-            on = rtty_get_state() != RTTY_OFF;
+            on = rtty_get_state() != RTTY_OFF || psk_get_state() != PSK_OFF;
             break;
     }
 
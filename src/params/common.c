@@ -37,3 +37,7 @@ bool params_ready_to_save() {
     }
     return false;
 }
+
+void params_saved() {
+    params_mod_time = 0;
+}
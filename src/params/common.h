@@ -16,3 +16,8 @@ extern pthread_mutex_t  params_mux;
 void params_lock();
 void params_unlock(bool *dirty);
 bool params_ready_to_save();
+
+/**
+ * Called with params_mux locked after an explicit save, cancels the periodic one
+ */
+void params_saved();
@@ -18,6 +18,8 @@
 sqlite3                 *db = NULL;
 
 static sqlite3_stmt     *insert_stmt;
+static pthread_mutex_t  tx_mutex = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t         tx_writes;
 
 
 static void errorLogCallback(void *pArg, int iErrCode, const char *zMsg){
@@ -35,6 +37,11 @@ bool database_init() {
         return false;
     }
 
+    /* Commit doesn't wait for the SD card, WAL is synced on checkpoint */
+
+    sql_query_exec("PRAGMA journal_mode=WAL");
+    sql_query_exec("PRAGMA synchronous=NORMAL");
+
     rc = migrations_apply();
     if (rc != 0) {
         return false;
@@ -63,6 +70,32 @@ bool sql_query_exec(const char *sql) {
 }
 
 
+bool database_begin() {
+    pthread_mutex_lock(&tx_mutex);
+
+    if (!sql_query_exec("BEGIN")) {
+        pthread_mutex_unlock(&tx_mutex);
+        return false;
+    }
+    tx_writes = 0;
+    return true;
+}
+
+uint32_t database_writes() {
+    return tx_writes;
+}
+
+void database_commit() {
+    sql_query_exec("COMMIT");
+    pthread_mutex_unlock(&tx_mutex);
+}
+
+void database_sync() {
+    pthread_mutex_lock(&tx_mutex);
+    sql_query_exec("PRAGMA wal_checkpoint(TRUNCATE)");
+    pthread_mutex_unlock(&tx_mutex);
+}
+
 void params_write_int(const char *name, int data, bool *dirty) {
     sqlite3_bind_text(insert_stmt, 1, name, strlen(name), 0);
     sqlite3_bind_int(insert_stmt, 2, data);
@@ -70,6 +103,7 @@ void params_write_int(const char *name, int data, bool *dirty) {
     sqlite3_reset(insert_stmt);
     sqlite3_clear_bindings(insert_stmt);
 
+    tx_writes++;
     *dirty = false;
 }
 
@@ -80,6 +114,7 @@ void params_write_int64(const char *name, uint64_t data, bool *dirty) {
     sqlite3_reset(insert_stmt);
     sqlite3_clear_bindings(insert_stmt);
 
+    tx_writes++;
     *dirty = false;
 }
 
@@ -90,6 +125,7 @@ void params_write_float(const char *name, float data, bool *dirty) {
     sqlite3_reset(insert_stmt);
     sqlite3_clear_bindings(insert_stmt);
 
+    tx_writes++;
     *dirty = false;
 }
 
@@ -100,5 +136,6 @@ void params_write_text(const char *name, const char *data, bool *dirty) {
     sqlite3_reset(insert_stmt);
     sqlite3_clear_bindings(insert_stmt);
 
+    tx_writes++;
     *dirty = false;
 }
@@ -19,6 +19,22 @@ bool database_init();
 
 bool sql_query_exec(const char *sql);
 
+/**
+ * Transactions of all threads on the shared connection are serialized
+ */
+bool database_begin();
+void database_commit();
+
+/**
+ * Params written since database_begin(), called inside the transaction
+ */
+uint32_t database_writes();
+
+/**
+ * Write WAL to the main file with fsync, before power off
+ */
+void database_sync();
+
 void params_write_int(const char *name, int data, bool *dirty);
 void params_write_int64(const char *name, uint64_t data, bool *dirty);
 void params_write_float(const char *name, float data, bool *dirty);
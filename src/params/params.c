@@ -85,6 +85,10 @@ params_t params = {
     .rtty_bits              = 5,
     .rtty_snr               = 3.0f,
 
+    .psk_center             = 1000,
+    .psk_rate               = 3125,
+    .psk_multi              = false,
+
     .ft8_show_all           = true,
     .ft8_protocol           = FTX_PROTOCOL_FT8,
     .ft8_tx_freq            = { .x = 1325,      .name = "ft8_tx_freq" },
@@ -107,6 +111,8 @@ params_t params = {
     .play_gain_db_f         = { .x = 0.0f, .name = "play_gain_db_f"},
     .rec_gain_db_f          = { .x = 0.0f, .name = "rec_gain_db_f"},
 
+    .rec_pre_time           = { .x = 0,   .min = 0,  .max = 10,                 .name = "rec_pre_time",   .voice = "Pre-record time" },
+
     .voice_mode             = { .x = VOICE_LCD,                                 .name = "voice_mode" },
     .voice_lang             = { .x = 0,   .min = 0,  .max = (VOICES_NUM - 1),   .name = "voice_lang" },
     .voice_rate             = { .x = 100, .min = 50, .max = 150,                .name = "voice_rate",     .voice = "Voice rate" },
@@ -224,6 +230,12 @@ static bool params_load() {
             params.rtty_center = i;
         } else if (strcmp(name, "rtty_reverse") == 0) {
             params.rtty_reverse = i;
+        } else if (strcmp(name, "psk_center") == 0) {
+            params.psk_center = i;
+        } else if (strcmp(name, "psk_rate") == 0) {
+            params.psk_rate = i;
+        } else if (strcmp(name, "psk_multi") == 0) {
+            params.psk_multi = i;
         } else if (strcmp(name, "rit") == 0) {
             params.rit = i;
         } else if (strcmp(name, "xit") == 0) {
@@ -278,6 +290,7 @@ static bool params_load() {
 
         if (params_load_float(&params.play_gain_db_f, name, f)) continue;
         if (params_load_float(&params.rec_gain_db_f, name, f)) continue;
+        if (params_load_uint8(&params.rec_pre_time, name, i)) continue;
 
         if (params_load_bool(&params.mag_freq, name, i)) continue;
         if (params_load_bool(&params.mag_info, name, i)) continue;
@@ -345,7 +358,9 @@ static void params_save_str(params_str_t *var) {
 }
 
 static void params_save() {
-    if (!sql_query_exec("BEGIN")) {
+    uint64_t start = get_time();
+
+    if (!database_begin()) {
         return;
     }
 
@@ -374,6 +389,10 @@ static void params_save() {
     if (params.dirty.rtty_center)           params_write_int("rtty_center", params.rtty_center, &params.dirty.rtty_center);
     if (params.dirty.rtty_reverse)          params_write_int("rtty_reverse", params.rtty_reverse, &params.dirty.rtty_reverse);
 
+    if (params.dirty.psk_center)            params_write_int("psk_center", params.psk_center, &params.dirty.psk_center);
+    if (params.dirty.psk_rate)              params_write_int("psk_rate", params.psk_rate, &params.dirty.psk_rate);
+    if (params.dirty.psk_multi)             params_write_int("psk_multi", params.psk_multi, &params.dirty.psk_multi);
+
     if (params.dirty.rit)                   params_write_int("rit", params.rit, &params.dirty.rit);
     if (params.dirty.xit)                   params_write_int("xit", params.xit, &params.dirty.xit);
 
@@ -409,6 +428,7 @@ static void params_save() {
 
     params_save_float(&params.play_gain_db_f);
     params_save_float(&params.rec_gain_db_f);
+    params_save_uint8(&params.rec_pre_time);
 
     params_save_uint8(&params.voice_mode);
     params_save_uint8(&params.voice_lang);
@@ -439,7 +459,20 @@ static void params_save() {
     params_save_bool(&params.wifi_enabled);
     params_save_uint8(&params.theme);
 
-    sql_query_exec("COMMIT");
+    uint32_t writes = database_writes();
+
+    database_commit();
+
+    if (writes) {
+        LV_LOG_USER("Saved %u params in %u ms", writes, (uint32_t) (get_time() - start));
+    }
+}
+
+void params_flush() {
+    pthread_mutex_lock(&params_mux);
+    params_save();
+    params_saved();
+    pthread_mutex_unlock(&params_mux);
 }
 
 /* * */
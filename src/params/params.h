@@ -48,6 +48,8 @@ typedef enum {
     ACTION_APP_CALLSIGN,
     ACTION_APP_WIFI,
     ACTION_APP_EQ,
+    ACTION_APP_CW_SKIMMER,
+    ACTION_APP_PSK,
 } press_action_t;
 
 typedef enum {
@@ -136,6 +138,12 @@ typedef struct {
     uint8_t             rtty_bits;
     float               rtty_snr;
 
+    /* PSK */
+
+    uint16_t            psk_center;
+    uint16_t            psk_rate;
+    bool                psk_multi;
+
     /* FT8 */
 
     bool                ft8_show_all;
@@ -168,6 +176,10 @@ typedef struct {
     params_float_t      play_gain_db_f;
     params_float_t      rec_gain_db_f;
 
+    /* Recorder */
+
+    params_uint8_t      rec_pre_time;       /* seconds */
+
     /* Voice */
 
     params_uint8_t      voice_mode;
@@ -232,6 +244,10 @@ typedef struct {
         bool    rtty_rate;
         bool    rtty_reverse;
 
+        bool    psk_center;
+        bool    psk_rate;
+        bool    psk_multi;
+
         bool    ft8_show_all;
         bool    ft8_protocol;
         bool    ft8_band;
@@ -256,6 +272,11 @@ extern params_t params;
 
 void params_init();
 
+/**
+ * Save changed params at once, without waiting for the save timeout
+ */
+void params_flush();
+
 void params_bool_set(params_bool_t *var, bool x);
 void params_uint8_set(params_uint8_t *var, uint8_t x);
 void params_uint16_set(params_uint16_t *var, uint16_t x);
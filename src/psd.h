@@ -0,0 +1,134 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+/*
+ * Spectrum helpers without UI dependencies (used by dsp.cpp and DSP benchmarks)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <liquid/liquid.h>
+
+#include "vmath.h"
+
+template <size_t input_size, size_t output_size> class AveragedPSD {
+  private:
+    int8_t                         count;
+    std::array<float, input_size>  psd;
+    std::array<float, input_size>  power;
+    std::array<float, output_size> averaged;
+
+    size_t positions[output_size];
+    float offsets[output_size];
+
+    std::mutex mutex;
+
+    void lerp_averaged() {
+        if (output_size == input_size) {
+            for (size_t i = 0; i < output_size; i++) {
+                averaged[i] = psd[i];
+            }
+        } else {
+            float a, b;
+            for (size_t i = 0; i < output_size; i++) {
+                a = psd[positions[i]];
+                b = psd[positions[i] + 1];
+                averaged[i] = a + (b - a) * offsets[i];
+            }
+        }
+    }
+
+  public:
+    AveragedPSD() {
+        for (size_t i = 0; i < output_size; i++) {
+            float f = (float)i / output_size * input_size;
+            positions[i] = f;
+            offsets[i] = f - positions[i];
+        }
+    }
+
+    void reset() {
+        const std::lock_guard<std::mutex> lock(mutex);
+        count = 0;
+        psd.fill(0.0f);
+    };
+
+    void add_samples(float *samples) {
+        vmath_db_to_power(samples, power.data(), power.size());
+
+        for (size_t i = 0; i < psd.size(); i++)
+        {
+            psd[i] += power[i];
+        }
+        count++;
+    };
+
+    std::array<float, output_size> *get() {
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            if (!count) {
+                return nullptr;
+            }
+            liquid_vectorf_mulscalar(psd.data(), psd.size(), 1.0f / count, psd.data());
+            lerp_averaged();
+        }
+
+        for (size_t i = 0; i < averaged.size(); i++) {
+            averaged[i] += 1e-12f;
+        }
+        vmath_power_to_db(averaged.data(), averaged.data(), averaged.size());
+
+        reset();
+        return &averaged;
+    };
+};
+
+/**
+ * Window of the noise level search: 2700 Hz in bins of the span
+ */
+static inline size_t psd_noise_window(size_t samples, uint32_t fft_width) {
+    return roundf(2700.0f * samples / fft_width);
+}
+
+/**
+ * Minimum of power (dB) summed in a sliding window, dB
+ */
+static inline float psd_window_min(const float *data_buf, size_t size, size_t window) {
+    // dB to power
+    float psd[size];
+    vmath_db_to_power(data_buf, psd, size);
+
+    const size_t psd_sum_size = size - window;
+    float psd_sum[psd_sum_size];
+    for (size_t i = 0; i < psd_sum_size; i++)
+    {
+        psd_sum[i] = 0.0f;
+        for (size_t j = 0; j < window; j++)
+        {
+            psd_sum[i] += psd[i + j];
+        }
+    }
+
+    float min = FLT_MAX;
+    for (size_t i = 0; i < psd_sum_size; i++)
+    {
+        min = std::min(min, psd_sum[i]);
+    }
+
+    min = std::max(min, 1e-20f);
+
+    return 10.0f * log10f(min);
+}
@@ -0,0 +1,235 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "psk.h"
+
+#include "audio.h"
+#include "psk_rx.h"
+#include "params/params.h"
+#include "util.h"
+
+#include "lvgl/lvgl.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEXT_RING       256         /* Decoded chars on the way to UI, power of 2 */
+#define LINE_LEN        24          /* Multi-channel text is shown by lines */
+
+static psk_rx_t         rx = NULL;
+static psk_state_t      state = PSK_OFF;
+
+/* Set by UI, applied by the demodulator thread */
+
+static atomic_bool      ready = false;
+static atomic_bool      reinit = false;
+static atomic_bool      retune = false;
+
+static char             lines[PSK_RX_CHANNELS][LINE_LEN + 1];
+static _Atomic uint16_t freqs[PSK_RX_CHANNELS];
+
+static char             text_ring[TEXT_RING];
+static atomic_size_t    text_head;          /* written by demodulator */
+static atomic_size_t    text_tail;          /* written by UI */
+static atomic_size_t    text_overruns;
+
+static void text_put(char c) {
+    size_t head = atomic_load_explicit(&text_head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&text_tail, memory_order_acquire);
+
+    if (head - tail >= TEXT_RING) {
+        atomic_fetch_add_explicit(&text_overruns, 1, memory_order_relaxed);
+        return;
+    }
+
+    text_ring[head & (TEXT_RING - 1)] = c;
+    atomic_store_explicit(&text_head, head + 1, memory_order_release);
+}
+
+size_t psk_get_text(char *buf, size_t size) {
+    size_t tail = atomic_load_explicit(&text_tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&text_head, memory_order_acquire);
+    size_t n = 0;
+
+    while (tail != head && n + 1 < size) {
+        buf[n++] = text_ring[tail++ & (TEXT_RING - 1)];
+    }
+
+    buf[n] = 0;
+    atomic_store_explicit(&text_tail, tail, memory_order_release);
+
+    size_t lost = atomic_exchange_explicit(&text_overruns, 0, memory_order_relaxed);
+
+    if (lost) {
+        LV_LOG_WARN("PSK text overrun, %zu chars lost", lost);
+    }
+
+    return n;
+}
+
+static void line_flush(uint8_t channel) {
+    char *line = lines[channel];
+
+    if (line[0]) {
+        char str[LINE_LEN + 16];
+
+        snprintf(str, sizeof(str), "%u: %s\n", freqs[channel], line);
+
+        for (char *c = str; *c; c++)
+            text_put(*c);
+
+        line[0] = 0;
+    }
+}
+
+static void text_cb(uint8_t channel, char c, void *user) {
+    if (c == '\r') {
+        return;
+    }
+
+    if (!params.psk_multi) {
+        text_put(c);
+        return;
+    }
+
+    char    *line = lines[channel];
+    size_t  len = strlen(line);
+
+    if (c == '\n') {
+        line_flush(channel);
+        return;
+    }
+
+    line[len] = c;
+    line[len + 1] = 0;
+
+    if (len + 1 == LINE_LEN) {
+        line_flush(channel);
+    }
+}
+
+static void init() {
+    rx = psk_rx_create(params.psk_rate / 100.0f, AUDIO_CAPTURE_RATE, text_cb, NULL);
+
+    if (params.psk_multi) {
+        psk_rx_set_detect(rx, true);
+    } else {
+        psk_rx_tune(rx, 0, params.psk_center);
+    }
+
+    for (uint8_t i = 0; i < PSK_RX_CHANNELS; i++) {
+        lines[i][0] = 0;
+        freqs[i] = 0;
+    }
+}
+
+static void done() {
+    psk_rx_destroy(rx);
+    rx = NULL;
+}
+
+void psk_init() {
+    init();
+    atomic_store(&ready, true);
+}
+
+void psk_put_audio_samples(unsigned int n, cfloat *samples) {
+    if (!atomic_load(&ready)) {
+        return;
+    }
+
+    if (atomic_exchange(&reinit, false)) {
+        done();
+        init();
+    } else if (atomic_exchange(&retune, false) && !params.psk_multi) {
+        psk_rx_tune(rx, 0, params.psk_center);
+    }
+
+    psk_rx_process(rx, n, samples);
+
+    for (uint8_t i = 0; i < PSK_RX_CHANNELS; i++) {
+        uint16_t freq = psk_rx_get_freq(rx, i) + 0.5f;
+
+        /* Released channel shows the rest of its text */
+
+        if (freq == 0 && freqs[i] != 0) {
+            line_flush(i);
+        }
+
+        freqs[i] = freq;
+    }
+}
+
+size_t psk_get_freqs(uint16_t *out, size_t max) {
+    size_t count = 0;
+
+    for (uint8_t i = 0; i < PSK_RX_CHANNELS && count < max; i++) {
+        uint16_t freq = freqs[i];
+
+        if (freq) {
+            out[count++] = freq;
+        }
+    }
+
+    return count;
+}
+
+void psk_set_state(psk_state_t x) {
+    if (x != PSK_OFF && state == PSK_OFF) {
+        atomic_store(&reinit, true);
+    }
+
+    state = x;
+}
+
+psk_state_t psk_get_state() {
+    return state;
+}
+
+float psk_change_rate(int16_t df) {
+    if (df == 0) {
+        return params.psk_rate / 100.0f;
+    }
+
+    params_lock();
+    params.psk_rate = params.psk_rate == 3125 ? 6250 : 3125;
+    params_unlock(&params.dirty.psk_rate);
+
+    atomic_store(&reinit, true);
+
+    return params.psk_rate / 100.0f;
+}
+
+uint16_t psk_change_center(int16_t df) {
+    if (df == 0) {
+        return params.psk_center;
+    }
+
+    params_lock();
+    params.psk_center = limit(align_int(params.psk_center + df * 5, 5), 300, 2700);
+    params_unlock(&params.dirty.psk_center);
+
+    atomic_store(&retune, true);
+
+    return params.psk_center;
+}
+
+bool psk_change_multi(int16_t df) {
+    if (df == 0) {
+        return params.psk_multi;
+    }
+
+    params_lock();
+    params.psk_multi = !params.psk_multi;
+    params_unlock(&params.dirty.psk_multi);
+
+    atomic_store(&reinit, true);
+
+    return params.psk_multi;
+}
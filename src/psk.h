@@ -0,0 +1,40 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include "helpers.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef enum {
+    PSK_OFF = 0,
+    PSK_RX
+} psk_state_t;
+
+void psk_init();
+void psk_put_audio_samples(unsigned int n, cfloat *samples);
+
+/**
+ * Take decoded chars, UI thread only. Never waits for the demodulator
+ */
+size_t psk_get_text(char *buf, size_t size);
+
+/**
+ * Audio frequencies of the busy channels, Hz
+ */
+size_t psk_get_freqs(uint16_t *freqs, size_t max);
+
+void psk_set_state(psk_state_t state);
+psk_state_t psk_get_state();
+
+float psk_change_rate(int16_t df);
+uint16_t psk_change_center(int16_t df);
+bool psk_change_multi(int16_t df);
@@ -0,0 +1,365 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "psk_rx.h"
+#include "psk_varicode.h"
+#include "vmath.h"
+
+#include <liquid/liquid.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RATE            8000.0f                 /* After the resampler */
+#define CHUNK           512
+#define SPS             8                       /* Samples per symbol in the filterbank bin */
+#define MAX_BANK        64
+#define SYNC_M          3
+#define SYNC_BETA       0.8f
+#define SYNC_BW         0.02f
+#define PLL_BW          0.01f
+#define QUALITY_BETA    0.05f
+#define SQUELCH         0.3f
+
+#define DETECT_FROM     200.0f                  /* Hz */
+#define DETECT_TO       3000.0f
+#define DETECT_TIME     0.1f                    /* s */
+#define DETECT_SNR      10.0f                   /* dB over the median of bins */
+#define RELEASE_QUALITY 0.2f
+#define RELEASE_TIME    10.0f                   /* s */
+
+typedef struct {
+    bool            active;
+    int             bin;
+    nco_crcf        nco;                        /* Costas loop */
+    symsync_crcf    sync;
+    cfloat          prev;
+    float           quality;
+    uint32_t        idle;                       /* Detect periods with low quality */
+    uint16_t        shreg;
+} channel_t;
+
+struct psk_rx_s {
+    float               baud;
+    unsigned int        bank;                   /* Filterbank size */
+    float               spacing;                /* Hz between bins */
+    float               bin_rate;               /* Output rate of a bin */
+
+    msresamp_crcf       resamp;
+    firpfbch2_crcf      chan;
+    cfloat              resamp_buf[CHUNK * 2];
+    cfloat              chan_in[MAX_BANK / 2];
+    size_t              chan_count;
+    cfloat              chan_out[MAX_BANK];
+
+    bool                detect;
+    int                 bin_first;
+    int                 bin_last;
+    uint32_t            detect_frames;
+    uint32_t            frames;
+    float               acc[MAX_BANK / 2];
+    float               level[MAX_BANK / 2];
+
+    channel_t           channels[PSK_RX_CHANNELS];
+
+    psk_rx_text_cb_t    text_cb;
+    void                *user;
+};
+
+psk_rx_t psk_rx_create(float baud, float sample_rate, psk_rx_text_cb_t text_cb, void *user) {
+    psk_rx_t rx = calloc(1, sizeof(struct psk_rx_s));
+
+    /* 250 Hz for PSK31 and 500 Hz for PSK63 gives the same 8 samples per symbol */
+
+    rx->baud = baud;
+    rx->bank = lroundf(2.0f * RATE / (baud * SPS));
+    rx->spacing = RATE / rx->bank;
+    rx->bin_rate = 2.0f * rx->spacing;
+    rx->text_cb = text_cb;
+    rx->user = user;
+
+    rx->resamp = msresamp_crcf_create(RATE / sample_rate, 60.0f);
+    rx->chan = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, rx->bank, 4, 60.0f);
+
+    rx->bin_first = ceilf(DETECT_FROM / rx->spacing);
+    rx->bin_last = floorf(DETECT_TO / rx->spacing);
+
+    if (rx->bin_first < 1) {
+        rx->bin_first = 1;
+    }
+
+    if (rx->bin_last > (int) rx->bank / 2 - 2) {
+        rx->bin_last = rx->bank / 2 - 2;
+    }
+
+    rx->detect_frames = DETECT_TIME * rx->bin_rate;
+
+    for (size_t i = 0; i < PSK_RX_CHANNELS; i++) {
+        channel_t *c = &rx->channels[i];
+
+        c->nco = nco_crcf_create(LIQUID_VCO);
+        nco_crcf_pll_set_bandwidth(c->nco, PLL_BW);
+
+        c->sync = symsync_crcf_create_rnyquist(LIQUID_FIRFILT_RRC, SPS, SYNC_M, SYNC_BETA, 32);
+        symsync_crcf_set_lf_bw(c->sync, SYNC_BW);
+    }
+
+    return rx;
+}
+
+void psk_rx_destroy(psk_rx_t rx) {
+    msresamp_crcf_destroy(rx->resamp);
+    firpfbch2_crcf_destroy(rx->chan);
+
+    for (size_t i = 0; i < PSK_RX_CHANNELS; i++) {
+        nco_crcf_destroy(rx->channels[i].nco);
+        symsync_crcf_destroy(rx->channels[i].sync);
+    }
+
+    free(rx);
+}
+
+void psk_rx_tune(psk_rx_t rx, uint8_t channel, float freq) {
+    if (channel >= PSK_RX_CHANNELS) {
+        return;
+    }
+
+    channel_t   *c = &rx->channels[channel];
+    int         bin = lroundf(freq / rx->spacing);
+
+    if (bin < 1 || bin > (int) rx->bank / 2 - 1) {
+        return;
+    }
+
+    /* The rest of the offset is removed by the loop NCO */
+
+    c->bin = bin;
+    nco_crcf_reset(c->nco);
+    nco_crcf_set_frequency(c->nco, 2.0f * (float) M_PI * (freq - bin * rx->spacing) / rx->bin_rate);
+    symsync_crcf_reset(c->sync);
+
+    c->prev = 0.0f;
+    c->quality = 0.0f;
+    c->idle = 0;
+    c->shreg = 0;
+    c->active = true;
+}
+
+void psk_rx_release(psk_rx_t rx, uint8_t channel) {
+    if (channel < PSK_RX_CHANNELS) {
+        rx->channels[channel].active = false;
+    }
+}
+
+void psk_rx_set_detect(psk_rx_t rx, bool on) {
+    rx->detect = on;
+    rx->frames = 0;
+    memset(rx->acc, 0, sizeof(rx->acc));
+}
+
+float psk_rx_get_freq(psk_rx_t rx, uint8_t channel) {
+    if (channel >= PSK_RX_CHANNELS || !rx->channels[channel].active) {
+        return 0.0f;
+    }
+
+    channel_t *c = &rx->channels[channel];
+
+    return c->bin * rx->spacing + nco_crcf_get_frequency(c->nco) * rx->bin_rate / (2.0f * (float) M_PI);
+}
+
+float psk_rx_get_quality(psk_rx_t rx, uint8_t channel) {
+    if (channel >= PSK_RX_CHANNELS || !rx->channels[channel].active) {
+        return 0.0f;
+    }
+
+    return rx->channels[channel].quality;
+}
+
+static void varicode_bit(psk_rx_t rx, uint8_t n, bool bit) {
+    channel_t *c = &rx->channels[n];
+
+    c->shreg = (c->shreg << 1) | bit;
+
+    if ((c->shreg & 3) == 0) {
+        char ch = psk_varicode_decode(c->shreg >> 2);
+
+        if (ch && c->quality > SQUELCH && rx->text_cb) {
+            rx->text_cb(n, ch, rx->user);
+        }
+
+        c->shreg = 0;
+    } else if (c->shreg >> (PSK_VARICODE_MAX_LEN + 2)) {
+        c->shreg = 0;
+    }
+}
+
+static void channel_symbol(psk_rx_t rx, uint8_t n, cfloat sym) {
+    channel_t   *c = &rx->channels[n];
+    float       mag = cabsf(sym);
+
+    if (mag > 0.0f) {
+        /* Costas loop, BPSK phase error from the decision */
+
+        float err = (crealf(sym) > 0.0f ? cimagf(sym) : -cimagf(sym)) / mag;
+
+        nco_crcf_pll_step(c->nco, err);
+    }
+
+    /* Differential decision: reversal is zero */
+
+    cfloat  d = sym * conjf(c->prev);
+    cfloat  d2 = d * d;
+    float   d2_mag = cabsf(d2);
+
+    c->quality += ((d2_mag > 0.0f ? crealf(d2) / d2_mag : 0.0f) - c->quality) * QUALITY_BETA;
+    c->prev = sym;
+
+    varicode_bit(rx, n, crealf(d) > 0.0f);
+}
+
+static void channel_sample(psk_rx_t rx, uint8_t n, cfloat x) {
+    channel_t       *c = &rx->channels[n];
+    cfloat          y;
+    cfloat          sym[4];
+    unsigned int    ny;
+
+    nco_crcf_mix_down(c->nco, x, &y);
+    nco_crcf_step(c->nco);
+
+    symsync_crcf_execute(c->sync, &y, 1, sym, &ny);
+
+    for (unsigned int i = 0; i < ny; i++) {
+        channel_symbol(rx, n, sym[i]);
+    }
+}
+
+static int compare_float(const void *p1, const void *p2) {
+    float a = *(const float *) p1;
+    float b = *(const float *) p2;
+
+    return (a > b) - (a < b);
+}
+
+static bool is_taken(psk_rx_t rx, float freq) {
+    for (uint8_t i = 0; i < PSK_RX_CHANNELS; i++) {
+        if (rx->channels[i].active && fabsf(psk_rx_get_freq(rx, i) - freq) < rx->spacing) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void start_channel(psk_rx_t rx, float freq) {
+    for (uint8_t i = 0; i < PSK_RX_CHANNELS; i++) {
+        if (!rx->channels[i].active) {
+            psk_rx_tune(rx, i, freq);
+            return;
+        }
+    }
+}
+
+/**
+ * Peaks over the median of bins take the free channels, channels without
+ * a clean phase for a while are released
+ */
+static void detect_update(psk_rx_t rx) {
+    float   sorted[MAX_BANK / 2];
+    int     count = 0;
+
+    for (int b = rx->bin_first - 1; b <= rx->bin_last + 1; b++) {
+        rx->level[b] = rx->acc[b] / rx->detect_frames + 1e-12f;
+        rx->acc[b] = 0.0f;
+    }
+
+    vmath_power_to_db(&rx->level[rx->bin_first - 1], &rx->level[rx->bin_first - 1], rx->bin_last - rx->bin_first + 3);
+
+    for (int b = rx->bin_first; b <= rx->bin_last; b++) {
+        sorted[count++] = rx->level[b];
+    }
+
+    qsort(sorted, count, sizeof(float), compare_float);
+
+    float noise = sorted[count / 2];
+
+    for (uint8_t i = 0; i < PSK_RX_CHANNELS; i++) {
+        channel_t *c = &rx->channels[i];
+
+        if (!c->active) {
+            continue;
+        }
+
+        if (c->quality < RELEASE_QUALITY) {
+            if (++c->idle > RELEASE_TIME / DETECT_TIME) {
+                c->active = false;
+            }
+        } else {
+            c->idle = 0;
+        }
+    }
+
+    for (int b = rx->bin_first; b <= rx->bin_last; b++) {
+        float x = rx->level[b];
+        float l = rx->level[b - 1];
+        float r = rx->level[b + 1];
+
+        if (x - noise < DETECT_SNR || x < l || x < r) {
+            continue;
+        }
+
+        float d = l - 2.0f * x + r;
+        float freq = (d < 0.0f ? b + 0.5f * (l - r) / d : b) * rx->spacing;
+
+        if (!is_taken(rx, freq)) {
+            start_channel(rx, freq);
+        }
+    }
+}
+
+static void frame(psk_rx_t rx) {
+    if (rx->detect) {
+        for (int b = rx->bin_first - 1; b <= rx->bin_last + 1; b++) {
+            cfloat x = rx->chan_out[b];
+
+            rx->acc[b] += crealf(x) * crealf(x) + cimagf(x) * cimagf(x);
+        }
+
+        if (++rx->frames >= rx->detect_frames) {
+            rx->frames = 0;
+            detect_update(rx);
+        }
+    }
+
+    for (uint8_t i = 0; i < PSK_RX_CHANNELS; i++) {
+        if (rx->channels[i].active) {
+            channel_sample(rx, i, rx->chan_out[rx->channels[i].bin]);
+        }
+    }
+}
+
+void psk_rx_process(psk_rx_t rx, size_t n, cfloat *samples) {
+    size_t half = rx->bank / 2;
+
+    for (size_t pos = 0; pos < n; pos += CHUNK) {
+        size_t          k = n - pos < CHUNK ? n - pos : CHUNK;
+        unsigned int    ny;
+
+        msresamp_crcf_execute(rx->resamp, samples + pos, k, rx->resamp_buf, &ny);
+
+        for (unsigned int i = 0; i < ny; i++) {
+            rx->chan_in[rx->chan_count++] = rx->resamp_buf[i];
+
+            if (rx->chan_count == half) {
+                rx->chan_count = 0;
+                firpfbch2_crcf_execute(rx->chan, rx->chan_in, rx->chan_out);
+                frame(rx);
+            }
+        }
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include "helpers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * BPSK31/63 receiver. Audio is resampled once and split by a polyphase
+ * filterbank, every channel takes its filterbank bin at 8 samples per
+ * symbol and runs a Costas loop, symbol sync and Varicode decoder. So an
+ * extra channel costs only the per symbol work.
+ */
+
+#define PSK_RX_CHANNELS     8
+
+typedef struct psk_rx_s * psk_rx_t;
+
+typedef void (*psk_rx_text_cb_t)(uint8_t channel, char c, void *user);
+
+/**
+ * Baud is 31.25 or 62.5, sample rate of the input audio
+ */
+psk_rx_t psk_rx_create(float baud, float sample_rate, psk_rx_text_cb_t text_cb, void *user);
+void psk_rx_destroy(psk_rx_t rx);
+
+/**
+ * Put channel on the audio frequency, Hz
+ */
+void psk_rx_tune(psk_rx_t rx, uint8_t channel, float freq);
+void psk_rx_release(psk_rx_t rx, uint8_t channel);
+
+/**
+ * Channels are taken by signals found in the passband and released after silence
+ */
+void psk_rx_set_detect(psk_rx_t rx, bool on);
+
+void psk_rx_process(psk_rx_t rx, size_t n, cfloat *samples);
+
+/**
+ * Tracked frequency, Hz. Zero for the idle channel
+ */
+float psk_rx_get_freq(psk_rx_t rx, uint8_t channel);
+
+/**
+ * Phase quality 0..1, 1 for a clean signal
+ */
+float psk_rx_get_quality(psk_rx_t rx, uint8_t channel);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,73 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "psk_varicode.h"
+
+#include <pthread.h>
+
+#define INDEX_SIZE  (1 << PSK_VARICODE_MAX_LEN)
+
+static const uint16_t codes[128] = {
+    0x2AB, 0x2DB, 0x2ED, 0x377, 0x2EB, 0x35F, 0x2EF, 0x2FD,
+    0x2FF, 0x0EF, 0x01D, 0x36F, 0x2DD, 0x01F, 0x375, 0x3AB,
+    0x2F7, 0x2F5, 0x3AD, 0x3AF, 0x35B, 0x36B, 0x36D, 0x357,
+    0x37B, 0x37D, 0x3B7, 0x355, 0x35D, 0x3BB, 0x2FB, 0x37F,
+    0x001, 0x1FF, 0x15F, 0x1F5, 0x1DB, 0x2D5, 0x2BB, 0x17F,
+    0x0FB, 0x0F7, 0x16F, 0x1DF, 0x075, 0x035, 0x057, 0x1AF,
+    0x0B7, 0x0BD, 0x0ED, 0x0FF, 0x177, 0x15B, 0x16B, 0x1AD,
+    0x1AB, 0x1B7, 0x0F5, 0x1BD, 0x1ED, 0x055, 0x1D7, 0x2AF,
+    0x2BD, 0x07D, 0x0EB, 0x0AD, 0x0B5, 0x077, 0x0DB, 0x0FD,
+    0x155, 0x07F, 0x1FD, 0x17D, 0x0D7, 0x0BB, 0x0DD, 0x0AB,
+    0x0D5, 0x1DD, 0x0AF, 0x06F, 0x06D, 0x157, 0x1B5, 0x15D,
+    0x175, 0x17B, 0x2AD, 0x1F7, 0x1EF, 0x1FB, 0x2BF, 0x16D,
+    0x2DF, 0x00B, 0x05F, 0x02F, 0x02D, 0x003, 0x03D, 0x05B,
+    0x02B, 0x00D, 0x1EB, 0x0BF, 0x01B, 0x03B, 0x00F, 0x007,
+    0x03F, 0x1BF, 0x015, 0x017, 0x005, 0x037, 0x07B, 0x06B,
+    0x0DF, 0x05D, 0x1D5, 0x2B7, 0x1BB, 0x2B5, 0x2D7, 0x3B5,
+};
+
+static char             decode_index[INDEX_SIZE];
+static pthread_once_t   index_once = PTHREAD_ONCE_INIT;
+
+static void index_build() {
+    for (int i = 0; i < 128; i++) {
+        decode_index[codes[i]] = i;
+    }
+}
+
+static uint8_t bits_len(uint16_t bits) {
+    uint8_t len = 0;
+
+    while (bits) {
+        bits >>= 1;
+        len++;
+    }
+
+    return len;
+}
+
+psk_varicode_t psk_varicode_encode(char c) {
+    psk_varicode_t res = { 0, 0 };
+
+    if ((unsigned char) c < 128) {
+        res.bits = codes[(unsigned char) c];
+        res.len = bits_len(res.bits);
+    }
+
+    return res;
+}
+
+char psk_varicode_decode(uint16_t bits) {
+    if (bits >= INDEX_SIZE) {
+        return 0;
+    }
+
+    pthread_once(&index_once, index_build);
+
+    return decode_index[bits];
+}
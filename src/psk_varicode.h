@@ -0,0 +1,41 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * PSK31 Varicode. Codes start and end with 1 and have no "00" inside, so
+ * chars are separated by two zero bits. Code is kept as bits, MSB first
+ */
+
+#define PSK_VARICODE_MAX_LEN    10
+
+typedef struct {
+    uint16_t    bits;
+    uint8_t     len;
+} psk_varicode_t;
+
+/**
+ * Code of the ASCII char, zero length for chars above 127
+ */
+psk_varicode_t psk_varicode_encode(char c);
+
+/**
+ * Char of the code without the separator, 0 if unknown
+ */
+char psk_varicode_decode(uint16_t bits);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,6 +8,7 @@
 #include "radio.h"
 
 #include "cfg/atu.h"
+#include "cfg/snapshot.h"
 #include "cfg/transverter.h"
 #include "util.h"
 #include "dsp.h"
@@ -82,15 +83,11 @@ static void process_power_key(bool val, uint64_t now) {
         } else {
             event.state = KEYPAD_LONG_RELEASE;
         }
-        event_keypad_t *ev = malloc(sizeof(event_keypad_t));
-        *ev = event;
-        event_send(NULL, EVENT_KEYPAD, (void*) ev);
+        event_send(NULL, EVENT_KEYPAD, &event, sizeof(event));
     }
     if ((event.state == KEYPAD_PRESS) && (now - power_press_time > POWER_KEY_LONG_TIME)) {
         event.state = KEYPAD_LONG;
-        event_keypad_t *ev = malloc(sizeof(event_keypad_t));
-        *ev = event;
-        event_send(NULL, EVENT_KEYPAD, (void*) ev);
+        event_send(NULL, EVENT_KEYPAD, &event, sizeof(event));
     }
     prev_val = val;
 }
@@ -127,14 +124,18 @@ bool radio_tick() {
         // TODO: add adjustment
         int16_t dbm = -(int16_t)pack->dbm + 4;
 
-        x6200_mode_t mode = subject_get_int(cfg_cur.mode);
+        cfg_snapshot_t  snap;
+
+        cfg_snapshot_get(&snap);
+
+        x6200_mode_t    mode = snap.mode;
 
         dsp_samples(samples, RADIO_SAMPLES, pack->flag.tx, dbm);
         // printf("als=%f\n", pack->alc_level * 0.1f);
 
         process_power_key(pack->flag.power_key, now_time);
 
-        if (subject_get_int(cfg.key_train.val) && ((mode == x6200_mode_cw) || (mode == x6200_mode_cwr))) {
+        if (snap.key_train && ((mode == x6200_mode_cw) || (mode == x6200_mode_cwr))) {
             // Ignore TX from BASE
             pack->flag.tx = false;
         }
@@ -671,6 +672,9 @@ x6200_vfo_t radio_toggle_vfo() {
 }
 
 void radio_poweroff() {
+    params_flush();
+    cfg_flush();
+
     if (params.charger == RADIO_CHARGER_SHADOW) {
         WITH_RADIO_LOCK(x6200_control_charger_set(true));
     }
@@ -6,20 +6,53 @@
  *  Copyright (c) 2022-2023 Belousov Oleg aka R1CBU
  */
 
+#define _GNU_SOURCE
+
 #include <time.h>
 #include <sys/time.h>
 #include <sndfile.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
 
 #include "audio.h"
 #include "dialog_recorder.h"
 #include "recorder.h"
 #include "msg.h"
+#include "scheduler.h"
 #include "params/params.h"
 
+/*
+ * Capture thread (PulseAudio callback) only copies samples into the ring,
+ * encoding is done by a separate low priority thread. When pre-record is
+ * enabled, ring keeps last seconds of audio even if the recorder is off.
+ *
+ * The file is owned by the encoder thread: UI only flips the flag and wakes
+ * the encoder, which opens the file, drains the ring and closes it.
+ */
+
+#define RING_SIZE           (1 << 20)       /* ~23 s at 44.1 kHz */
+#define RING_MASK           (RING_SIZE - 1)
+#define ENCODER_PERIOD_MS   50
+
 char            *recorder_path = "/mnt/rec";
 
-static bool     on = false;
-static SNDFILE  *file = NULL;
+static atomic_bool  on = false;
+static atomic_uint  starts;                 /* bumped by each recorder_set_on(true) */
+static sem_t        wake;
+
+static SNDFILE      *file = NULL;           /* encoder thread only */
+static unsigned     file_start;
+
+static int16_t          ring[RING_SIZE];
+static atomic_size_t    ring_head;          /* written by capture thread */
+static atomic_size_t    ring_tail;          /* written by encoder thread */
+static atomic_size_t    pre_samples;
+static atomic_size_t    overruns;
 
 static bool create_file() {
     SF_INFO sfinfo;
@@ -53,28 +86,160 @@ static bool create_file() {
     return true;
 }
 
-void recorder_set_on(bool x) {
-    if (x) {
-        if (!create_file()) {
-            msg_update_text_fmt("Problem with create file");
-            return;
+/**
+ * Write all buffered samples to file
+ */
+static void ring_drain() {
+    size_t tail = atomic_load_explicit(&ring_tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&ring_head, memory_order_acquire);
+
+    while (tail != head) {
+        size_t pos = tail & RING_MASK;
+        size_t len = head - tail;
+
+        if (len > RING_SIZE - pos) {
+            len = RING_SIZE - pos;
+        }
+
+        sf_write_short(file, &ring[pos], len);
+        tail += len;
+        atomic_store_explicit(&ring_tail, tail, memory_order_release);
+    }
+}
+
+/**
+ * Drop samples older than pre-record time
+ */
+static void ring_trim(size_t keep) {
+    size_t tail = atomic_load_explicit(&ring_tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&ring_head, memory_order_acquire);
+
+    if (head - tail > keep) {
+        atomic_store_explicit(&ring_tail, head - keep, memory_order_release);
+    }
+}
+
+static void create_failed_cb(void *arg) {
+    dialog_recorder_set_on(false);
+}
+
+static void encoder_wait() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_nsec += ENCODER_PERIOD_MS * 1000000L;
+
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+
+    while (sem_timedwait(&wake, &ts) != 0 && errno == EINTR) {
+    }
+}
+
+static void * encoder_thread(void *arg) {
+    struct sched_param param = { .sched_priority = 0 };
+
+    if (pthread_setschedparam(pthread_self(), SCHED_IDLE, &param) != 0) {
+        LV_LOG_WARN("Can't set SCHED_IDLE for recorder");
+    }
+
+    while (true) {
+        size_t      pre = (size_t) params.rec_pre_time.x * AUDIO_CAPTURE_RATE;
+        bool        rec = atomic_load(&on);
+        unsigned    start = atomic_load(&starts);
+
+        if (pre > RING_SIZE / 2) {
+            pre = RING_SIZE / 2;
+        }
+        atomic_store_explicit(&pre_samples, pre, memory_order_relaxed);
+
+        if (file && (!rec || file_start != start)) {
+            ring_drain();
+            sf_close(file);
+            file = NULL;
+
+            if (!rec) {
+                msg_schedule_text_fmt("Recorder is off");
+            }
+        }
+
+        if (!file && rec) {
+            if (create_file()) {
+                file_start = start;
+            } else {
+                atomic_store(&on, false);
+                msg_schedule_text_fmt("Problem with create file");
+                scheduler_put_noargs(create_failed_cb);
+            }
+        }
+
+        if (file) {
+            ring_drain();
         } else {
-            msg_update_text_fmt("Recorder is on");
+            ring_trim(pre);
+        }
+
+        size_t lost = atomic_exchange_explicit(&overruns, 0, memory_order_relaxed);
+
+        if (lost) {
+            LV_LOG_WARN("Recorder overrun, %zu samples lost", lost);
         }
-        on = true;
-    } else {
-        msg_update_text_fmt("Recorder is off");
-        on = false;
-        sf_close(file);
+
+        encoder_wait();
     }
 
-    dialog_recorder_set_on(on);
+    return NULL;
+}
+
+void recorder_init() {
+    pthread_t thread;
+
+    sem_init(&wake, 0, 0);
+    pthread_create(&thread, NULL, encoder_thread, NULL);
+    pthread_detach(thread);
+}
+
+void recorder_set_on(bool x) {
+    if (x) {
+        atomic_fetch_add(&starts, 1);
+        msg_update_text_fmt("Recorder is on");
+    }
+
+    atomic_store(&on, x);
+    sem_post(&wake);
+
+    dialog_recorder_set_on(x);
 }
 
 bool recorder_is_on() {
-    return on;
+    return atomic_load(&on);
 }
 
 void recorder_put_audio_samples(size_t nsamples, int16_t *samples) {
-    sf_write_short(file, samples, nsamples);
+    if (!atomic_load_explicit(&on, memory_order_relaxed) && !atomic_load_explicit(&pre_samples, memory_order_relaxed)) {
+        return;
+    }
+
+    size_t head = atomic_load_explicit(&ring_head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring_tail, memory_order_acquire);
+    size_t free_size = RING_SIZE - (head - tail);
+
+    if (nsamples > free_size) {
+        atomic_fetch_add_explicit(&overruns, nsamples - free_size, memory_order_relaxed);
+        nsamples = free_size;
+    }
+
+    size_t pos = head & RING_MASK;
+    size_t part = RING_SIZE - pos;
+
+    if (part > nsamples) {
+        part = nsamples;
+    }
+
+    memcpy(&ring[pos], samples, part * sizeof(int16_t));
+    memcpy(&ring[0], samples + part, (nsamples - part) * sizeof(int16_t));
+
+    atomic_store_explicit(&ring_head, head + nsamples, memory_order_release);
 }
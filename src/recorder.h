@@ -9,10 +9,12 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 extern char *recorder_path;
 
+void recorder_init();
 void recorder_set_on(bool on);
 bool recorder_is_on();
 void recorder_put_audio_samples(size_t nsamples, int16_t *samples);
@@ -8,269 +8,138 @@
 #include "rtty.h"
 
 #include "audio.h"
-#include "pannel.h"
+#include "rtty_rx.h"
 #include "params/params.h"
+#include "scheduler.h"
 #include "util.h"
+#include "msg.h"
 
 #include "lvgl/lvgl.h"
 
-#include <math.h>
-#include <stdlib.h>
-#include <pthread.h>
+#include <stdatomic.h>
 
-#define SYMBOL_OVER 8
-#define SYMBOL_FACTOR 2
-#define SYMBOL_LEN (SYMBOL_OVER * SYMBOL_FACTOR)
+#define TEXT_RING       256         /* Decoded chars on the way to UI, power of 2 */
 
-#define RTTY_SYMBOL_CODE (0b11011)
-#define RTTY_LETTER_CODE (0b11111)
+typedef struct {
+    float       rate;
+    uint16_t    shift;
+} rtty_best_t;
 
-typedef enum {
-    RX_STATE_IDLE,
-    RX_STATE_START,
-    RX_STATE_DATA,
-    RX_STATE_STOP
-} rx_state_t;
+static rtty_rx_t        rx = NULL;
+static rtty_best_t      best;       /* Shown to the user, demodulator thread */
 
-static pthread_mutex_t rtty_mux;
+/* Set by UI, applied by the demodulator thread */
 
-static fskdem demod = NULL;
+static atomic_bool      ready = false;
+static atomic_bool      reinit = false;
+static atomic_bool      renco = false;
 
-static nco_crcf       nco     = NULL;
-static float complex *nco_buf = NULL;
+static char             text_ring[TEXT_RING];
+static atomic_size_t    text_head;          /* written by demodulator */
+static atomic_size_t    text_tail;          /* written by UI */
+static atomic_size_t    text_overruns;
 
-static uint16_t symbol_samples;
-static uint16_t symbol_over;
-
-static cbuffercf      rx_buf;
-static complex float *rx_window = NULL;
-static uint8_t        rx_symbol[SYMBOL_LEN];
-static float          rx_symbol_pwr[SYMBOL_LEN];
-static uint8_t        rx_symbol_cur = 0;
-static rx_state_t     rx_state      = RX_STATE_IDLE;
-static uint8_t        rx_counter    = 0;
-static uint8_t        rx_bitcntr    = 0;
-static uint8_t        rx_data       = 0;
-static bool           rx_letter     = true;
-
-static bool         ready = false;
 static rtty_state_t state = RTTY_OFF;
 
 static x6200_mode_t cur_mode;
 
-static const char rtty_letters[32] = {'\0', 'E', '\n', 'A', ' ', 'S', 'I', 'U', '\0', 'D', 'R',
-                                      'J',  'N', 'F',  'C', 'K', 'T', 'Z', 'L', 'W',  'H', 'Y',
-                                      'P',  'Q', 'O',  'B', 'G', ' ', 'M', 'X', 'V',  ' '};
-
-static const char rtty_symbols[32] = {'\0', '3', '\n', '-', ' ', '\0', '8', '7', '\0', '$', '4',
-                                      '\'', ',', '!',  ':', '(', '5',  '"', ')', '2',  '#', '6',
-                                      '0',  '1', '9',  '?', '&', ' ',  '.', '/', ';',  ' '};
-
 static void on_cur_mode_change(Subject *subj, void *user_data);
 
-static void update_nco() {
-    float radians = 2.0f * (float)M_PI * (float)params.rtty_center / (float)AUDIO_CAPTURE_RATE;
+static void text_put(char c, void *user) {
+    size_t head = atomic_load_explicit(&text_head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&text_tail, memory_order_acquire);
+
+    if (head - tail >= TEXT_RING) {
+        atomic_fetch_add_explicit(&text_overruns, 1, memory_order_relaxed);
+        return;
+    }
 
-    nco_crcf_set_phase(nco, 0.0f);
-    nco_crcf_set_frequency(nco, radians);
+    text_ring[head & (TEXT_RING - 1)] = c;
+    atomic_store_explicit(&text_head, head + 1, memory_order_release);
 }
 
 static void init() {
-    symbol_samples = (float)AUDIO_CAPTURE_RATE / (float)(params.rtty_rate / 100.0f) / (float)SYMBOL_FACTOR + 0.5f;
-    symbol_over    = symbol_samples / SYMBOL_OVER;
+    rx = rtty_rx_create(params.rtty_rate / 100.0f, params.rtty_shift, AUDIO_CAPTURE_RATE, text_put, NULL);
 
-    nco     = nco_crcf_create(LIQUID_NCO);
-    nco_buf = (float complex *)malloc(symbol_samples * sizeof(float complex));
-    update_nco();
+    rtty_rx_set_center(rx, params.rtty_center);
+    rtty_rx_set_snr(rx, params.rtty_snr);
+    rtty_rx_set_bits(rx, params.rtty_bits);
 
-    /* RX */
-
-    demod  = fskdem_create(1, symbol_samples, (float)params.rtty_shift / (float)AUDIO_CAPTURE_RATE / 2.0f);
-    rx_buf = cbuffercf_create(symbol_samples * 50);
-
-    rx_window = malloc(symbol_samples * sizeof(complex float));
-
-    for (uint16_t i = 0; i < symbol_samples; i++)
-        rx_window[i] = liquid_hann(i, symbol_samples);
-
-    ready = true;
+    best.rate = rtty_rx_get_rate(rx);
+    best.shift = rtty_rx_get_shift(rx);
 }
 
 static void done() {
-    ready = false;
-
-    nco_crcf_destroy(nco);
-    free(nco_buf);
-
-    fskdem_destroy(demod);
-    cbuffercf_destroy(rx_buf);
-    free(rx_window);
+    rtty_rx_destroy(rx);
+    rx = NULL;
 }
 
 static void update() {
-    pthread_mutex_lock(&rtty_mux);
-    done();
-    init();
-    pthread_mutex_unlock(&rtty_mux);
+    atomic_store(&reinit, true);
 }
 
 void rtty_init() {
-    pthread_mutex_init(&rtty_mux, NULL);
     subject_add_observer_and_call(cfg_cur.mode, on_cur_mode_change, NULL);
     init();
+    atomic_store(&ready, true);
 }
 
-static char baudot_decoder(uint8_t c) {
-    if (c == RTTY_SYMBOL_CODE) {
-        rx_letter = false;
-        return 0;
-    }
+size_t rtty_get_text(char *buf, size_t size) {
+    size_t tail = atomic_load_explicit(&text_tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&text_head, memory_order_acquire);
+    size_t n = 0;
 
-    if (c == RTTY_LETTER_CODE) {
-        rx_letter = true;
-        return 0;
+    while (tail != head && n + 1 < size) {
+        buf[n++] = text_ring[tail++ & (TEXT_RING - 1)];
     }
 
-    return rx_letter ? rtty_letters[c] : rtty_symbols[c];
-}
-
-static bool is_mark_space(uint8_t *correction) {
-    uint16_t res = 0;
+    buf[n] = 0;
+    atomic_store_explicit(&text_tail, tail, memory_order_release);
 
-    if (rx_symbol[0] && !rx_symbol[SYMBOL_LEN - 1]) {
-        for (int i = 0; i < SYMBOL_LEN; i++)
-            res += rx_symbol[i];
+    size_t lost = atomic_exchange_explicit(&text_overruns, 0, memory_order_relaxed);
 
-        if (abs(SYMBOL_LEN / 2 - res) < 1) {
-            *correction = res;
-            return true;
-        }
+    if (lost) {
+        LV_LOG_WARN("RTTY text overrun, %zu chars lost", lost);
     }
-    return false;
-}
 
-static bool is_mark() {
-    return rx_symbol[SYMBOL_LEN / 2];
+    return n;
 }
 
-static void add_symbol(float pwr) {
-    for (uint8_t i = 1; i < SYMBOL_LEN; i++) {
-        rx_symbol[i - 1]     = rx_symbol[i];
-        rx_symbol_pwr[i - 1] = rx_symbol_pwr[i];
-    }
-
-    rx_symbol_pwr[SYMBOL_LEN - 1] = pwr;
-
-    float   p_avr = 0.0f;
-    uint8_t p_num = SYMBOL_LEN / 2;
-
-    for (uint8_t i = SYMBOL_LEN - p_num; i < SYMBOL_LEN; i++)
-        p_avr += rx_symbol_pwr[i];
-
-    p_avr /= (float)p_num;
-
-    if (rx_symbol_cur == 0) {
-        if (p_avr > params.rtty_snr) {
-            rx_symbol_cur = 1;
-        }
-    } else {
-        if (p_avr < -params.rtty_snr) {
-            rx_symbol_cur = 0;
-        }
-    }
-
-    /* LV_LOG_USER("%5.1f %i", p_avr, rx_symbol_cur); */
-
-    rx_symbol[SYMBOL_LEN - 1] = rx_symbol_cur;
-
-    uint8_t correction;
-
-    switch (rx_state) {
-        case RX_STATE_IDLE:
-            if (is_mark_space(&correction)) {
-                rx_state   = RX_STATE_START;
-                rx_counter = correction;
-            }
-            break;
-
-        case RX_STATE_START:
-            if (--rx_counter == 0) {
-                if (!is_mark()) {
-                    rx_state   = RX_STATE_DATA;
-                    rx_counter = SYMBOL_LEN;
-                    rx_bitcntr = 0;
-                    rx_data    = 0;
-                } else {
-                    rx_state = RX_STATE_IDLE;
-                }
-            }
-            break;
-
-        case RX_STATE_DATA:
-            if (--rx_counter == 0) {
-                rx_data |= is_mark() << rx_bitcntr++;
-                rx_counter = SYMBOL_LEN;
-            }
-
-            if (rx_bitcntr == params.rtty_bits)
-                rx_state = RX_STATE_STOP;
-            break;
-
-        case RX_STATE_STOP:
-            if (--rx_counter == 0) {
-                if (is_mark()) {
-                    char c = baudot_decoder(rx_data);
-
-                    if (c) {
-                        char str[2] = {c, 0};
+/**
+ * Main thread, the arg is a copy
+ */
+static void show_best_cb(void *arg) {
+    rtty_best_t *b = arg;
 
-                        pannel_add_text(str);
-                    }
-                }
-                rx_state = RX_STATE_IDLE;
-            }
-            break;
-    }
+    msg_update_text_fmt("RTTY: %.2f Bd, %i Hz", b->rate, b->shift);
 }
 
 void rtty_put_audio_samples(unsigned int n, cfloat *samples) {
-    pthread_mutex_lock(&rtty_mux);
-
-    if (!ready) {
-        pthread_mutex_unlock(&rtty_mux);
+    if (!atomic_load(&ready)) {
         return;
     }
 
-    cbuffercf_write(rx_buf, samples, n);
-
-    while (cbuffercf_size(rx_buf) > symbol_samples) {
-        unsigned int   symbol;
-        unsigned int   n;
-        cfloat *buf;
-
-        cbuffercf_read(rx_buf, symbol_samples, &buf, &n);
-        nco_crcf_mix_block_down(nco, buf, nco_buf, n);
-
-        for (uint16_t i = 0; i < n; i++)
-            nco_buf[i] *= rx_window[i];
-
-        fskdem_demodulate(demod, nco_buf);
+    if (atomic_exchange(&reinit, false)) {
+        done();
+        init();
+    } else if (atomic_exchange(&renco, false)) {
+        rtty_rx_set_center(rx, params.rtty_center);
+    }
 
-        float pwr0 = 10.0f * log10f(fskdem_get_symbol_energy(demod, 0, 1));
-        float pwr1 = 10.0f * log10f(fskdem_get_symbol_energy(demod, 1, 1));
-        float pwr  = pwr0 - pwr1;
+    bool invert = ((cur_mode == x6200_mode_usb || cur_mode == x6200_mode_usb_dig) && !params.rtty_reverse) ||
+                  ((cur_mode == x6200_mode_lsb || cur_mode == x6200_mode_lsb_dig) && params.rtty_reverse);
 
-        if (((cur_mode == x6200_mode_usb || cur_mode == x6200_mode_usb_dig) && !params.rtty_reverse) ||
-            ((cur_mode == x6200_mode_lsb || cur_mode == x6200_mode_lsb_dig) && params.rtty_reverse)) {
-            pwr = -pwr;
-        }
+    rtty_rx_set_invert(rx, invert);
+    rtty_rx_process(rx, n, samples);
 
-        add_symbol(pwr);
+    float       rate = rtty_rx_get_rate(rx);
+    uint16_t    shift = rtty_rx_get_shift(rx);
 
-        cbuffercf_release(rx_buf, symbol_over);
+    if (rate != best.rate || shift != best.shift) {
+        best.rate = rate;
+        best.shift = shift;
+        scheduler_put(show_best_cb, &best, sizeof(best));
     }
-
-    pthread_mutex_unlock(&rtty_mux);
 }
 
 void rtty_set_state(rtty_state_t x) {
@@ -290,7 +159,7 @@ float rtty_change_rate(int16_t df) {
 
     switch (params.rtty_rate) {
         case 4500:
-            params.rtty_rate = df > 0 ? 4545 : 15000;
+            params.rtty_rate = df > 0 ? 4545 : 0;
             break;
 
         case 4545:
@@ -318,7 +187,11 @@ float rtty_change_rate(int16_t df) {
             break;
 
         case 15000:
-            params.rtty_rate = df > 0 ? 4500 : 11000;
+            params.rtty_rate = df > 0 ? 0 : 11000;
+            break;
+
+        case 0:
+            params.rtty_rate = df > 0 ? 4500 : 15000;
             break;
 
         default:
@@ -376,9 +249,7 @@ uint16_t rtty_change_center(int16_t df) {
     params.rtty_center = limit(align_int(params.rtty_center + df * 10, 10), 800, 1600);
     params_unlock(&params.dirty.rtty_center);
 
-    pthread_mutex_lock(&rtty_mux);
-    update_nco();
-    pthread_mutex_unlock(&rtty_mux);
+    atomic_store(&renco, true);
 
     return params.rtty_center;
 }
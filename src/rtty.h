@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <liquid/liquid.h>
 
 typedef enum {
@@ -23,6 +24,11 @@ typedef enum {
 void rtty_init();
 void rtty_put_audio_samples(unsigned int n, cfloat *samples);
 
+/**
+ * Take decoded chars, UI thread only. Never waits for the demodulator
+ */
+size_t rtty_get_text(char *buf, size_t size);
+
 void rtty_set_state(rtty_state_t state);
 rtty_state_t rtty_get_state();
 
@@ -0,0 +1,399 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2022-2023 Belousov Oleg aka R1CBU
+ */
+
+#include "rtty_rx.h"
+#include "fft_registry.h"
+
+#include <liquid/liquid.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SYMBOL_OVER 8
+#define SYMBOL_FACTOR 2
+#define SYMBOL_LEN (SYMBOL_OVER * SYMBOL_FACTOR)
+#define SYMBOL_MASK (SYMBOL_LEN - 1)
+
+#define RTTY_SYMBOL_CODE (0b11011)
+#define RTTY_LETTER_CODE (0b11111)
+
+/* Bank of demodulators shares the mixer and decimator */
+
+#define DECIM           8
+#define DECIM_BLOCK     512
+#define MAX_DEMODS      9
+#define SNR_TIME        1.0f        /* Averaging of the symbol SNR, s */
+#define SWITCH_DB       2.0f        /* Best demodulator hysteresis */
+
+typedef enum {
+    RX_STATE_IDLE,
+    RX_STATE_START,
+    RX_STATE_DATA,
+    RX_STATE_STOP
+} rx_state_t;
+
+typedef struct {
+    float       rate;
+    uint16_t    shift;
+
+    fskdem      fsk;
+    cbuffercf   buf;
+    cfloat      *work;
+    const float *window;
+    uint16_t    symbol_samples;
+    float       step;               /* Samples between symbol decisions */
+    float       step_acc;
+
+    /* Ring of the last symbols, head is the oldest */
+
+    uint8_t     symbol[SYMBOL_LEN];
+    float       symbol_mark[SYMBOL_LEN];
+    float       symbol_space[SYMBOL_LEN];
+    uint8_t     symbol_head;
+    uint8_t     symbol_marks;
+    uint8_t     symbol_cur;
+    rx_state_t  state;
+    uint8_t     counter;
+    uint8_t     bitcntr;
+    uint8_t     data;
+    bool        letter;
+
+    float       diff;               /* Average |mark - space| and mark + space */
+    float       sum;
+    float       beta;
+} demod_t;
+
+struct rtty_rx_s {
+    float               sample_rate;
+    float               decim_rate;
+
+    nco_crcf            nco;
+    firdecim_crcf       decim;
+    cfloat              decim_in[DECIM];
+    uint8_t             decim_count;
+    cfloat              decim_out[DECIM_BLOCK];
+    uint16_t            decim_out_count;
+
+    demod_t             demods[MAX_DEMODS];
+    uint8_t             demods_count;
+    demod_t             *best;
+
+    float               threshold;
+    float               switch_ratio;
+    uint8_t             bits;
+    bool                invert;
+
+    rtty_rx_text_cb_t   text_cb;
+    void                *user;
+};
+
+static const float      auto_rates[] = { 45.45f, 50.0f, 75.0f };
+static const uint16_t   auto_shifts[] = { 170, 425, 850 };
+
+static const char rtty_letters[32] = {'\0', 'E', '\n', 'A', ' ', 'S', 'I', 'U', '\0', 'D', 'R',
+                                      'J',  'N', 'F',  'C', 'K', 'T', 'Z', 'L', 'W',  'H', 'Y',
+                                      'P',  'Q', 'O',  'B', 'G', ' ', 'M', 'X', 'V',  ' '};
+
+static const char rtty_symbols[32] = {'\0', '3', '\n', '-', ' ', '\0', '8', '7', '\0', '$', '4',
+                                      '\'', ',', '!',  ':', '(', '5',  '"', ')', '2',  '#', '6',
+                                      '0',  '1', '9',  '?', '&', ' ',  '.', '/', ';',  ' '};
+
+static void demod_init(rtty_rx_t rx, demod_t *d, float rate, uint16_t shift) {
+    memset(d, 0, sizeof(*d));
+
+    d->rate = rate;
+    d->shift = shift;
+    d->symbol_samples = rx->decim_rate / rate / (float)SYMBOL_FACTOR + 0.5f;
+    d->step = rx->decim_rate / rate / (float)SYMBOL_LEN;
+    d->beta = 1.0f / (SNR_TIME * rate * SYMBOL_LEN);
+    d->letter = true;
+
+    d->fsk = fskdem_create(1, d->symbol_samples, (float)shift / rx->decim_rate / 2.0f);
+    d->buf = cbuffercf_create(d->symbol_samples + DECIM_BLOCK);
+    d->work = malloc(d->symbol_samples * sizeof(cfloat));
+    d->window = fft_registry_window_get(d->symbol_samples, FFT_WINDOW_HANN);
+}
+
+static void demod_done(demod_t *d) {
+    fskdem_destroy(d->fsk);
+    cbuffercf_destroy(d->buf);
+    free(d->work);
+    fft_registry_window_put(d->window);
+}
+
+rtty_rx_t rtty_rx_create(float rate, uint16_t shift, float sample_rate, rtty_rx_text_cb_t text_cb, void *user) {
+    rtty_rx_t rx = calloc(1, sizeof(struct rtty_rx_s));
+
+    rx->sample_rate = sample_rate;
+    rx->decim_rate = sample_rate / DECIM;
+    rx->text_cb = text_cb;
+    rx->user = user;
+    rx->bits = 5;
+    rx->switch_ratio = powf(10.0f, SWITCH_DB / 10.0f);
+
+    rx->nco = nco_crcf_create(LIQUID_NCO);
+    rx->decim = firdecim_crcf_create_kaiser(DECIM, 8, 60.0f);
+    firdecim_crcf_set_scale(rx->decim, 1.0f / DECIM);
+
+    if (rate == 0.0f) {
+        for (uint8_t r = 0; r < sizeof(auto_rates) / sizeof(auto_rates[0]); r++)
+            for (uint8_t s = 0; s < sizeof(auto_shifts) / sizeof(auto_shifts[0]); s++)
+                demod_init(rx, &rx->demods[rx->demods_count++], auto_rates[r], auto_shifts[s]);
+    } else {
+        demod_init(rx, &rx->demods[rx->demods_count++], rate, shift);
+    }
+
+    rx->best = &rx->demods[0];
+    rtty_rx_set_snr(rx, 3.0f);
+
+    return rx;
+}
+
+void rtty_rx_destroy(rtty_rx_t rx) {
+    nco_crcf_destroy(rx->nco);
+    firdecim_crcf_destroy(rx->decim);
+
+    for (uint8_t i = 0; i < rx->demods_count; i++)
+        demod_done(&rx->demods[i]);
+
+    free(rx);
+}
+
+void rtty_rx_set_center(rtty_rx_t rx, float freq) {
+    nco_crcf_set_phase(rx->nco, 0.0f);
+    nco_crcf_set_frequency(rx->nco, 2.0f * (float)M_PI * freq / rx->sample_rate);
+}
+
+void rtty_rx_set_snr(rtty_rx_t rx, float db) {
+    rx->threshold = powf(10.0f, db / 10.0f);
+}
+
+void rtty_rx_set_bits(rtty_rx_t rx, uint8_t bits) {
+    rx->bits = bits;
+}
+
+void rtty_rx_set_invert(rtty_rx_t rx, bool invert) {
+    rx->invert = invert;
+}
+
+static char baudot_decoder(demod_t *d, uint8_t c) {
+    if (c == RTTY_SYMBOL_CODE) {
+        d->letter = false;
+        return 0;
+    }
+
+    if (c == RTTY_LETTER_CODE) {
+        d->letter = true;
+        return 0;
+    }
+
+    return d->letter ? rtty_letters[c] : rtty_symbols[c];
+}
+
+static uint8_t symbol_at(demod_t *d, uint8_t i) {
+    return d->symbol[(d->symbol_head + i) & SYMBOL_MASK];
+}
+
+static bool is_mark_space(demod_t *d, uint8_t *correction) {
+    if (symbol_at(d, 0) && !symbol_at(d, SYMBOL_LEN - 1)) {
+        if (abs(SYMBOL_LEN / 2 - d->symbol_marks) < 1) {
+            *correction = d->symbol_marks;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool is_mark(demod_t *d) {
+    return symbol_at(d, SYMBOL_LEN / 2);
+}
+
+static void add_symbol(rtty_rx_t rx, demod_t *d, float mark, float space) {
+    uint8_t head = d->symbol_head;
+
+    d->symbol_mark[head] = mark;
+    d->symbol_space[head] = space;
+
+    /* Compare the mark and space energy of the last half symbol */
+
+    float   mark_sum = 0.0f;
+    float   space_sum = 0.0f;
+
+    for (uint8_t i = 0; i < SYMBOL_LEN / 2; i++) {
+        uint8_t n = (head - i) & SYMBOL_MASK;
+
+        mark_sum += d->symbol_mark[n];
+        space_sum += d->symbol_space[n];
+    }
+
+    if (d->symbol_cur == 0) {
+        if (mark_sum > space_sum * rx->threshold) {
+            d->symbol_cur = 1;
+        }
+    } else {
+        if (space_sum > mark_sum * rx->threshold) {
+            d->symbol_cur = 0;
+        }
+    }
+
+    d->symbol_marks += d->symbol_cur - d->symbol[head];
+    d->symbol[head] = d->symbol_cur;
+    d->symbol_head = (head + 1) & SYMBOL_MASK;
+
+    uint8_t correction;
+
+    switch (d->state) {
+        case RX_STATE_IDLE:
+            if (is_mark_space(d, &correction)) {
+                d->state   = RX_STATE_START;
+                d->counter = correction;
+            }
+            break;
+
+        case RX_STATE_START:
+            if (--d->counter == 0) {
+                if (!is_mark(d)) {
+                    d->state   = RX_STATE_DATA;
+                    d->counter = SYMBOL_LEN;
+                    d->bitcntr = 0;
+                    d->data    = 0;
+                } else {
+                    d->state = RX_STATE_IDLE;
+                }
+            }
+            break;
+
+        case RX_STATE_DATA:
+            if (--d->counter == 0) {
+                d->data |= is_mark(d) << d->bitcntr++;
+                d->counter = SYMBOL_LEN;
+            }
+
+            if (d->bitcntr == rx->bits)
+                d->state = RX_STATE_STOP;
+            break;
+
+        case RX_STATE_STOP:
+            if (--d->counter == 0) {
+                if (is_mark(d)) {
+                    char c = baudot_decoder(d, d->data);
+
+                    if (c && d == rx->best && rx->text_cb) {
+                        rx->text_cb(c, rx->user);
+                    }
+                }
+                d->state = RX_STATE_IDLE;
+            }
+            break;
+    }
+}
+
+static void demod_put(rtty_rx_t rx, demod_t *d, cfloat *samples, unsigned int n) {
+    cbuffercf_write(d->buf, samples, n);
+
+    while (cbuffercf_size(d->buf) >= d->symbol_samples) {
+        unsigned int    nr;
+        cfloat          *buf;
+
+        cbuffercf_read(d->buf, d->symbol_samples, &buf, &nr);
+
+        for (uint16_t i = 0; i < nr; i++)
+            d->work[i] = buf[i] * d->window[i];
+
+        fskdem_demodulate(d->fsk, d->work);
+
+        float mark = fskdem_get_symbol_energy(d->fsk, 0, 1);
+        float space = fskdem_get_symbol_energy(d->fsk, 1, 1);
+
+        if (rx->invert) {
+            float x = mark;
+
+            mark = space;
+            space = x;
+        }
+
+        d->diff += (fabsf(mark - space) - d->diff) * d->beta;
+        d->sum += (mark + space - d->sum) * d->beta;
+        add_symbol(rx, d, mark, space);
+
+        /* Fractional step keeps the bit timing exact */
+
+        d->step_acc += d->step;
+
+        unsigned int release = d->step_acc;
+
+        d->step_acc -= release;
+        cbuffercf_release(d->buf, release);
+    }
+}
+
+/**
+ * Tone contrast 0..1, an energy ratio growing with SNR. Compared in dB
+ * as a ratio, without a log per symbol
+ */
+static float contrast(const demod_t *d) {
+    return d->sum > 0.0f ? d->diff / d->sum : 0.0f;
+}
+
+static void select_best(rtty_rx_t rx) {
+    demod_t *max = rx->best;
+    float   max_contrast = contrast(rx->best);
+
+    for (uint8_t i = 0; i < rx->demods_count; i++) {
+        float x = contrast(&rx->demods[i]);
+
+        if (x > max_contrast) {
+            max = &rx->demods[i];
+            max_contrast = x;
+        }
+    }
+
+    if (max != rx->best && max_contrast > contrast(rx->best) * rx->switch_ratio) {
+        rx->best = max;
+    }
+}
+
+static void decim_flush(rtty_rx_t rx) {
+    for (uint8_t i = 0; i < rx->demods_count; i++)
+        demod_put(rx, &rx->demods[i], rx->decim_out, rx->decim_out_count);
+
+    rx->decim_out_count = 0;
+}
+
+void rtty_rx_process(rtty_rx_t rx, size_t n, cfloat *samples) {
+    for (size_t i = 0; i < n; i++) {
+        nco_crcf_mix_down(rx->nco, samples[i], &rx->decim_in[rx->decim_count++]);
+        nco_crcf_step(rx->nco);
+
+        if (rx->decim_count == DECIM) {
+            firdecim_crcf_execute(rx->decim, rx->decim_in, &rx->decim_out[rx->decim_out_count++]);
+            rx->decim_count = 0;
+
+            if (rx->decim_out_count == DECIM_BLOCK) {
+                decim_flush(rx);
+            }
+        }
+    }
+
+    if (rx->decim_out_count) {
+        decim_flush(rx);
+    }
+
+    if (rx->demods_count > 1) {
+        select_best(rx);
+    }
+}
+
+float rtty_rx_get_rate(rtty_rx_t rx) {
+    return rx->best->rate;
+}
+
+uint16_t rtty_rx_get_shift(rtty_rx_t rx) {
+    return rx->best->shift;
+}
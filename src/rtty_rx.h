@@ -0,0 +1,65 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2022-2023 Belousov Oleg aka R1CBU
+ */
+
+#pragma once
+
+#include "helpers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * RTTY receiver. Audio is mixed down from the center frequency and
+ * decimated once, then goes to a bank of FSK demodulators. With the
+ * auto rate the bank covers all rates and shifts, and the text comes
+ * only from the demodulator with the best tone contrast.
+ */
+
+typedef struct rtty_rx_s * rtty_rx_t;
+
+typedef void (*rtty_rx_text_cb_t)(char c, void *user);
+
+/**
+ * Rate in baud, zero for the auto rate and shift. Sample rate of the input audio
+ */
+rtty_rx_t rtty_rx_create(float rate, uint16_t shift, float sample_rate, rtty_rx_text_cb_t text_cb, void *user);
+void rtty_rx_destroy(rtty_rx_t rx);
+
+/**
+ * Audio frequency between the tones, Hz
+ */
+void rtty_rx_set_center(rtty_rx_t rx, float freq);
+
+/**
+ * Tone decision threshold, dB
+ */
+void rtty_rx_set_snr(rtty_rx_t rx, float db);
+
+void rtty_rx_set_bits(rtty_rx_t rx, uint8_t bits);
+
+/**
+ * Mark is the higher tone, as on USB. Otherwise the lower one
+ */
+void rtty_rx_set_invert(rtty_rx_t rx, bool invert);
+
+void rtty_rx_process(rtty_rx_t rx, size_t n, cfloat *samples);
+
+/**
+ * Rate and shift of the demodulator giving the text
+ */
+float rtty_rx_get_rate(rtty_rx_t rx);
+uint16_t rtty_rx_get_shift(rtty_rx_t rx);
+
+#ifdef __cplusplus
+}
+#endif
@@ -7,37 +7,130 @@
  */
 
 #include "scheduler.h"
+#include "wakeup.h"
 
-#include <queue>
-#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 
 extern "C" {
     #include "lvgl/lvgl.h"
 }
 
-#define QUEUE_MAX_SIZE  64
+#define QUEUE_SIZE      64                      /* Power of two */
+#define QUEUE_MASK      (QUEUE_SIZE - 1)
+#define PENDING_SIZE    32                      /* Distinct tasks without arguments */
 
-struct item_t {
-    scheduler_fn_t fn;
-    void    *arg;
+/*
+ * Bounded MPSC ring (D. Vyukov). Cell sequence is equal to the position
+ * when the cell is free for a producer, position + 1 when filled for the
+ * consumer. Producers claim a position by CAS and never wait for each
+ * other. Sequence is kept minus the cell index, so zeroed memory is the
+ * initial state
+ */
+
+struct cell_t {
+    std::atomic<size_t> seq;
+    scheduler_fn_t      fn;
+    int                 pending;                /* Slot in pending[] or -1 */
+    size_t              arg_size;
+    alignas(max_align_t) uint8_t arg[SCHEDULER_ARG_SIZE];
+};
+
+/* Tasks without arguments are put once until the main thread runs them */
+
+struct pending_t {
+    std::atomic<scheduler_fn_t> fn;
+    std::atomic<bool>           queued;
 };
 
-static std::queue<item_t> queue;
-static std::mutex m_mutex;
+static cell_t               cells[QUEUE_SIZE];
+static std::atomic<size_t>  enqueue_pos;
+static size_t               dequeue_pos;
+static pending_t            pending[PENDING_SIZE];
+
+static std::atomic<size_t>  overflows;
+static std::atomic<size_t>  coalesced;
+static size_t               overflows_logged;
+
+/**
+ * Slot of the task, taken on first use and kept forever
+ */
+static int pending_slot(scheduler_fn_t fn) {
+    size_t start = ((uintptr_t) fn >> 4) % PENDING_SIZE;
+
+    for (size_t i = 0; i < PENDING_SIZE; i++) {
+        pending_t       *p = &pending[(start + i) % PENDING_SIZE];
+        scheduler_fn_t  cur = p->fn.load(std::memory_order_acquire);
+
+        if (cur == nullptr && p->fn.compare_exchange_strong(cur, fn, std::memory_order_acq_rel)) {
+            return p - pending;
+        }
+
+        if (cur == fn) {
+            return p - pending;
+        }
+    }
+
+    return -1;
+}
+
+static bool push(scheduler_fn_t fn, const void *arg, size_t arg_size, int slot) {
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+
+    while (true) {
+        size_t      index = pos & QUEUE_MASK;
+        cell_t      *cell = &cells[index];
+        size_t      seq = cell->seq.load(std::memory_order_acquire) + index;
+        intptr_t    diff = (intptr_t) seq - (intptr_t) pos;
+
+        if (diff == 0) {
+            if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell->fn = fn;
+                cell->pending = slot;
+                cell->arg_size = arg_size;
+
+                if (arg_size) {
+                    memcpy(cell->arg, arg, arg_size);
+                }
+
+                cell->seq.store(pos + 1 - index, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
 
 void scheduler_put(scheduler_fn_t fn, void * arg, size_t arg_size) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (queue.size() > QUEUE_MAX_SIZE){
-        LV_LOG_ERROR("Scheduler queue overflow");
+    if (arg_size > SCHEDULER_ARG_SIZE) {
+        LV_LOG_ERROR("Scheduler arg is too big: %zu", arg_size);
         return;
     }
-    void *arg_copy = nullptr;
-    if (arg_size) {
-        arg_copy = malloc(arg_size);
-        memcpy(arg_copy, arg, arg_size);
+
+    int slot = -1;
+
+    if (arg_size == 0) {
+        slot = pending_slot(fn);
+
+        if (slot >= 0 && pending[slot].queued.exchange(true, std::memory_order_acq_rel)) {
+            coalesced.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    if (push(fn, arg, arg_size, slot)) {
+        wakeup_signal();
+    } else {
+        if (slot >= 0) {
+            pending[slot].queued.store(false, std::memory_order_release);
+        }
+        overflows.fetch_add(1, std::memory_order_relaxed);
     }
-    item_t item = {fn, arg_copy};
-    queue.push(item);
 }
 
 void scheduler_put_noargs(scheduler_fn_t fn) {
@@ -45,16 +138,39 @@ void scheduler_put_noargs(scheduler_fn_t fn) {
 }
 
 void scheduler_work() {
-    item_t item;
-    while (!queue.empty()) {
-        {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            item = queue.front();
-            queue.pop();
+    while (true) {
+        size_t  index = dequeue_pos & QUEUE_MASK;
+        cell_t  *cell = &cells[index];
+        size_t  seq = cell->seq.load(std::memory_order_acquire) + index;
+
+        if (seq != dequeue_pos + 1) {
+            break;
         }
-        item.fn(item.arg);
-        if (item.arg) {
-            free(item.arg);
+
+        /* Put during the call queues it again */
+
+        if (cell->pending >= 0) {
+            pending[cell->pending].queued.store(false, std::memory_order_release);
         }
+
+        cell->fn(cell->arg_size ? cell->arg : NULL);
+
+        cell->seq.store(dequeue_pos + QUEUE_SIZE - index, std::memory_order_release);
+        dequeue_pos++;
     }
+
+    size_t total = overflows.load(std::memory_order_relaxed);
+
+    if (total != overflows_logged) {
+        LV_LOG_WARN("Scheduler queue overflow, %zu tasks lost", total - overflows_logged);
+        overflows_logged = total;
+    }
+}
+
+size_t scheduler_get_overflows() {
+    return overflows.load(std::memory_order_relaxed);
+}
+
+size_t scheduler_get_coalesced() {
+    return coalesced.load(std::memory_order_relaxed);
 }
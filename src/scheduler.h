@@ -10,6 +10,14 @@
 
 #include <stddef.h>
 
+/*
+ * Tasks from radio, CAT, audio and decoder threads to the main thread.
+ * Producers never block and never allocate: the argument is copied into
+ * the queue cell. On a full queue the task is dropped and counted
+ */
+
+#define SCHEDULER_ARG_SIZE  256
+
 typedef void (* scheduler_fn_t)(void *);
 
 #ifdef __cplusplus
@@ -17,13 +25,14 @@ extern "C" {
 #endif
 
 /**
- * Schedule execution function in main thread
+ * Schedule execution function in main thread, arg_size up to SCHEDULER_ARG_SIZE
  */
 void scheduler_put(scheduler_fn_t fn, void *arg, size_t arg_size);
 
 
 /**
- * Schedule execution function without arguments in main thread
+ * Schedule execution function without arguments in main thread.
+ * Function already waiting in the queue is not added again
  */
 void scheduler_put_noargs(scheduler_fn_t fn);
 
@@ -32,6 +41,12 @@ void scheduler_put_noargs(scheduler_fn_t fn);
  */
 void scheduler_work();
 
+/**
+ * Tasks dropped on the full queue and merged with the pending ones
+ */
+size_t scheduler_get_overflows();
+size_t scheduler_get_coalesced();
+
 #ifdef __cplusplus
 }
 #endif
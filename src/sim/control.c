@@ -0,0 +1,213 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "sim.h"
+
+#include "lvgl/lvgl.h"
+
+#define SIM_SET(field, x) \
+    pthread_mutex_lock(&sim.mux); \
+    sim.field = (x); \
+    pthread_mutex_unlock(&sim.mux);
+
+/* Setters of the base board features, which are not simulated */
+#define SIM_IGNORE(name, type) \
+    void x6200_control_##name(type x) { (void) x; }
+
+sim_state_t sim = {
+    .mux = PTHREAD_MUTEX_INITIALIZER,
+    .freq = { 14074000, 14074000 },
+    .mode = { x6200_mode_usb, x6200_mode_usb },
+    .rfg = 100,
+    .filter_low = 50,
+    .filter_high = 2950,
+    .txpwr = 5.0f,
+};
+
+bool x6200_control_init() {
+    LV_LOG_USER("Simulated base board");
+    return true;
+}
+
+void x6200_control_idle() {
+}
+
+void x6200_control_poweroff() {
+    LV_LOG_USER("Simulated power off");
+    SIM_SET(poweroff, true);
+}
+
+void x6200_control_cmd(x6200_cmd_enum_t cmd, uint32_t arg) {
+    switch (cmd) {
+        case x6200_atu_network:
+            SIM_SET(atu_network, arg);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* VFO */
+
+void x6200_control_vfo_set(x6200_vfo_t vfo) {
+    SIM_SET(vfo, vfo);
+}
+
+void x6200_control_vfo_freq_set(x6200_vfo_t vfo, uint32_t freq) {
+    SIM_SET(freq[vfo], freq);
+}
+
+void x6200_control_vfo_mode_set(x6200_vfo_t vfo, x6200_mode_t mode) {
+    SIM_SET(mode[vfo], mode);
+}
+
+void x6200_control_vfo_att_set(x6200_vfo_t vfo, x6200_att_t att) {
+    SIM_SET(att[vfo], att);
+}
+
+void x6200_control_vfo_pre_set(x6200_vfo_t vfo, x6200_pre_t pre) {
+    SIM_SET(pre[vfo], pre);
+}
+
+void x6200_control_vfo_agc_set(x6200_vfo_t vfo, x6200_agc_t agc) {
+}
+
+void x6200_control_split_set(bool on) {
+    SIM_SET(split, on);
+}
+
+void x6200_control_rfg_set(uint8_t rfg) {
+    SIM_SET(rfg, rfg);
+}
+
+/* RX */
+
+void x6200_control_rx_filter_set(int16_t low, int16_t high) {
+    pthread_mutex_lock(&sim.mux);
+    sim.filter_low = low;
+    sim.filter_high = high;
+    pthread_mutex_unlock(&sim.mux);
+}
+
+void x6200_control_rx_filter_set_low(int16_t low) {
+    SIM_SET(filter_low, low);
+}
+
+void x6200_control_rx_filter_set_high(int16_t high) {
+    SIM_SET(filter_high, high);
+}
+
+void x6200_control_fft_dec_set(uint8_t dec) {
+    SIM_SET(fft_dec, dec);
+}
+
+void x6200_control_fft_zoom_cw_set(uint8_t zoom) {
+    SIM_SET(fft_zoom_cw, zoom);
+}
+
+void x6200_control_rit_set(int16_t rit) {
+    SIM_SET(rit, rit);
+}
+
+void x6200_control_xit_set(int16_t xit) {
+    SIM_SET(xit, xit);
+}
+
+SIM_IGNORE(rxvol_set, uint8_t)
+SIM_IGNORE(sql_set, uint8_t)
+SIM_IGNORE(sql_fm_set, uint8_t)
+SIM_IGNORE(sql_enable_set, bool)
+SIM_IGNORE(agc_hang_set, bool)
+SIM_IGNORE(agc_knee_set, int8_t)
+SIM_IGNORE(agc_slope_set, uint8_t)
+SIM_IGNORE(dnf_set, x6200_dnf_mode_t)
+SIM_IGNORE(dnf_center_set, uint16_t)
+SIM_IGNORE(dnf_width_set, uint16_t)
+SIM_IGNORE(nb_set, bool)
+SIM_IGNORE(nb_level_set, uint8_t)
+SIM_IGNORE(nb_width_set, uint8_t)
+SIM_IGNORE(nr_set, bool)
+SIM_IGNORE(nr_level_set, uint8_t)
+
+SIM_IGNORE(rx_eq_set, bool)
+SIM_IGNORE(rx_eq_p1_set, int8_t)
+SIM_IGNORE(rx_eq_p2_set, int8_t)
+SIM_IGNORE(rx_eq_p3_set, int8_t)
+SIM_IGNORE(rx_eq_p4_set, int8_t)
+SIM_IGNORE(rx_eq_p5_set, int8_t)
+SIM_IGNORE(rx_eq_wfm_set, bool)
+SIM_IGNORE(rx_eq_wfm_p1_set, int8_t)
+SIM_IGNORE(rx_eq_wfm_p2_set, int8_t)
+SIM_IGNORE(rx_eq_wfm_p3_set, int8_t)
+SIM_IGNORE(rx_eq_wfm_p4_set, int8_t)
+SIM_IGNORE(rx_eq_wfm_p5_set, int8_t)
+
+/* TX */
+
+void x6200_control_txpwr_set(float pwr) {
+    SIM_SET(txpwr, pwr);
+}
+
+void x6200_control_ptt_set(bool on) {
+    SIM_SET(ptt, on);
+}
+
+void x6200_control_modem_set(bool on) {
+    SIM_SET(modem, on);
+}
+
+void x6200_control_swrscan_set(bool on) {
+    SIM_SET(swrscan, on);
+}
+
+void x6200_control_atu_set(bool on) {
+    SIM_SET(atu_on, on);
+}
+
+void x6200_control_atu_tune(bool on) {
+    SIM_SET(atu_tune, on);
+}
+
+SIM_IGNORE(record_set, bool)
+SIM_IGNORE(comp_set, bool)
+SIM_IGNORE(comp_level_set, x6200_comp_level_t)
+SIM_IGNORE(mic_set, x6200_mic_sel_t)
+SIM_IGNORE(hmic_set, uint8_t)
+SIM_IGNORE(imic_set, uint8_t)
+SIM_IGNORE(vox_set, bool)
+SIM_IGNORE(vox_ag_set, uint8_t)
+SIM_IGNORE(vox_delay_set, uint16_t)
+SIM_IGNORE(vox_gain_set, uint8_t)
+SIM_IGNORE(mic_eq_set, bool)
+SIM_IGNORE(mic_eq_p1_set, int8_t)
+SIM_IGNORE(mic_eq_p2_set, int8_t)
+SIM_IGNORE(mic_eq_p3_set, int8_t)
+SIM_IGNORE(mic_eq_p4_set, int8_t)
+SIM_IGNORE(mic_eq_p5_set, int8_t)
+
+/* Key */
+
+SIM_IGNORE(key_speed_set, uint8_t)
+SIM_IGNORE(key_mode_set, x6200_key_mode_t)
+SIM_IGNORE(iambic_mode_set, x6200_iambic_mode_t)
+SIM_IGNORE(key_tone_set, uint16_t)
+SIM_IGNORE(key_vol_set, uint16_t)
+SIM_IGNORE(key_train_set, bool)
+SIM_IGNORE(qsk_time_set, uint16_t)
+SIM_IGNORE(key_ratio_set, float)
+
+/* System */
+
+SIM_IGNORE(charger_set, bool)
+SIM_IGNORE(bias_drive_set, uint16_t)
+SIM_IGNORE(bias_final_set, uint16_t)
+SIM_IGNORE(spmode_set, bool)
+SIM_IGNORE(linein_set, uint8_t)
+SIM_IGNORE(lineout_set, uint8_t)
+SIM_IGNORE(monitor_level_set, uint8_t)
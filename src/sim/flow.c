@@ -0,0 +1,361 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+/*
+ * Synthetic flow of the base board packets. Spectrum is made from noise and
+ * a list of carriers, packets are produced with the fixed rate.
+ *
+ * Environment:
+ *   X6200_SIM_SIGNALS  list of "freq:dBm[:width]" separated by ',' (Hz, dBm, Hz)
+ *   X6200_SIM_NOISE    noise floor, dBm (default -120)
+ *   X6200_SIM_RATE     packets per second (default 25)
+ *   X6200_SIM_ANT      antenna resonance, Hz. SWR grows off resonance (default 14200000)
+ *   X6200_SIM_SEED     noise seed
+ */
+
+#include <aether_radio/x6200_control/low/flow.h>
+
+#include "sim.h"
+
+#include "lvgl/lvgl.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FFT_FULL_WIDTH      384000
+#define MAX_SIGNALS         64
+#define SAMPLE_OFFSET       126         /* radio.c: samples[i] - 126.0f */
+#define ATU_TUNE_TIME_MS    1500
+#define STAT_PERIOD_MS      10000
+
+typedef struct {
+    uint32_t    freq;
+    float       level;
+    uint32_t    width;
+} signal_t;
+
+static signal_t         signals[MAX_SIGNALS];
+static size_t           signals_count = 0;
+static float            noise = -120.0f;
+static uint32_t         rate = 25;
+static uint32_t         ant_freq = 14200000;
+static unsigned int     seed = 1;
+
+static struct timespec  next_time;
+static uint64_t         period_ns;
+
+static uint32_t         atu_packets = 0;
+
+/* Statistics */
+
+static uint64_t         stat_start;
+static uint64_t         stat_return;
+static uint64_t         stat_busy;
+static uint64_t         stat_busy_max;
+static uint32_t         stat_packets;
+static uint32_t         stat_late;
+
+static uint64_t time_ns(const struct timespec *t) {
+    return (uint64_t) t->tv_sec * 1000000000L + t->tv_nsec;
+}
+
+static uint64_t now_ns() {
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return time_ns(&t);
+}
+
+static void parse_signals(const char *str) {
+    char    *copy = strdup(str);
+    char    *save = NULL;
+
+    for (char *item = strtok_r(copy, ",", &save); item && signals_count < MAX_SIGNALS; item = strtok_r(NULL, ",", &save)) {
+        signal_t    *s = &signals[signals_count];
+        unsigned    freq, width = 0;
+        float       level;
+
+        if (sscanf(item, "%u:%f:%u", &freq, &level, &width) < 2) {
+            LV_LOG_WARN("Wrong signal: %s", item);
+            continue;
+        }
+
+        s->freq = freq;
+        s->level = level;
+        s->width = width;
+        signals_count++;
+    }
+
+    free(copy);
+}
+
+static float rand_uniform() {
+    return (float) rand_r(&seed) / RAND_MAX;
+}
+
+/**
+ * Rayleigh distributed noise level, dB around the floor
+ */
+static float noise_db() {
+    float x = rand_uniform();
+
+    if (x < 1e-6f) {
+        x = 1e-6f;
+    }
+
+    return 10.0f * log10f(-logf(x));
+}
+
+static float signal_db(const signal_t *s, float offset, float bin_width) {
+    float width = s->width > bin_width ? s->width : bin_width;
+    float x = offset / width;
+
+    return s->level - 6.0f * x * x;
+}
+
+static float calc_swr(uint32_t freq, bool atu_loaded) {
+    if (atu_loaded) {
+        return 1.1f;
+    }
+
+    float d = fabsf((float) freq - ant_freq) / ant_freq;
+
+    return 1.2f + d * 40.0f;
+}
+
+static uint16_t scale(float x) {
+    x = x * 10.0f;
+
+    return x < 0.0f ? 0 : (x > 65535.0f ? 65535 : x);
+}
+
+static void make_spectrum(x6200_flow_t *pack, const sim_state_t *s, bool tx) {
+    x6200_vfo_t     vfo = s->vfo;
+    x6200_mode_t    mode = s->mode[vfo];
+    int32_t         center = s->freq[vfo];
+    uint32_t        span = FFT_FULL_WIDTH >> s->fft_dec;
+    float           gain = 0.0f;
+
+    static const signal_t tx_signal = { .level = -20.0f, .width = 1200 };
+
+    if (mode == x6200_mode_cw || mode == x6200_mode_cwr) {
+        span >>= s->fft_zoom_cw;
+    }
+
+    if (s->att[vfo] == x6200_att_on) {
+        gain -= 20.0f;
+    }
+
+    if (s->pre[vfo] == x6200_pre_on) {
+        gain += 10.0f;
+    }
+
+    gain += (s->rfg - 100) * 0.3f;
+
+    float   bin_width = (float) span / X6200_FLOW_SAMPLES;
+    float   start = center - span / 2.0f;
+    float   noise_pwr = powf(10.0f, (noise + gain) * 0.1f);
+
+    for (size_t i = 0; i < X6200_FLOW_SAMPLES; i++) {
+        float freq = start + i * bin_width;
+        float pwr = noise_pwr * powf(10.0f, noise_db() * 0.1f);
+
+        if (tx) {
+            pwr += powf(10.0f, signal_db(&tx_signal, freq - center, bin_width) * 0.1f);
+        } else {
+            for (size_t n = 0; n < signals_count; n++) {
+                float db = signal_db(&signals[n], freq - signals[n].freq, bin_width) + gain;
+
+                if (db > noise - 30.0f) {
+                    pwr += powf(10.0f, db * 0.1f);
+                }
+            }
+        }
+
+        int32_t x = lroundf(10.0f * log10f(pwr)) + SAMPLE_OFFSET;
+
+        pack->samples[i] = x < 0 ? 0 : (x > 255 ? 255 : x);
+    }
+
+    /* S-meter: strongest signal in the passband */
+
+    int32_t low, high;
+
+    if (mode == x6200_mode_lsb || mode == x6200_mode_lsb_dig || mode == x6200_mode_cwr) {
+        low = center - s->filter_high;
+        high = center - s->filter_low;
+    } else {
+        low = center + s->filter_low;
+        high = center + s->filter_high;
+    }
+
+    float dbm = noise + gain + 10.0f * log10f((high - low) / bin_width + 1.0f);
+
+    for (size_t n = 0; n < signals_count; n++) {
+        const signal_t *sig = &signals[n];
+
+        if (sig->freq + sig->width / 2 >= low && sig->freq - sig->width / 2 <= high && sig->level + gain > dbm) {
+            dbm = sig->level + gain;
+        }
+    }
+
+    int32_t x = 4 - lroundf(dbm);   /* radio.c: -(int16_t)pack->dbm + 4 */
+
+    pack->dbm = x < 0 ? 0 : (x > 255 ? 255 : x);
+}
+
+static void update_stat(uint64_t now) {
+    if (stat_return) {
+        uint64_t busy = now - stat_return;
+
+        stat_busy += busy;
+
+        if (busy > stat_busy_max) {
+            stat_busy_max = busy;
+        }
+    }
+
+    if (now - stat_start > STAT_PERIOD_MS * 1000000L) {
+        if (stat_packets) {
+            LV_LOG_USER("Sim flow: %u packets, %u late, tick avg %.3f ms, max %.3f ms",
+                stat_packets, stat_late,
+                stat_busy / 1000000.0 / stat_packets, stat_busy_max / 1000000.0);
+        }
+
+        stat_start = now;
+        stat_busy = 0;
+        stat_busy_max = 0;
+        stat_packets = 0;
+        stat_late = 0;
+    }
+}
+
+bool x6200_flow_init() {
+    const char *str;
+
+    if ((str = getenv("X6200_SIM_SIGNALS"))) {
+        parse_signals(str);
+    } else {
+        parse_signals("14074000:-73:50,14074900:-95:50,14075600:-85:50,14030000:-80,14200000:-60:2400");
+    }
+
+    if ((str = getenv("X6200_SIM_NOISE"))) {
+        noise = atof(str);
+    }
+
+    if ((str = getenv("X6200_SIM_RATE")) && atoi(str) > 0) {
+        rate = atoi(str);
+    }
+
+    if ((str = getenv("X6200_SIM_ANT"))) {
+        ant_freq = atoi(str);
+    }
+
+    if ((str = getenv("X6200_SIM_SEED"))) {
+        seed = atoi(str);
+    }
+
+    period_ns = 1000000000L / rate;
+    clock_gettime(CLOCK_MONOTONIC, &next_time);
+    stat_start = time_ns(&next_time);
+
+    LV_LOG_USER("Simulated flow: %zu signals, noise %.1f dBm, %u packets/s", signals_count, noise, rate);
+
+    return true;
+}
+
+void x6200_flow_restart() {
+    clock_gettime(CLOCK_MONOTONIC, &next_time);
+}
+
+/**
+ * Wait for the next packet time and synthesize it
+ */
+bool x6200_flow_read(x6200_flow_t *pack) {
+    uint64_t now = now_ns();
+
+    update_stat(now);
+
+    uint64_t next = time_ns(&next_time) + period_ns;
+
+    next_time.tv_sec = next / 1000000000L;
+    next_time.tv_nsec = next % 1000000000L;
+
+    if (now > next) {
+        stat_late++;
+        clock_gettime(CLOCK_MONOTONIC, &next_time);
+    } else {
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_time, NULL);
+    }
+
+    sim_state_t s;
+
+    pthread_mutex_lock(&sim.mux);
+    s = sim;
+
+    if (sim.atu_tune) {
+        if (atu_packets < ATU_TUNE_TIME_MS * rate / 1000) {
+            atu_packets++;
+        }
+    } else {
+        atu_packets = 0;
+    }
+    pthread_mutex_unlock(&sim.mux);
+
+    memset(pack, 0, sizeof(*pack));
+
+    bool atu_done = s.atu_tune && atu_packets >= ATU_TUNE_TIME_MS * rate / 1000;
+    bool tx = !s.poweroff && (s.ptt || s.modem || s.swrscan || (s.atu_tune && !atu_done));
+
+    make_spectrum(pack, &s, tx);
+
+    x6200_vfo_t vfo = (s.split && tx) ? (s.vfo == X6200_VFO_A ? X6200_VFO_B : X6200_VFO_A) : s.vfo;
+    uint32_t    freq = s.freq[vfo] + s.xit;
+    float       swr = calc_swr(freq, s.atu_on && s.atu_network);
+
+    pack->flag.tx = tx;
+    pack->flag.atu_status = atu_done;
+    pack->atu_params = atu_done ? (freq / 1000) | 0x80000000 : 0;
+
+    if (tx) {
+        float pwr = s.txpwr;
+
+        if (s.atu_tune || s.swrscan) {
+            pwr = 3.0f;
+        }
+
+        /* Power is folded back on high SWR */
+        if (swr > 3.0f) {
+            pwr = pwr * 3.0f / swr;
+        }
+
+        pack->tx_power = scale(pwr);
+        if (s.atu_tune) {
+            float done = (float) atu_packets / (ATU_TUNE_TIME_MS * rate / 1000);
+
+            swr += (1.1f - swr) * done;
+        }
+
+        pack->vswr = scale(swr);
+        pack->alc_level = scale(pwr > 8.0f ? (pwr - 8.0f) * 0.5f : 0.0f);
+    }
+
+    pack->flag.vext = 1;
+    pack->vext = 138;
+    pack->vbat = 82;
+    pack->batcap = 100;
+    pack->hkey = 0;
+
+    stat_packets++;
+    stat_return = now_ns();
+
+    return true;
+}
@@ -0,0 +1,24 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include <aether_radio/x6200_control/low/gpio.h>
+
+#include "lvgl/lvgl.h"
+
+static int pins[x6200_pin_last];
+
+bool x6200_gpio_init() {
+    return true;
+}
+
+void x6200_gpio_set(x6200_pin_t pin, int value) {
+    if (pin < x6200_pin_last && pins[pin] != value) {
+        LV_LOG_INFO("Simulated GPIO %i = %i", pin, value);
+        pins[pin] = value;
+    }
+}
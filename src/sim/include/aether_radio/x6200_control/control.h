@@ -0,0 +1,186 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+/*
+ * Simulated x6200_control API. Mirrors the part of the aether_x6200_control
+ * library used by the GUI, selected with -DSIMULATOR=ON
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    X6200_VFO_A = 0,
+    X6200_VFO_B
+} x6200_vfo_t;
+
+typedef enum {
+    x6200_mode_lsb = 0,
+    x6200_mode_lsb_dig,
+    x6200_mode_usb,
+    x6200_mode_usb_dig,
+    x6200_mode_cw,
+    x6200_mode_cwr,
+    x6200_mode_am,
+    x6200_mode_nfm,
+    x6200_mode_sam,
+    x6200_mode_wfm,
+} x6200_mode_t;
+
+typedef enum {
+    x6200_agc_off = 0,
+    x6200_agc_slow,
+    x6200_agc_fast,
+    x6200_agc_auto
+} x6200_agc_t;
+
+typedef enum {
+    x6200_att_off = 0,
+    x6200_att_on
+} x6200_att_t;
+
+typedef enum {
+    x6200_pre_off = 0,
+    x6200_pre_on
+} x6200_pre_t;
+
+typedef enum {
+    x6200_mic_builtin = 0,
+    x6200_mic_handle,
+    x6200_mic_auto
+} x6200_mic_sel_t;
+
+typedef enum {
+    x6200_key_manual = 0,
+    x6200_key_auto_left,
+    x6200_key_auto_right
+} x6200_key_mode_t;
+
+typedef enum {
+    x6200_iambic_a = 0,
+    x6200_iambic_b
+} x6200_iambic_mode_t;
+
+typedef enum {
+    x6200_dnf_off = 0,
+    x6200_dnf_manual,
+    x6200_dnf_auto
+} x6200_dnf_mode_t;
+
+typedef enum {
+    x6200_comp_1_1 = 0,
+    x6200_comp_1_2,
+    x6200_comp_1_4,
+    x6200_comp_1_8
+} x6200_comp_level_t;
+
+typedef enum {
+    x6200_atu_network = 0,
+} x6200_cmd_enum_t;
+
+bool x6200_control_init();
+void x6200_control_idle();
+void x6200_control_poweroff();
+void x6200_control_cmd(x6200_cmd_enum_t cmd, uint32_t arg);
+
+/* VFO */
+
+void x6200_control_vfo_set(x6200_vfo_t vfo);
+void x6200_control_vfo_freq_set(x6200_vfo_t vfo, uint32_t freq);
+void x6200_control_vfo_mode_set(x6200_vfo_t vfo, x6200_mode_t mode);
+void x6200_control_vfo_agc_set(x6200_vfo_t vfo, x6200_agc_t agc);
+void x6200_control_vfo_att_set(x6200_vfo_t vfo, x6200_att_t att);
+void x6200_control_vfo_pre_set(x6200_vfo_t vfo, x6200_pre_t pre);
+void x6200_control_split_set(bool on);
+void x6200_control_rfg_set(uint8_t rfg);
+
+/* RX */
+
+void x6200_control_rx_filter_set(int16_t low, int16_t high);
+void x6200_control_rx_filter_set_low(int16_t low);
+void x6200_control_rx_filter_set_high(int16_t high);
+void x6200_control_rxvol_set(uint8_t vol);
+void x6200_control_sql_set(uint8_t sql);
+void x6200_control_sql_fm_set(uint8_t sql);
+void x6200_control_sql_enable_set(bool on);
+void x6200_control_fft_dec_set(uint8_t dec);
+void x6200_control_fft_zoom_cw_set(uint8_t zoom);
+void x6200_control_agc_hang_set(bool on);
+void x6200_control_agc_knee_set(int8_t knee);
+void x6200_control_agc_slope_set(uint8_t slope);
+void x6200_control_dnf_set(x6200_dnf_mode_t mode);
+void x6200_control_dnf_center_set(uint16_t freq);
+void x6200_control_dnf_width_set(uint16_t hz);
+void x6200_control_nb_set(bool on);
+void x6200_control_nb_level_set(uint8_t level);
+void x6200_control_nb_width_set(uint8_t hz);
+void x6200_control_nr_set(bool on);
+void x6200_control_nr_level_set(uint8_t level);
+void x6200_control_rit_set(int16_t rit);
+void x6200_control_xit_set(int16_t xit);
+
+void x6200_control_rx_eq_set(bool on);
+void x6200_control_rx_eq_p1_set(int8_t gain);
+void x6200_control_rx_eq_p2_set(int8_t gain);
+void x6200_control_rx_eq_p3_set(int8_t gain);
+void x6200_control_rx_eq_p4_set(int8_t gain);
+void x6200_control_rx_eq_p5_set(int8_t gain);
+void x6200_control_rx_eq_wfm_set(bool on);
+void x6200_control_rx_eq_wfm_p1_set(int8_t gain);
+void x6200_control_rx_eq_wfm_p2_set(int8_t gain);
+void x6200_control_rx_eq_wfm_p3_set(int8_t gain);
+void x6200_control_rx_eq_wfm_p4_set(int8_t gain);
+void x6200_control_rx_eq_wfm_p5_set(int8_t gain);
+
+/* TX */
+
+void x6200_control_txpwr_set(float pwr);
+void x6200_control_ptt_set(bool on);
+void x6200_control_modem_set(bool on);
+void x6200_control_record_set(bool on);
+void x6200_control_swrscan_set(bool on);
+void x6200_control_atu_set(bool on);
+void x6200_control_atu_tune(bool on);
+void x6200_control_comp_set(bool on);
+void x6200_control_comp_level_set(x6200_comp_level_t level);
+void x6200_control_mic_set(x6200_mic_sel_t mic);
+void x6200_control_hmic_set(uint8_t level);
+void x6200_control_imic_set(uint8_t level);
+void x6200_control_vox_set(bool on);
+void x6200_control_vox_ag_set(uint8_t level);
+void x6200_control_vox_delay_set(uint16_t delay);
+void x6200_control_vox_gain_set(uint8_t level);
+void x6200_control_mic_eq_set(bool on);
+void x6200_control_mic_eq_p1_set(int8_t gain);
+void x6200_control_mic_eq_p2_set(int8_t gain);
+void x6200_control_mic_eq_p3_set(int8_t gain);
+void x6200_control_mic_eq_p4_set(int8_t gain);
+void x6200_control_mic_eq_p5_set(int8_t gain);
+
+/* Key */
+
+void x6200_control_key_speed_set(uint8_t wpm);
+void x6200_control_key_mode_set(x6200_key_mode_t mode);
+void x6200_control_iambic_mode_set(x6200_iambic_mode_t mode);
+void x6200_control_key_tone_set(uint16_t tone);
+void x6200_control_key_vol_set(uint16_t vol);
+void x6200_control_key_train_set(bool on);
+void x6200_control_qsk_time_set(uint16_t time);
+void x6200_control_key_ratio_set(float ratio);
+
+/* System */
+
+void x6200_control_charger_set(bool on);
+void x6200_control_bias_drive_set(uint16_t x);
+void x6200_control_bias_final_set(uint16_t x);
+void x6200_control_spmode_set(bool on);
+void x6200_control_linein_set(uint8_t level);
+void x6200_control_lineout_set(uint8_t level);
+void x6200_control_monitor_level_set(uint8_t level);
@@ -0,0 +1,74 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define X6200_FLOW_SAMPLES  512
+
+typedef enum {
+    X6200_HKEY_1 = 1,
+    X6200_HKEY_2,
+    X6200_HKEY_3,
+    X6200_HKEY_4,
+    X6200_HKEY_5,
+    X6200_HKEY_6,
+    X6200_HKEY_7,
+    X6200_HKEY_8,
+    X6200_HKEY_9,
+    X6200_HKEY_DOT,
+    X6200_HKEY_0,
+    X6200_HKEY_CE,
+    X6200_HKEY_FINP,
+    X6200_HKEY_SPCH,
+    X6200_HKEY_TUNER,
+    X6200_HKEY_XFC,
+    X6200_HKEY_UP,
+    X6200_HKEY_DOWN,
+    X6200_HKEY_VM,
+    X6200_HKEY_NW,
+    X6200_HKEY_F1,
+    X6200_HKEY_F2,
+    X6200_HKEY_MODE,
+    X6200_HKEY_FIL,
+    X6200_HKEY_GENE,
+} x6200_hkey_t;
+
+typedef struct {
+    uint8_t     samples[X6200_FLOW_SAMPLES];
+
+    struct {
+        uint32_t    tx          : 1;
+        uint32_t    charging    : 1;
+        uint32_t    vext        : 1;
+        uint32_t    power_key   : 1;
+        uint32_t    resync      : 1;
+        uint32_t    atu_status  : 1;
+        uint32_t    sql_mute    : 1;
+        uint32_t    sql_fm_mute : 1;
+        uint32_t    flag12      : 1;
+        uint32_t    flag13      : 1;
+        uint32_t    flag15      : 1;
+    } flag;
+
+    uint8_t     dbm;            /* -dBm */
+    uint16_t    vext;           /* 0.1 V */
+    uint16_t    vbat;           /* 0.1 V */
+    uint8_t     batcap;         /* % */
+    uint16_t    tx_power;       /* 0.1 W */
+    uint16_t    vswr;           /* 0.1 */
+    uint16_t    alc_level;      /* 0.1 */
+    uint32_t    hkey;
+    uint32_t    atu_params;
+} x6200_flow_t;
+
+bool x6200_flow_init();
+bool x6200_flow_read(x6200_flow_t *pack);
+void x6200_flow_restart();
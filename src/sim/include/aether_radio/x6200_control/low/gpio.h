@@ -0,0 +1,25 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    x6200_pin_bb_reset = 0,
+    x6200_pin_light,
+    x6200_pin_morse_key,
+    x6200_pin_usb,
+    x6200_pin_wifi,
+
+    x6200_pin_last
+} x6200_pin_t;
+
+bool x6200_gpio_init();
+void x6200_gpio_set(x6200_pin_t pin, int value);
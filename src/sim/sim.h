@@ -0,0 +1,48 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <aether_radio/x6200_control/control.h>
+
+/**
+ * State of the simulated base board, changed by control commands
+ * and used by the flow to synthesize packets
+ */
+typedef struct {
+    pthread_mutex_t     mux;
+
+    x6200_vfo_t         vfo;
+    bool                split;
+    uint32_t            freq[2];
+    x6200_mode_t        mode[2];
+    x6200_att_t         att[2];
+    x6200_pre_t         pre[2];
+    uint8_t             rfg;
+
+    int16_t             filter_low;
+    int16_t             filter_high;
+    int16_t             rit;
+    int16_t             xit;
+    uint8_t             fft_dec;
+    uint8_t             fft_zoom_cw;
+
+    float               txpwr;
+    bool                ptt;
+    bool                modem;
+    bool                swrscan;
+
+    bool                atu_on;
+    bool                atu_tune;
+    uint32_t            atu_network;
+
+    bool                poweroff;
+} sim_state_t;
+
+extern sim_state_t sim;
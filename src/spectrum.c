@@ -16,6 +16,8 @@
 #include "radio.h"
 #include "recorder.h"
 #include "rtty.h"
+#include "psk.h"
+#include "psk_rx.h"
 #include "scheduler.h"
 #include "styles.h"
 #include "util.h"
@@ -243,6 +245,21 @@ static void spectrum_draw_cb(lv_event_t *e) {
         lv_draw_line(draw_ctx, &main_line_dsc, &main_a, &main_b);
     }
 
+    if (psk_get_state() != PSK_OFF) {
+        uint16_t    freqs[PSK_RX_CHANNELS];
+        size_t      count = psk_get_freqs(freqs, PSK_RX_CHANNELS);
+
+        for (size_t i = 0; i < count; i++) {
+            f1 = (int64_t)(w * sign_from * freqs[i]) / w_hz;
+
+            main_a.x = x1 + w / 2 + f1;
+            main_a.y = y1 + h - visor_height;
+            main_b.x = main_a.x;
+            main_b.y = y1 + h;
+            lv_draw_line(draw_ctx, &main_line_dsc, &main_a, &main_b);
+        }
+    }
+
     /* Center */
 
     main_line_dsc.width = 1;
@@ -0,0 +1,292 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "vmath.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+/* Cephes expf and logf polynomials */
+
+#define EXP_P0      1.9875691500e-4f
+#define EXP_P1      1.3981999507e-3f
+#define EXP_P2      8.3334519073e-3f
+#define EXP_P3      4.1665795894e-2f
+#define EXP_P4      1.6666665459e-1f
+#define EXP_P5      5.0000001201e-1f
+
+#define LOG_P0      7.0376836292e-2f
+#define LOG_P1      -1.1514610310e-1f
+#define LOG_P2      1.1676998740e-1f
+#define LOG_P3      -1.2420140846e-1f
+#define LOG_P4      1.4249322787e-1f
+#define LOG_P5      -1.6668057665e-1f
+#define LOG_P6      2.0000714765e-1f
+#define LOG_P7      -2.4999993993e-1f
+#define LOG_P8      3.3333331174e-1f
+
+#define LN2_HI      0.693359375f
+#define LN2_LO      -2.12194440e-4f
+#define LOG2E       1.44269502f
+#define LN10        2.30258512f
+#define LOG10E      0.434294492f
+#define LOG2_10     3.32192802f
+#define LOG10_2_HI  0.301025391f                /* Low bits are zero, so n * hi is exact */
+#define LOG10_2_LO  4.60503907e-6f
+#define SQRT_HALF   0.707106781f
+
+#define EXP_MIN     -87.0f                      /* Result stays normal */
+#define EXP_MAX     88.0f
+#define EXP10_MIN   -37.7f
+#define EXP10_MAX   38.2f
+#define LOG_MIN     1.17549435e-38f             /* FLT_MIN */
+
+/*
+ * Scalar kernels. Rounding is by truncation of x +- 0.5, as on the NEON
+ * path (ARMv7 has no vector round to nearest)
+ */
+
+static inline float scale_pow2(float y, int32_t n) {
+    uint32_t    bits = (uint32_t) (n + 127) << 23;
+    float       p;
+
+    memcpy(&p, &bits, sizeof(p));
+    return y * p;
+}
+
+static inline float exp_poly(float r) {
+    float p = EXP_P0;
+
+    p = p * r + EXP_P1;
+    p = p * r + EXP_P2;
+    p = p * r + EXP_P3;
+    p = p * r + EXP_P4;
+    p = p * r + EXP_P5;
+
+    return p * r * r + r + 1.0f;
+}
+
+static inline float exp_scalar(float x) {
+    x = x < EXP_MIN ? EXP_MIN : (x > EXP_MAX ? EXP_MAX : x);
+
+    float   t = x * LOG2E;
+    int32_t n = (int32_t) (t + copysignf(0.5f, t));
+    float   r = x - (float) n * LN2_HI - (float) n * LN2_LO;
+
+    return scale_pow2(exp_poly(r), n);
+}
+
+static inline float exp10_scalar(float x) {
+    x = x < EXP10_MIN ? EXP10_MIN : (x > EXP10_MAX ? EXP10_MAX : x);
+
+    float   t = x * LOG2_10;
+    int32_t n = (int32_t) (t + copysignf(0.5f, t));
+    float   r = (x - (float) n * LOG10_2_HI - (float) n * LOG10_2_LO) * LN10;
+
+    return scale_pow2(exp_poly(r), n);
+}
+
+static inline float log_scalar(float x) {
+    uint32_t bits;
+
+    x = x > LOG_MIN ? x : LOG_MIN;
+    memcpy(&bits, &x, sizeof(bits));
+
+    /* Mantissa to [0.5, 1) */
+
+    float e = (float) ((int32_t) (bits >> 23) - 126);
+    float m;
+
+    bits = (bits & 0x007fffff) | 0x3f000000;
+    memcpy(&m, &bits, sizeof(m));
+
+    /* Branchless, so the compiler can vectorize the loop without NEON */
+
+    float small = m < SQRT_HALF ? 1.0f : 0.0f;
+
+    e -= small;
+    m = m + m * small - 1.0f;
+
+    float z = m * m;
+    float p = LOG_P0;
+
+    p = p * m + LOG_P1;
+    p = p * m + LOG_P2;
+    p = p * m + LOG_P3;
+    p = p * m + LOG_P4;
+    p = p * m + LOG_P5;
+    p = p * m + LOG_P6;
+    p = p * m + LOG_P7;
+    p = p * m + LOG_P8;
+
+    float y = p * m * z + e * LN2_LO - 0.5f * z;
+
+    return m + y + e * LN2_HI;
+}
+
+#ifdef __ARM_NEON
+
+static inline float32x4_t round_half(float32x4_t t) {
+    uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(t), vdupq_n_u32(0x80000000));
+
+    return vreinterpretq_f32_u32(vorrq_u32(sign, vdupq_n_u32(0x3f000000)));
+}
+
+static inline float32x4_t scale_pow2_4(float32x4_t y, int32x4_t n) {
+    int32x4_t bits = vshlq_n_s32(vaddq_s32(n, vdupq_n_s32(127)), 23);
+
+    return vmulq_f32(y, vreinterpretq_f32_s32(bits));
+}
+
+static inline float32x4_t exp_poly_4(float32x4_t r) {
+    float32x4_t p = vdupq_n_f32(EXP_P0);
+
+    p = vmlaq_f32(vdupq_n_f32(EXP_P1), p, r);
+    p = vmlaq_f32(vdupq_n_f32(EXP_P2), p, r);
+    p = vmlaq_f32(vdupq_n_f32(EXP_P3), p, r);
+    p = vmlaq_f32(vdupq_n_f32(EXP_P4), p, r);
+    p = vmlaq_f32(vdupq_n_f32(EXP_P5), p, r);
+
+    return vaddq_f32(vmlaq_f32(r, p, vmulq_f32(r, r)), vdupq_n_f32(1.0f));
+}
+
+static inline float32x4_t exp_4(float32x4_t x) {
+    x = vminq_f32(vmaxq_f32(x, vdupq_n_f32(EXP_MIN)), vdupq_n_f32(EXP_MAX));
+
+    float32x4_t t = vmulq_f32(x, vdupq_n_f32(LOG2E));
+    int32x4_t   n = vcvtq_s32_f32(vaddq_f32(t, round_half(t)));
+    float32x4_t nf = vcvtq_f32_s32(n);
+    float32x4_t r = vmlsq_f32(x, nf, vdupq_n_f32(LN2_HI));
+
+    r = vmlsq_f32(r, nf, vdupq_n_f32(LN2_LO));
+
+    return scale_pow2_4(exp_poly_4(r), n);
+}
+
+static inline float32x4_t exp10_4(float32x4_t x) {
+    x = vminq_f32(vmaxq_f32(x, vdupq_n_f32(EXP10_MIN)), vdupq_n_f32(EXP10_MAX));
+
+    float32x4_t t = vmulq_f32(x, vdupq_n_f32(LOG2_10));
+    int32x4_t   n = vcvtq_s32_f32(vaddq_f32(t, round_half(t)));
+    float32x4_t nf = vcvtq_f32_s32(n);
+    float32x4_t r = vmlsq_f32(x, nf, vdupq_n_f32(LOG10_2_HI));
+
+    r = vmlsq_f32(r, nf, vdupq_n_f32(LOG10_2_LO));
+    r = vmulq_f32(r, vdupq_n_f32(LN10));
+
+    return scale_pow2_4(exp_poly_4(r), n);
+}
+
+static inline float32x4_t log_4(float32x4_t x) {
+    x = vmaxq_f32(x, vdupq_n_f32(LOG_MIN));
+
+    uint32x4_t  bits = vreinterpretq_u32_f32(x);
+    float32x4_t e = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(126)));
+
+    bits = vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007fffff)), vdupq_n_u32(0x3f000000));
+
+    float32x4_t m = vreinterpretq_f32_u32(bits);
+    uint32x4_t  small = vcltq_f32(m, vdupq_n_f32(SQRT_HALF));
+
+    /* m < sqrt(0.5): e - 1 and 2m - 1, else m - 1 */
+
+    e = vsubq_f32(e, vreinterpretq_f32_u32(vandq_u32(small, vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+    m = vsubq_f32(vaddq_f32(m, vreinterpretq_f32_u32(vandq_u32(small, vreinterpretq_u32_f32(m)))), vdupq_n_f32(1.0f));
+
+    float32x4_t z = vmulq_f32(m, m);
+    float32x4_t p = vdupq_n_f32(LOG_P0);
+
+    p = vmlaq_f32(vdupq_n_f32(LOG_P1), p, m);
+    p = vmlaq_f32(vdupq_n_f32(LOG_P2), p, m);
+    p = vmlaq_f32(vdupq_n_f32(LOG_P3), p, m);
+    p = vmlaq_f32(vdupq_n_f32(LOG_P4), p, m);
+    p = vmlaq_f32(vdupq_n_f32(LOG_P5), p, m);
+    p = vmlaq_f32(vdupq_n_f32(LOG_P6), p, m);
+    p = vmlaq_f32(vdupq_n_f32(LOG_P7), p, m);
+    p = vmlaq_f32(vdupq_n_f32(LOG_P8), p, m);
+
+    float32x4_t y = vmulq_f32(vmulq_f32(p, m), z);
+
+    y = vmlaq_f32(y, e, vdupq_n_f32(LN2_LO));
+    y = vmlsq_f32(y, z, vdupq_n_f32(0.5f));
+
+    return vmlaq_f32(vaddq_f32(m, y), e, vdupq_n_f32(LN2_HI));
+}
+
+#endif
+
+/* mul * log(x) */
+
+static void log_array(const float *x, float *y, size_t n, float mul) {
+    size_t i = 0;
+
+#ifdef __ARM_NEON
+    float32x4_t k = vdupq_n_f32(mul);
+
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(y + i, vmulq_f32(log_4(vld1q_f32(x + i)), k));
+    }
+#endif
+
+    for (; i < n; i++) {
+        y[i] = log_scalar(x[i]) * mul;
+    }
+}
+
+/* 10 ^ (x * mul) */
+
+static void exp10_array(const float *x, float *y, size_t n, float mul) {
+    size_t i = 0;
+
+#ifdef __ARM_NEON
+    float32x4_t k = vdupq_n_f32(mul);
+
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(y + i, exp10_4(vmulq_f32(vld1q_f32(x + i), k)));
+    }
+#endif
+
+    for (; i < n; i++) {
+        y[i] = exp10_scalar(x[i] * mul);
+    }
+}
+
+void vmath_log10(const float *x, float *y, size_t n) {
+    log_array(x, y, n, LOG10E);
+}
+
+void vmath_exp(const float *x, float *y, size_t n) {
+    size_t i = 0;
+
+#ifdef __ARM_NEON
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(y + i, exp_4(vld1q_f32(x + i)));
+    }
+#endif
+
+    for (; i < n; i++) {
+        y[i] = exp_scalar(x[i]);
+    }
+}
+
+void vmath_exp10(const float *x, float *y, size_t n) {
+    exp10_array(x, y, n, 1.0f);
+}
+
+void vmath_power_to_db(const float *x, float *y, size_t n) {
+    log_array(x, y, n, 10.0f * LOG10E);
+}
+
+void vmath_db_to_power(const float *x, float *y, size_t n) {
+    exp10_array(x, y, n, 0.1f);
+}
@@ -0,0 +1,44 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+/*
+ * Array versions of log10, exp and 10^x for the dB conversions of spectrum
+ * and decoders. Four values at once with NEON, the same polynomials in
+ * plain C elsewhere. Error is within 2e-7 of the result for exp and 10^x,
+ * and within 2e-7 of max(1, |result|) for log10 (see tests/test_vmath.cpp).
+ *
+ * Input and output may be the same array. Arguments are clamped to the
+ * normal float range: log10 of zero or negative gives log10(FLT_MIN),
+ * exp does not overflow to infinity or underflow to zero
+ */
+
+void vmath_log10(const float *x, float *y, size_t n);
+void vmath_exp(const float *x, float *y, size_t n);
+void vmath_exp10(const float *x, float *y, size_t n);
+
+/**
+ * 10 * log10(x)
+ */
+void vmath_power_to_db(const float *x, float *y, size_t n);
+
+/**
+ * 10 ^ (x / 10)
+ */
+void vmath_db_to_power(const float *x, float *y, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
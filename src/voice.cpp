@@ -23,6 +23,7 @@ extern "C" {
 #include "msg.h"
 }
 
+#include <atomic>
 #include <memory>
 #include <stdexcept>
 #include <iostream>
@@ -75,7 +76,8 @@ typedef struct {
     const char* welcome;
 } voice_item_t;
 
-static std::shared_ptr<engine>      eng(new engine);
+static std::shared_ptr<engine>      eng;
+static std::atomic<bool>            ready(false);
 static voice_profile                profile;
 static char                         buf[512];
 static char                         prev[512];
@@ -175,8 +177,20 @@ void voice_change_mode() {
     }
 }
 
+/**
+ * Loading of the voices takes seconds, so it is done on a boot worker
+ */
+void voice_init() {
+    try {
+        eng = std::make_shared<engine>();
+        ready = true;
+    } catch (const std::exception &e) {
+        LV_LOG_ERROR("Voice engine: %s", e.what());
+    }
+}
+
 bool voice_enable() {
-    if (run || recorder_is_on()) {
+    if (!ready || run || recorder_is_on()) {
         return false;
     }
 
@@ -24,6 +24,11 @@ typedef enum {
     VOICE_ALWAYS
 } voice_mode_t;
 
+/**
+ * Any thread, voice is silent until it is done
+ */
+void voice_init();
+
 void voice_sure();
 void voice_change_mode();
 
@@ -0,0 +1,63 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "wakeup.h"
+
+#include "lvgl/lvgl.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+static int          fd = -1;
+static atomic_bool  pending;
+
+void wakeup_init() {
+    fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (fd < 0) {
+        LV_LOG_ERROR("Can't create wakeup eventfd");
+    }
+}
+
+int wakeup_fd() {
+    return fd;
+}
+
+void wakeup_signal() {
+    /* Item put by the caller is visible before the flag is checked */
+
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (fd < 0 || atomic_exchange(&pending, true)) {
+        return;
+    }
+
+    uint64_t one = 1;
+
+    if (write(fd, &one, sizeof(one)) < 0) {
+        LV_LOG_WARN("Wakeup write failed");
+    }
+}
+
+void wakeup_clear() {
+    uint64_t val;
+
+    /* Signal after this point writes again, so it is not lost */
+
+    atomic_store(&pending, false);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (fd >= 0) {
+        ssize_t res = read(fd, &val, sizeof(val));
+
+        (void) res;
+    }
+}
@@ -0,0 +1,40 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Wakes the main loop from other threads. Queues to the UI (scheduler,
+ * events, delayed observers) signal it after putting an item, the main
+ * loop waits on wakeup_fd() with epoll
+ */
+
+void wakeup_init();
+
+/**
+ * Eventfd for epoll, -1 before init
+ */
+int wakeup_fd();
+
+/**
+ * Any thread. Repeated signals before the main loop runs write once
+ */
+void wakeup_signal();
+
+/**
+ * Main loop, before it takes items from the queues
+ */
+void wakeup_clear();
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,6 +9,7 @@
 
 #include "wifi.h"
 #include "cfg/cfg.h"
+#include "scheduler.h"
 
 extern "C" {
 
@@ -70,6 +71,23 @@ static void connection_modify_cb(GObject *connection, GAsyncResult *result, gpoi
 static void connection_delete_cb(GObject *connection, GAsyncResult *result, gpointer user_data);
 static void connection_activating_cb(GObject *client, GAsyncResult *result, gpointer user_data);
 
+static void power_setup_cb(void *arg) {
+    wifi_power_setup();
+}
+
+void wifi_init() {
+    GError *error = NULL;
+
+    client = nm_client_new(NULL, &error);
+
+    if (!client) {
+        LV_LOG_ERROR("Could not create NMClient: %s.", error->message);
+        g_error_free(error);
+    }
+
+    scheduler_put_noargs(power_setup_cb);
+}
+
 void wifi_power_setup() {
     set_status(WIFI_DISCONNECTED);
     loop = g_main_loop_new(NULL, FALSE);
@@ -380,15 +398,9 @@ static void update_scan_status_cb(lv_timer_t *t) {
 }
 
 static void setup_nm_client() {
-    GError *error = NULL;
-
-    /* Get NMClient object */
-    client = nm_client_new(NULL, &error);
-    if (!client) {
-        LV_LOG_ERROR("Could not create NMClient: %s.", error->message);
-        g_error_free(error);
+    if (client) {
+        g_signal_connect(client, "device-added", G_CALLBACK(device_added_sig_cb), NULL);
     }
-    g_signal_connect(client, "device-added", G_CALLBACK(device_added_sig_cb), NULL);
 }
 
 static void setup_wifi_device() {
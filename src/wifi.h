@@ -46,6 +46,11 @@ typedef struct {
 
 // typedef void (*wifi_ap_change_cb)(wifi_ap_info_t *ap_info);
 
+/**
+ * Any thread. Connects to NetworkManager and puts wifi_power_setup() to the main thread
+ */
+void wifi_init();
+
 void wifi_power_setup();
 
 /**
@@ -0,0 +1,737 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+/*
+ * DSP microbenchmarks. Each kernel is called through its entry point in the
+ * app with the same block sizes, result is ns per input sample (per character
+ * for the Morse lookup, per main loop pass for the delayed observers).
+ *
+ * Usage: bench_dsp [-f name] [-t seconds] [-o out.csv] [-b baseline.csv] [-r max_regression_pct]
+ */
+
+#include "bench_dsp.h"
+
+#include "../../src/cw_frontend.h"
+#include "../../src/cw_morse.h"
+#include "../../src/dsp.h"
+#include "../../src/goertzel.h"
+#include "../../src/rtty_rx.h"
+#include "../../src/vmath.h"
+#include "../../src/cfg/cfg.h"
+#include "../../src/ft8/gfsk.h"
+#include "../../src/ft8/worker.h"
+
+#include <liquid/liquid.h>
+#include <complex.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_BENCH       64
+#define AUDIO_BLOCK     (AUDIO_CAPTURE_RATE / 10)  /* PulseAudio fragment */
+
+typedef struct {
+    const char  *name;
+    void        (*init)();
+    size_t      (*run)();       /* one iteration, returns number of processed samples */
+    void        (*done)();
+} bench_t;
+
+typedef struct {
+    char        name[64];
+    double      ns;
+} result_t;
+
+static uint32_t         rnd_state = 1;
+
+static float            radio_samples[RADIO_SAMPLES];
+static float            waterfall_db[RADIO_SAMPLES];
+static float complex    audio[AUDIO_BLOCK];
+static volatile float   sink;
+
+static float rnd() {
+    rnd_state = rnd_state * 1664525 + 1013904223;
+    return (float) rnd_state / UINT32_MAX - 0.5f;
+}
+
+static void make_audio(float freq) {
+    for (size_t i = 0; i < AUDIO_BLOCK; i++) {
+        float ph = 2.0f * M_PI * freq * i / AUDIO_CAPTURE_RATE;
+
+        audio[i] = 0.3f * cexpf(I * ph) + 0.01f * (rnd() + I * rnd());
+    }
+}
+
+/* AveragedPSD (dsp.cpp): one packet per iteration */
+
+static void psd_init() {
+    for (size_t i = 0; i < RADIO_SAMPLES; i++) {
+        radio_samples[i] = -120.0f + rnd() * 6.0f;
+    }
+}
+
+static size_t psd_add_run() {
+    bench_psd_add(radio_samples);
+    return RADIO_SAMPLES;
+}
+
+static size_t psd_get_run() {
+    bench_psd_add(radio_samples);
+    sink = bench_psd_get();
+    return RADIO_SAMPLES;
+}
+
+/* dsp_update_min_max (dsp.cpp): window for full span and for fft_dec = 5 */
+
+static void min_max_init() {
+    for (size_t i = 0; i < RADIO_SAMPLES; i++) {
+        waterfall_db[i] = -120.0f + rnd() * 6.0f;
+    }
+}
+
+static size_t min_max_full_run() {
+    size_t size = RADIO_SAMPLES - 16;
+
+    sink = bench_psd_noise_min(waterfall_db + 8, size, FFT_FULL_WIDTH);
+    return size;
+}
+
+static size_t min_max_dec5_run() {
+    size_t size = RADIO_SAMPLES - 16;
+
+    sink = bench_psd_noise_min(waterfall_db + 8, size, FFT_FULL_WIDTH >> 5);
+    return size;
+}
+
+/* vmath.c: dB conversions, libm per value against the array call at the size of each converted call site */
+
+#define DB_MAX          4096
+#define FT8_WF_NFFT     ((int) (AUDIO_CAPTURE_RATE / FTX_WORKER_DECIM * FT8_SYMBOL_PERIOD) * 2)     /* Block by FREQ_OSR of ft8/worker.c */
+#define LEVELS          31                                                                          /* Channels and bins of cw_skimmer.c, psk_rx.c */
+
+static float            db_in[DB_MAX];
+static float            power_in[DB_MAX];
+static float            db_out[DB_MAX];
+
+static void db_init() {
+    for (size_t i = 0; i < DB_MAX; i++) {
+        db_in[i] = -120.0f + rnd() * 6.0f;
+        power_in[i] = powf(10.0f, -12.0f + rnd() * 0.6f);
+    }
+}
+
+static size_t db_to_power_libm(size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        db_out[i] = powf(10.0f, db_in[i] * 0.1f);
+    }
+    sink = db_out[0];
+    return n;
+}
+
+static size_t db_to_power_vmath(size_t n) {
+    vmath_db_to_power(db_in, db_out, n);
+    sink = db_out[0];
+    return n;
+}
+
+static size_t power_to_db_libm(size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        db_out[i] = 10.0f * log10f(power_in[i]);
+    }
+    sink = db_out[0];
+    return n;
+}
+
+static size_t power_to_db_vmath(size_t n) {
+    vmath_power_to_db(power_in, db_out, n);
+    sink = db_out[0];
+    return n;
+}
+
+/* AveragedPSD add_samples */
+
+static size_t db_to_power_libm_run() {
+    return db_to_power_libm(RADIO_SAMPLES);
+}
+
+static size_t db_to_power_vmath_run() {
+    return db_to_power_vmath(RADIO_SAMPLES);
+}
+
+/* AveragedPSD get of the waterfall */
+
+static size_t power_to_db_libm_run() {
+    return power_to_db_libm(RADIO_SAMPLES);
+}
+
+static size_t power_to_db_vmath_run() {
+    return power_to_db_vmath(RADIO_SAMPLES);
+}
+
+/* AveragedPSD get of the spectrum */
+
+static size_t spectrum_db_libm_run() {
+    return power_to_db_libm(SPECTRUM_NFFT);
+}
+
+static size_t spectrum_db_vmath_run() {
+    return power_to_db_vmath(SPECTRUM_NFFT);
+}
+
+/* psd_window_min of dsp_update_min_max */
+
+static size_t noise_power_libm_run() {
+    return db_to_power_libm(RADIO_SAMPLES - 16);
+}
+
+static size_t noise_power_vmath_run() {
+    return db_to_power_vmath(RADIO_SAMPLES - 16);
+}
+
+/* FT8 worker waterfall magnitudes */
+
+static size_t ft8_wf_db_libm_run() {
+    return power_to_db_libm(FT8_WF_NFFT);
+}
+
+static size_t ft8_wf_db_vmath_run() {
+    return power_to_db_vmath(FT8_WF_NFFT);
+}
+
+/* CW skimmer channel and PSK detector levels */
+
+static size_t levels_db_libm_run() {
+    return power_to_db_libm(LEVELS);
+}
+
+static size_t levels_db_vmath_run() {
+    return power_to_db_vmath(LEVELS);
+}
+
+/* Reference: former per-sample CW chain of cw.cpp (cbuffercf, dds_cccf, wrms, wdelayf), to compare cw_frontend.c with */
+
+static dds_cccf         cw_dds;
+static cbuffercf        cw_input;
+static cbuffercf        cw_fft_buf;
+static cbuffercf        cw_rms_buf;
+static windowf          cw_rms;
+static wdelayf          cw_delay;
+static int              cw_remain;
+static fftplan          cw_plan;
+static float complex    cw_time[CW_FRONTEND_FFT];
+static float complex    cw_freq[CW_FRONTEND_FFT];
+static float            cw_window[CW_FRONTEND_FFT];
+
+static void cw_legacy_init() {
+    make_audio(700.0f);
+    cw_dds = dds_cccf_create(CW_FRONTEND_STAGES, 700.0f / AUDIO_CAPTURE_RATE, 500.0f / AUDIO_CAPTURE_RATE, 60.0f);
+    cw_input = cbuffercf_create(10000);
+    cw_fft_buf = cbuffercf_create(4000 / 8 * 2);
+    cw_rms_buf = cbuffercf_create(4000 / 8 * 2);
+    cw_rms = windowf_create(CW_FRONTEND_RMS_SIZE);
+    cw_delay = wdelayf_create(CW_FRONTEND_RMS_DELAY);
+    cw_remain = CW_FRONTEND_RMS_STEP;
+    cw_plan = fft_create_plan(CW_FRONTEND_FFT, cw_time, cw_freq, LIQUID_FFT_FORWARD, 0);
+
+    for (size_t i = 0; i < CW_FRONTEND_FFT; i++) {
+        cw_window[i] = liquid_hann(i, CW_FRONTEND_FFT);
+    }
+}
+
+static size_t cw_legacy_run() {
+    cbuffercf_write(cw_input, audio, AUDIO_BLOCK);
+
+    while (cbuffercf_size(cw_input) >= CW_FRONTEND_DECIM) {
+        float complex   *buf;
+        float complex   sample;
+        unsigned int    n;
+
+        cbuffercf_read(cw_input, CW_FRONTEND_DECIM, &buf, &n);
+        dds_cccf_decim_execute(cw_dds, buf, &sample);
+        cbuffercf_release(cw_input, CW_FRONTEND_DECIM);
+        cbuffercf_push(cw_rms_buf, sample);
+        cbuffercf_push(cw_fft_buf, sample);
+
+        while (cbuffercf_size(cw_fft_buf) >= CW_FRONTEND_FFT) {
+            for (size_t i = 0; i < CW_FRONTEND_FFT; i++) {
+                cbuffercf_pop(cw_fft_buf, &cw_time[i]);
+                cw_time[i] *= cw_window[i];
+            }
+            fft_execute(cw_plan);
+
+            for (size_t i = 0; i < CW_FRONTEND_FFT; i++) {
+                sink = crealf(cw_freq[i] * conjf(cw_freq[i]));
+            }
+        }
+
+        while (cbuffercf_size(cw_rms_buf)) {
+            cbuffercf_pop(cw_rms_buf, &sample);
+
+            if (cw_remain == 0) {
+                cw_remain = CW_FRONTEND_RMS_STEP;
+            }
+            cw_remain--;
+
+            float x_db = 10.0f * log10f(cabsf(sample));
+
+            windowf_push(cw_rms, x_db < -121.0f ? -121.0f : x_db);
+
+            if (cw_remain == 0) {
+                float *r, rms = 0.0f;
+
+                windowf_read(cw_rms, &r);
+                for (size_t i = 0; i < CW_FRONTEND_RMS_SIZE; i++) {
+                    rms += r[i];
+                }
+                wdelayf_push(cw_delay, rms / CW_FRONTEND_RMS_SIZE);
+                wdelayf_read(cw_delay, &rms);
+                sink = rms;
+            }
+        }
+    }
+
+    return AUDIO_BLOCK;
+}
+
+static void cw_legacy_done() {
+    dds_cccf_destroy(cw_dds);
+    cbuffercf_destroy(cw_input);
+    cbuffercf_destroy(cw_fft_buf);
+    cbuffercf_destroy(cw_rms_buf);
+    windowf_destroy(cw_rms);
+    wdelayf_destroy(cw_delay);
+    fft_destroy_plan(cw_plan);
+}
+
+/* cw_frontend.c */
+
+static cw_frontend_t    cw_fe;
+
+static void cw_fft_cb(const float *psd, void *user) {
+    sink = psd[0];
+}
+
+static void cw_rms_cb(float rms_db, float delayed_db, void *user) {
+    sink = delayed_db;
+}
+
+static void cw_frontend_init() {
+    make_audio(700.0f);
+    cw_fe = cw_frontend_create(cw_fft_cb, cw_rms_cb, NULL);
+    cw_frontend_set_tone(cw_fe, 700.0f / AUDIO_CAPTURE_RATE, 500.0f / AUDIO_CAPTURE_RATE);
+}
+
+static size_t cw_frontend_run() {
+    cw_frontend_process(cw_fe, AUDIO_BLOCK, audio);
+    return AUDIO_BLOCK;
+}
+
+static void cw_frontend_done() {
+    cw_frontend_destroy(cw_fe);
+}
+
+/* rtty_rx.c: fixed 45.45 baud / 170 Hz and the auto rate bank */
+
+static rtty_rx_t        rtty;
+
+static void rtty_text_cb(char c, void *user) {
+    sink = c;
+}
+
+static void rtty_fixed_init() {
+    make_audio(2125.0f);
+    rtty = rtty_rx_create(45.45f, 170, AUDIO_CAPTURE_RATE, rtty_text_cb, NULL);
+    rtty_rx_set_center(rtty, 2210.0f);
+}
+
+static void rtty_auto_init() {
+    make_audio(2125.0f);
+    rtty = rtty_rx_create(0.0f, 0, AUDIO_CAPTURE_RATE, rtty_text_cb, NULL);
+    rtty_rx_set_center(rtty, 2210.0f);
+}
+
+static size_t rtty_run() {
+    rtty_rx_process(rtty, AUDIO_BLOCK, audio);
+    return AUDIO_BLOCK;
+}
+
+static void rtty_done() {
+    rtty_rx_destroy(rtty);
+}
+
+/* goertzel.c: one tone */
+
+static goertzel_t   goertzel;
+
+static void goertzel_init() {
+    make_audio(1000.0f);
+    goertzel_freq_init(&goertzel, 1000, AUDIO_CAPTURE_RATE, 441);
+}
+
+static size_t goertzel_run() {
+    for (size_t i = 0; i < AUDIO_BLOCK; i++) {
+        goertzel_input(&goertzel, crealf(audio[i]));
+
+        if (i % 441 == 440) {
+            sink = goertzel_output(&goertzel);
+            goertzel_reset(&goertzel);
+        }
+    }
+
+    return AUDIO_BLOCK;
+}
+
+/* goertzel.c: 16 tones over the same block, separate filters vs the bank */
+
+#define GOERTZEL_TONES  16
+
+static goertzel_t       goertzel_tones[GOERTZEL_TONES];
+static goertzel_bank_t  goertzel_bank;
+static float            goertzel_real[AUDIO_BLOCK];
+static float            goertzel_out[GOERTZEL_TONES];
+
+static void goertzel_tones_init() {
+    make_audio(1000.0f);
+
+    for (size_t i = 0; i < AUDIO_BLOCK; i++) {
+        goertzel_real[i] = crealf(audio[i]);
+    }
+
+    goertzel_bank_init(&goertzel_bank, GOERTZEL_TONES);
+
+    for (uint16_t k = 0; k < GOERTZEL_TONES; k++) {
+        goertzel_freq_init(&goertzel_tones[k], 500 + k * 100, AUDIO_CAPTURE_RATE, 441);
+        goertzel_bank_freq_init(&goertzel_bank, k, 500 + k * 100, AUDIO_CAPTURE_RATE, 441);
+    }
+}
+
+static size_t goertzel_scalar_run() {
+    for (size_t pos = 0; pos < AUDIO_BLOCK; pos += 441) {
+        for (size_t k = 0; k < GOERTZEL_TONES; k++) {
+            for (size_t i = 0; i < 441; i++) {
+                goertzel_input(&goertzel_tones[k], goertzel_real[pos + i]);
+            }
+
+            goertzel_out[k] = goertzel_output(&goertzel_tones[k]);
+            goertzel_reset(&goertzel_tones[k]);
+        }
+    }
+
+    sink = goertzel_out[0];
+
+    return AUDIO_BLOCK;
+}
+
+static size_t goertzel_bank_run() {
+    for (size_t pos = 0; pos < AUDIO_BLOCK; pos += 441) {
+        goertzel_bank_input(&goertzel_bank, &goertzel_real[pos], 441);
+        goertzel_bank_output(&goertzel_bank, goertzel_out);
+        goertzel_bank_reset(&goertzel_bank);
+    }
+
+    sink = goertzel_out[0];
+
+    return AUDIO_BLOCK;
+}
+
+/* cw_decoder.c: element accumulation and character lookup */
+
+#define MORSE_CHARS     1024
+
+static const char       *morse_text[MORSE_CHARS];
+
+static void morse_init() {
+    size_t n = 0;
+
+    while (cw_characters[n].morse) {
+        n++;
+    }
+
+    for (size_t i = 0; i < MORSE_CHARS; i++) {
+        morse_text[i] = cw_characters[(size_t) ((rnd() + 0.5f) * (n - 1))].morse;
+    }
+}
+
+/* Reference: former lookup of cw_decoder.c, strcat of elements and strcmp over the tables */
+
+static const char * morse_legacy_dict(const char *elements) {
+    for (cw_characters_t *c = cw_characters; c->morse; c++) {
+        if (strcmp(elements, c->morse) == 0) {
+            return c->character;
+        }
+    }
+
+    for (cw_characters_t *c = cw_prosigns; c->morse; c++) {
+        if (strcmp(elements, c->morse) == 0) {
+            return c->character;
+        }
+    }
+
+    return "<?>";
+}
+
+static size_t morse_strcmp_run() {
+    char elements[128];
+
+    for (size_t i = 0; i < MORSE_CHARS; i++) {
+        strcpy(elements, "");
+
+        for (const char *e = morse_text[i]; *e; e++) {
+            strcat(elements, *e == '.' ? "." : "-");
+        }
+
+        sink = morse_legacy_dict(elements)[0];
+    }
+
+    return MORSE_CHARS;
+}
+
+static size_t morse_index_run() {
+    for (size_t i = 0; i < MORSE_CHARS; i++) {
+        cw_morse_t m;
+
+        cw_morse_clear(&m);
+
+        for (const char *e = morse_text[i]; *e; e++) {
+            cw_morse_push(&m, *e == '-');
+        }
+
+        const char *c = cw_morse_decode(m, CW_MORSE_LATIN);
+
+        sink = c ? c[0] : '?';
+    }
+
+    return MORSE_CHARS;
+}
+
+/* FT8 (ft8/worker.c): audio decimation, ftx worker, gfsk synth */
+
+static float complex    *ft8_in;
+static float complex    *ft8_out;
+static int              ft8_block;
+
+static void ft8_init() {
+    make_audio(1500.0f);
+    ftx_worker_init(AUDIO_CAPTURE_RATE / FTX_WORKER_DECIM, FTX_PROTOCOL_FT8);
+    ft8_block = ftx_worker_get_block_size();
+    ft8_in = malloc(ft8_block * FTX_WORKER_DECIM * sizeof(float complex));
+    ft8_out = malloc(ft8_block * sizeof(float complex));
+
+    for (int i = 0; i < ft8_block * FTX_WORKER_DECIM; i++) {
+        ft8_in[i] = audio[i % AUDIO_BLOCK];
+    }
+    ftx_worker_decimate(ft8_in, ft8_block, ft8_out);
+}
+
+static size_t ft8_decim_run() {
+    ftx_worker_decimate(ft8_in, ft8_block, ft8_out);
+    return ft8_block * FTX_WORKER_DECIM;
+}
+
+static size_t ft8_worker_run() {
+    if (ftx_worker_is_full()) {
+        ftx_worker_reset();
+    }
+    ftx_worker_put_rx_samples(ft8_out, ft8_block);
+    return ft8_block;
+}
+
+static void ft8_done() {
+    ftx_worker_free();
+    free(ft8_in);
+    free(ft8_out);
+}
+
+static size_t gfsk_run() {
+    static uint8_t  symbols[79];
+    uint32_t        n_samples;
+
+    for (size_t i = 0; i < 79; i++) {
+        symbols[i] = i % 8;
+    }
+
+    int16_t *samples = gfsk_synth(symbols, 79, 1500.0f, FT8_SYMBOL_BT, 0.16f, AUDIO_CAPTURE_RATE, &n_samples);
+
+    sink = samples[0];
+    free(samples);
+
+    return n_samples;
+}
+
+static const bench_t benches[] = {
+    { "psd_add_samples",    psd_init,       psd_add_run,        NULL },
+    { "psd_get",            psd_init,       psd_get_run,        NULL },
+    { "min_max_full",       min_max_init,   min_max_full_run,   NULL },
+    { "min_max_dec5",       min_max_init,   min_max_dec5_run,   NULL },
+    { "db_to_power_libm",   db_init,        db_to_power_libm_run, NULL },
+    { "db_to_power_vmath",  db_init,        db_to_power_vmath_run, NULL },
+    { "power_to_db_libm",   db_init,        power_to_db_libm_run, NULL },
+    { "power_to_db_vmath",  db_init,        power_to_db_vmath_run, NULL },
+    { "spectrum_db_libm",   db_init,        spectrum_db_libm_run, NULL },
+    { "spectrum_db_vmath",  db_init,        spectrum_db_vmath_run, NULL },
+    { "noise_power_libm",   db_init,        noise_power_libm_run, NULL },
+    { "noise_power_vmath",  db_init,        noise_power_vmath_run, NULL },
+    { "ft8_wf_db_libm",     db_init,        ft8_wf_db_libm_run, NULL },
+    { "ft8_wf_db_vmath",    db_init,        ft8_wf_db_vmath_run, NULL },
+    { "levels_db_libm",     db_init,        levels_db_libm_run, NULL },
+    { "levels_db_vmath",    db_init,        levels_db_vmath_run, NULL },
+    { "cw_legacy",          cw_legacy_init, cw_legacy_run,      cw_legacy_done },
+    { "cw_frontend",        cw_frontend_init, cw_frontend_run,  cw_frontend_done },
+    { "rtty_fixed",         rtty_fixed_init, rtty_run,          rtty_done },
+    { "rtty_auto",          rtty_auto_init, rtty_run,           rtty_done },
+    { "goertzel",           goertzel_init,  goertzel_run,       NULL },
+    { "goertzel_16_scalar", goertzel_tones_init, goertzel_scalar_run, NULL },
+    { "goertzel_16_bank",   goertzel_tones_init, goertzel_bank_run, NULL },
+    { "morse_strcmp",       morse_init,     morse_strcmp_run,   NULL },
+    { "morse_index",        morse_init,     morse_index_run,    NULL },
+    { "ft8_decimate",       ft8_init,       ft8_decim_run,      ft8_done },
+    { "ft8_worker_put",     ft8_init,       ft8_worker_run,     ft8_done },
+    { "ft8_gfsk_synth",     NULL,           gfsk_run,           NULL },
+    { "observers_idle_1k",  bench_observers_init_1k,  bench_observers_idle,    bench_observers_done },
+    { "observers_idle_10k", bench_observers_init_10k, bench_observers_idle,    bench_observers_done },
+    { "observers_one_10k",  bench_observers_init_10k, bench_observers_changed, bench_observers_done },
+};
+
+static uint64_t now_ns() {
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t) t.tv_sec * 1000000000L + t.tv_nsec;
+}
+
+static double run_bench(const bench_t *bench, double min_time) {
+    if (bench->init) {
+        bench->init();
+    }
+
+    /* Warm up */
+    for (int i = 0; i < 10; i++) {
+        bench->run();
+    }
+
+    uint64_t    samples = 0;
+    uint64_t    start = now_ns();
+    uint64_t    elapsed;
+
+    do {
+        samples += bench->run();
+        elapsed = now_ns() - start;
+    } while (elapsed < min_time * 1e9);
+
+    if (bench->done) {
+        bench->done();
+    }
+
+    return (double) elapsed / samples;
+}
+
+static size_t load_baseline(const char *name, result_t *results) {
+    FILE    *f = fopen(name, "r");
+    size_t  n = 0;
+    char    line[128];
+
+    if (!f) {
+        fprintf(stderr, "Can't open baseline %s\n", name);
+        return 0;
+    }
+
+    while (n < MAX_BENCH && fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "%63[^,],%lf", results[n].name, &results[n].ns) == 2) {
+            n++;
+        }
+    }
+
+    fclose(f);
+    return n;
+}
+
+static const result_t * find_result(const result_t *results, size_t n, const char *name) {
+    for (size_t i = 0; i < n; i++) {
+        if (strcmp(results[i].name, name) == 0) {
+            return &results[i];
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    const char  *filter = NULL;
+    const char  *out_name = NULL;
+    const char  *baseline_name = NULL;
+    double      min_time = 0.5;
+    double      max_regression = 10.0;
+    int         opt;
+
+    while ((opt = getopt(argc, argv, "f:t:o:b:r:")) != -1) {
+        switch (opt) {
+            case 'f': filter = optarg; break;
+            case 't': min_time = atof(optarg); break;
+            case 'o': out_name = optarg; break;
+            case 'b': baseline_name = optarg; break;
+            case 'r': max_regression = atof(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-f name] [-t seconds] [-o out.csv] [-b baseline.csv] [-r max_regression_pct]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    result_t    baseline[MAX_BENCH];
+    size_t      baseline_n = baseline_name ? load_baseline(baseline_name, baseline) : 0;
+    FILE        *out = NULL;
+    int         res = 0;
+
+    if (out_name) {
+        out = fopen(out_name, "w");
+
+        if (!out) {
+            fprintf(stderr, "Can't create %s\n", out_name);
+            return 2;
+        }
+        fprintf(out, "name,ns_per_sample\n");
+    }
+
+    printf("%-20s %12s %12s %8s\n", "name", "ns/sample", "baseline", "diff %");
+
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+        const bench_t *bench = &benches[i];
+
+        if (filter && !strstr(bench->name, filter)) {
+            continue;
+        }
+
+        double          ns = run_bench(bench, min_time);
+        const result_t  *base = find_result(baseline, baseline_n, bench->name);
+
+        if (base) {
+            double diff = (ns - base->ns) / base->ns * 100.0;
+
+            printf("%-20s %12.3f %12.3f %+8.1f%s\n", bench->name, ns, base->ns, diff,
+                diff > max_regression ? "  REGRESSION" : "");
+
+            if (diff > max_regression) {
+                res = 1;
+            }
+        } else {
+            printf("%-20s %12.3f %12s %8s\n", bench->name, ns, "-", "-");
+        }
+
+        if (out) {
+            fprintf(out, "%s,%.3f\n", bench->name, ns);
+        }
+    }
+
+    if (out) {
+        fclose(out);
+    }
+
+    return res;
+}
@@ -0,0 +1,33 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../../src/audio.h"
+#include "../../src/radio.h"
+
+void bench_psd_add(float *samples);
+float bench_psd_get();
+float bench_psd_noise_min(const float *data_buf, size_t size, uint32_t fft_width);
+
+void bench_observers_init_1k();
+void bench_observers_init_10k();
+void bench_observers_done();
+size_t bench_observers_idle();
+size_t bench_observers_changed();
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,72 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "../../src/cfg/subjects.h"
+
+#include "bench_dsp.h"
+
+#include <thread>
+#include <vector>
+
+/*
+ * Delayed observers are made by other thread, so subject_set from the bench
+ * goes the cross-thread way, as changes from radio and CAT threads
+ */
+
+static std::vector<Subject *>           subjects;
+static std::vector<ObserverDelayed *>   observers;
+static size_t                           calls;
+static size_t                           next_changed;
+
+static void observer_cb(Subject *subj, void *user) {
+    calls++;
+}
+
+static void observers_create(size_t count) {
+    std::thread thread([count] {
+        for (size_t i = 0; i < count; i++) {
+            Subject *subj = subject_create_int(0);
+
+            subjects.push_back(subj);
+            observers.push_back(subject_add_delayed_observer(subj, observer_cb, NULL));
+        }
+    });
+
+    thread.join();
+    next_changed = 0;
+}
+
+extern "C" void bench_observers_init_1k() {
+    observers_create(1000);
+}
+
+extern "C" void bench_observers_init_10k() {
+    observers_create(10000);
+}
+
+extern "C" void bench_observers_done() {
+    for (auto observer : observers) {
+        observer_delayed_del(observer);
+    }
+
+    observers.clear();
+    subjects.clear();
+}
+
+extern "C" size_t bench_observers_idle() {
+    observer_delayed_notify_all();
+    return 1;
+}
+
+extern "C" size_t bench_observers_changed() {
+    Subject *subj = subjects[next_changed++ % subjects.size()];
+
+    subject_set_int(subj, subject_get_int(subj) + 1);
+    observer_delayed_notify_all();
+    return 1;
+}
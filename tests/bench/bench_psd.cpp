@@ -0,0 +1,26 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6200 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "../../src/dsp.h"
+#include "../../src/psd.h"
+
+#include "bench_dsp.h"
+
+static AveragedPSD<RADIO_SAMPLES, SPECTRUM_NFFT> spectrum_avg_psd;
+
+extern "C" void bench_psd_add(float *samples) {
+    spectrum_avg_psd.add_samples(samples);
+}
+
+extern "C" float bench_psd_get() {
+    return (*spectrum_avg_psd.get())[0];
+}
+
+extern "C" float bench_psd_noise_min(const float *data_buf, size_t size, uint32_t fft_width) {
+    return psd_window_min(data_buf, size, psd_noise_window(RADIO_SAMPLES, fft_width));
+}
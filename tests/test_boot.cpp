@@ -0,0 +1,121 @@
+#include "../src/boot.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+
+static std::mutex           order_mux;
+static std::string          order;
+static std::thread::id      main_id;
+static std::atomic<bool>    off_main;
+static std::atomic<int>     running;
+static std::atomic<int>     max_running;
+
+static void mark(char c) {
+    std::lock_guard<std::mutex> lock(order_mux);
+
+    order += c;
+}
+
+static void slow() {
+    int n = ++running;
+    int max = max_running;
+
+    while (n > max && !max_running.compare_exchange_weak(max, n)) {
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    running--;
+}
+
+static void task_a() { mark('a'); }
+static void task_b() { mark('b'); }
+
+static void task_c() {
+    if (std::this_thread::get_id() != main_id) {
+        off_main = true;
+    }
+    mark('c');
+}
+
+static void task_slow() { slow(); }
+
+static void task_bg() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    mark('g');
+}
+
+static void wait_background() {
+    while (boot_background_left()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+TEST_CASE("Main tasks run in order on the calling thread after their dependencies", "[boot]") {
+    boot_task_t tasks[] = {
+        { "a", task_a, BOOT_WORKER, 0 },
+        { "b", task_b, BOOT_MAIN, BOOT_DEP(0) },
+        { "c", task_c, BOOT_MAIN, BOOT_DEP(1) },
+    };
+
+    order.clear();
+    main_id = std::this_thread::get_id();
+    off_main = false;
+
+    boot_run(tasks, 3);
+
+    REQUIRE(order == "abc");
+    REQUIRE_FALSE(off_main);
+}
+
+TEST_CASE("Independent worker tasks run in parallel", "[boot]") {
+    boot_task_t tasks[] = {
+        { "s1", task_slow, BOOT_WORKER, 0 },
+        { "s2", task_slow, BOOT_WORKER, 0 },
+        { "s3", task_slow, BOOT_WORKER, 0 },
+    };
+
+    running = 0;
+    max_running = 0;
+
+    boot_run(tasks, 3);
+
+    REQUIRE(max_running > 1);
+    REQUIRE(tasks[0].time >= 49);
+}
+
+TEST_CASE("Background task finishes after boot_run", "[boot]") {
+    boot_task_t tasks[] = {
+        { "g", task_bg, BOOT_BACKGROUND, 0 },
+        { "a", task_a, BOOT_MAIN, 0 },
+    };
+
+    order.clear();
+    boot_run(tasks, 2);
+
+    {
+        std::lock_guard<std::mutex> lock(order_mux);
+
+        REQUIRE(order == "a");
+    }
+
+    wait_background();
+    REQUIRE(order == "ag");
+}
+
+TEST_CASE("Dependency on a later task is dropped", "[boot]") {
+    boot_task_t tasks[] = {
+        { "a", task_a, BOOT_MAIN, BOOT_DEP(1) },
+        { "b", task_b, BOOT_MAIN, 0 },
+    };
+
+    order.clear();
+    boot_run(tasks, 2);
+
+    REQUIRE(order == "ab");
+    REQUIRE(tasks[0].deps == 0);
+}
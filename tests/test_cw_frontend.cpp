@@ -0,0 +1,196 @@
+#include "../src/cw_frontend.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#define RATE 44100
+
+struct output_t {
+    std::vector<float>  rms;
+    std::vector<float>  delayed;
+    std::vector<float>  psd;
+};
+
+/* Keyed 700 Hz tone with noise, "CQ" at 20 WPM */
+static std::vector<cfloat> make_vector() {
+    const char          *code = "-.-. --.-";
+    const size_t        dot = RATE * 60 / 1000;
+    std::vector<cfloat> out;
+    uint32_t            rnd = 1;
+    float               phase = 0.0f;
+
+    auto put = [&](size_t n, bool on) {
+        for (size_t i = 0; i < n; i++) {
+            rnd = rnd * 1664525 + 1013904223;
+            float noise = ((float) rnd / UINT32_MAX - 0.5f) * 0.02f;
+
+            phase += 2.0f * M_PI * 700.0f / RATE;
+            out.push_back(cfloat(on ? 0.3f * cosf(phase) : 0.0f, on ? 0.3f * sinf(phase) : 0.0f) + noise);
+        }
+    };
+
+    put(dot * 10, false);
+
+    for (const char *c = code; *c; c++) {
+        switch (*c) {
+            case '.': put(dot, true); put(dot, false); break;
+            case '-': put(dot * 3, true); put(dot, false); break;
+            case ' ': put(dot * 2, false); break;
+        }
+    }
+
+    put(dot * 10, false);
+
+    return out;
+}
+
+/* Former per-sample chain of cw.cpp */
+static output_t reference(const std::vector<cfloat> &in) {
+    output_t    out;
+    dds_cccf    dds = dds_cccf_create(CW_FRONTEND_STAGES, 700.0f / RATE, 500.0f / RATE, 60.0f);
+    cbuffercf   input_cbuf = cbuffercf_create(10000);
+    cbuffercf   fft_cbuf = cbuffercf_create(4000 / 8 * 2);
+    windowf     rms_window = windowf_create(CW_FRONTEND_RMS_SIZE);
+    wdelayf     rms_delay = wdelayf_create(CW_FRONTEND_RMS_DELAY);
+    int         remain = CW_FRONTEND_RMS_STEP;
+    float       window[CW_FRONTEND_FFT];
+    cfloat      fft_time[CW_FRONTEND_FFT];
+    cfloat      fft_freq[CW_FRONTEND_FFT];
+    fftplan     plan = fft_create_plan(CW_FRONTEND_FFT, fft_time, fft_freq, LIQUID_FFT_FORWARD, 0);
+    float       scale = 0.0f;
+
+    for (size_t i = 0; i < CW_FRONTEND_FFT; i++) {
+        window[i] = liquid_hann(i, CW_FRONTEND_FFT);
+        scale += window[i] * window[i];
+    }
+    scale = 1.0f / sqrtf(scale);
+    for (size_t i = 0; i < CW_FRONTEND_FFT; i++) {
+        window[i] *= scale;
+    }
+
+    for (size_t pos = 0; pos < in.size(); pos += 4410) {
+        size_t n = std::min((size_t) 4410, in.size() - pos);
+
+        cbuffercf_write(input_cbuf, (cfloat *) &in[pos], n);
+
+        while (cbuffercf_size(input_cbuf) >= CW_FRONTEND_DECIM) {
+            unsigned int    nr;
+            cfloat          *buf;
+            cfloat          sample;
+
+            cbuffercf_read(input_cbuf, CW_FRONTEND_DECIM, &buf, &nr);
+            dds_cccf_decim_execute(dds, buf, &sample);
+            cbuffercf_release(input_cbuf, CW_FRONTEND_DECIM);
+            cbuffercf_push(fft_cbuf, sample);
+
+            while (cbuffercf_size(fft_cbuf) >= CW_FRONTEND_FFT) {
+                for (size_t i = 0; i < CW_FRONTEND_FFT; i++) {
+                    cbuffercf_pop(fft_cbuf, &fft_time[i]);
+                    fft_time[i] *= window[i];
+                }
+                fft_execute(plan);
+
+                for (size_t i = 0; i < CW_FRONTEND_FFT; i++) {
+                    out.psd.push_back(std::real(fft_freq[i] * std::conj(fft_freq[i])));
+                }
+            }
+
+            if (remain == 0) {
+                remain = CW_FRONTEND_RMS_STEP;
+            }
+            remain--;
+
+            float x_db = 10.0f * log10f(std::abs(sample));
+
+            if (x_db < -121.0f) {
+                x_db = -121.0f;
+            }
+            windowf_push(rms_window, x_db);
+
+            if (remain == 0) {
+                float   *r;
+                float   rms = 0.0f;
+
+                windowf_read(rms_window, &r);
+                for (size_t i = 0; i < CW_FRONTEND_RMS_SIZE; i++) {
+                    rms += r[i];
+                }
+                rms = rms / CW_FRONTEND_RMS_SIZE;
+                out.rms.push_back(rms);
+
+                wdelayf_push(rms_delay, rms);
+                wdelayf_read(rms_delay, &rms);
+                out.delayed.push_back(rms);
+            }
+        }
+    }
+
+    dds_cccf_destroy(dds);
+    cbuffercf_destroy(input_cbuf);
+    cbuffercf_destroy(fft_cbuf);
+    windowf_destroy(rms_window);
+    wdelayf_destroy(rms_delay);
+    fft_destroy_plan(plan);
+
+    return out;
+}
+
+static void on_fft(const float *psd, void *user) {
+    output_t *out = (output_t *) user;
+
+    out->psd.insert(out->psd.end(), psd, psd + CW_FRONTEND_FFT);
+}
+
+static void on_rms(float rms_db, float delayed_db, void *user) {
+    output_t *out = (output_t *) user;
+
+    out->rms.push_back(rms_db);
+    out->delayed.push_back(delayed_db);
+}
+
+static bool same_bits(const std::vector<float> &a, const std::vector<float> &b) {
+    return a.size() == b.size() && memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+TEST_CASE("Block front end is bit-identical to per-sample chain", "[cw_frontend]") {
+    std::vector<cfloat> in = make_vector();
+    output_t            ref = reference(in);
+
+    /* Odd block sizes to check the tail handling */
+    for (size_t block : { 1, 63, 64, 441, 4410 }) {
+        output_t        out;
+        cw_frontend_t   fe = cw_frontend_create(on_fft, on_rms, &out);
+
+        cw_frontend_set_tone(fe, 700.0f / RATE, 500.0f / RATE);
+
+        for (size_t pos = 0; pos < in.size(); pos += block) {
+            cw_frontend_process(fe, std::min(block, in.size() - pos), &in[pos]);
+        }
+        cw_frontend_destroy(fe);
+
+        REQUIRE(!ref.rms.empty());
+        REQUIRE(same_bits(out.rms, ref.rms));
+        REQUIRE(same_bits(out.delayed, ref.delayed));
+        REQUIRE(same_bits(out.psd, ref.psd));
+    }
+}
+
+TEST_CASE("Tone is detected", "[cw_frontend]") {
+    std::vector<cfloat> in = make_vector();
+    output_t            out;
+    cw_frontend_t       fe = cw_frontend_create(on_fft, on_rms, &out);
+
+    cw_frontend_set_tone(fe, 700.0f / RATE, 500.0f / RATE);
+    cw_frontend_process(fe, in.size(), in.data());
+    cw_frontend_destroy(fe);
+
+    float min = *std::min_element(out.rms.begin(), out.rms.end());
+    float max = *std::max_element(out.rms.begin(), out.rms.end());
+
+    REQUIRE(max - min > 20.0f);
+}
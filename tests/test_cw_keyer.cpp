@@ -0,0 +1,215 @@
+#include "../src/cw_keyer.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <pthread.h>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+#define MS  1000000LL
+
+static int64_t now_ns() {
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (int64_t) t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+struct edges_t {
+    std::vector<int64_t>    time;
+    std::vector<bool>       on;
+};
+
+static void key_cb(bool on, void *user) {
+    edges_t *edges = (edges_t *) user;
+
+    edges->time.push_back(now_ns());
+    edges->on.push_back(on);
+}
+
+/* Ideal key edges from the start of the message, straight from the element durations */
+static std::vector<int64_t> make_timeline(const char *text, const cw_keyer_durations_t &d) {
+    std::vector<int64_t>    out;
+    int64_t                 t = 0;
+
+    while (*text) {
+        if (*text == ' ') {
+            t += d.word_space - d.char_space;
+            text++;
+            continue;
+        }
+
+        cw_morse_t  m;
+        size_t      len = cw_morse_encode(text, &m);
+
+        REQUIRE(len > 0);
+
+        for (uint8_t i = 0; i < m.len; i++) {
+            out.push_back(t);
+            t += cw_morse_dah(m, i) ? d.dah : d.dit;
+            out.push_back(t);
+            t += (i == m.len - 1) ? d.char_space : d.element_space;
+        }
+
+        text += len;
+    }
+
+    return out;
+}
+
+struct send_t {
+    cw_keyer_t              *keyer;
+    const char              *text;
+    int64_t                 start;
+};
+
+static void * send_thread(void *arg) {
+    send_t      *send = (send_t *) arg;
+    cw_keyer_t  *keyer = send->keyer;
+
+    send->start = now_ns();
+    cw_keyer_start(keyer);
+
+    for (const char *c = send->text; *c; c++) {
+        cw_morse_t m;
+
+        if (*c == ' ') {
+            cw_keyer_word_space(keyer);
+            continue;
+        }
+
+        cw_morse_encode(c, &m);
+        cw_keyer_send(keyer, m);
+    }
+
+    cw_keyer_wait(keyer);
+    return NULL;
+}
+
+TEST_CASE("Element durations", "[cw_keyer]") {
+    cw_keyer_durations_t    d;
+    cw_keyer_params_t       params = { .wpm = 20, .farnsworth_wpm = 0, .ratio = 3.0f, .weight = 50 };
+
+    cw_keyer_durations(&params, &d);
+
+    REQUIRE(d.dit == 60 * MS);
+    REQUIRE(d.dah == 180 * MS);
+    REQUIRE(d.element_space == 60 * MS);
+    REQUIRE(d.char_space == 180 * MS);
+    REQUIRE(d.word_space == 420 * MS);
+
+    /* Weight moves time from the space to the mark */
+    params.weight = 60;
+    cw_keyer_durations(&params, &d);
+
+    REQUIRE(d.dit == 72 * MS);
+    REQUIRE(d.dah == 192 * MS);
+    REQUIRE(d.element_space == 48 * MS);
+    REQUIRE(d.dit + d.element_space == 120 * MS);
+
+    /* Farnsworth: characters at 20 wpm, PARIS takes a minute / 10 */
+    params.weight = 50;
+    params.farnsworth_wpm = 10;
+    cw_keyer_durations(&params, &d);
+
+    int64_t paris = 10 * d.dit + 4 * d.dah + 9 * d.element_space + 4 * d.char_space + d.word_space;
+
+    REQUIRE(d.dit == 60 * MS);
+    REQUIRE(std::llabs(paris - 6000 * MS) < MS);
+
+    /* Farnsworth above the character speed is ignored */
+    params.farnsworth_wpm = 30;
+    cw_keyer_durations(&params, &d);
+
+    REQUIRE(d.char_space == 180 * MS);
+}
+
+TEST_CASE("Timing under load", "[cw_keyer]") {
+    std::atomic<bool>           run(true);
+    std::vector<std::thread>    load;
+    unsigned int                n = std::thread::hardware_concurrency();
+
+    for (unsigned int i = 0; i < (n ? n : 2) * 2; i++) {
+        load.emplace_back([&run] {
+            volatile uint64_t x = 0;
+
+            while (run) {
+                x = x + 1;
+            }
+        });
+    }
+
+    edges_t                 edges;
+    cw_keyer_t              keyer;
+    cw_keyer_params_t       params = { .wpm = 60, .farnsworth_wpm = 0, .ratio = 3.0f, .weight = 50 };
+    cw_keyer_durations_t    d;
+    send_t                  send = { .keyer = &keyer, .text = "PARIS PARIS PARIS" };
+
+    cw_keyer_durations(&params, &d);
+
+    std::vector<int64_t>    expected = make_timeline(send.text, d);
+
+    cw_keyer_init(&keyer, &params, key_cb, &edges);
+
+    /* Same as the encoder: real-time thread, a normal one without privileges */
+
+    pthread_t           thread;
+    pthread_attr_t      attr;
+    struct sched_param  param = { .sched_priority = 10 };
+
+    pthread_attr_init(&attr);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+    pthread_attr_setschedparam(&attr, &param);
+
+    bool realtime = pthread_create(&thread, &attr, send_thread, &send) == 0;
+
+    if (!realtime) {
+        REQUIRE(pthread_create(&thread, NULL, send_thread, &send) == 0);
+    }
+
+    pthread_attr_destroy(&attr);
+    pthread_join(thread, NULL);
+
+    run = false;
+    for (auto &t : load) {
+        t.join();
+    }
+
+    REQUIRE(edges.time.size() == expected.size());
+    REQUIRE(keyer.stat.edges == expected.size());
+
+    /* Edges are never early: the keyer counts from a moment after send.start */
+
+    int64_t max_error = 0;
+
+    for (size_t i = 0; i < expected.size(); i++) {
+        REQUIRE(edges.on[i] == (i % 2 == 0));
+        REQUIRE(edges.time[i] - send.start >= expected[i]);
+
+        int64_t error = (edges.time[i] - edges.time[0]) - (expected[i] - expected[0]);
+
+        max_error = std::max<int64_t>(max_error, std::llabs(error));
+    }
+
+    /* Late wake ups must not accumulate, whatever the scheduler does */
+
+    int64_t length = edges.time.back() - edges.time.front();
+    int64_t ideal = expected.back() - expected.front();
+
+    CAPTURE(length / MS, ideal / MS, max_error / MS);
+    REQUIRE(std::llabs(length - ideal) < 50 * MS);
+
+    /* Wake up latency of each edge is bounded only for the real-time thread */
+
+    if (!realtime) {
+        SKIP("No real-time priority, max error " << max_error / MS << " ms");
+    }
+
+    REQUIRE(max_error < 10 * MS);
+}
@@ -0,0 +1,108 @@
+#include "../src/cw_morse.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <string>
+
+static std::string to_string(cw_morse_t m) {
+    std::string out;
+
+    for (uint8_t i = 0; i < m.len; i++) {
+        out += cw_morse_dah(m, i) ? '-' : '.';
+    }
+
+    return out;
+}
+
+static void check_table(cw_characters_t *table, cw_morse_alphabet_t alphabet) {
+    for (cw_characters_t *c = table; c->morse; c++) {
+        cw_morse_t  m = cw_morse_from_string(c->morse);
+        const char  *decoded = cw_morse_decode(m, alphabet);
+
+        INFO(c->character << " " << c->morse);
+        REQUIRE(to_string(m) == c->morse);
+        REQUIRE(decoded != nullptr);
+        REQUIRE(std::string(decoded) == c->character);
+
+        /* Duplicated characters are encoded with the first code, which decodes back the same */
+        cw_morse_t  encoded;
+        size_t      len = cw_morse_encode(c->character, &encoded);
+
+        REQUIRE(len == strlen(c->character));
+        REQUIRE(std::string(cw_morse_decode(encoded, alphabet)) == c->character);
+    }
+}
+
+TEST_CASE("Latin table both ways", "[cw_morse]") {
+    check_table(cw_characters, CW_MORSE_LATIN);
+    check_table(cw_prosigns, CW_MORSE_LATIN);
+}
+
+TEST_CASE("Cyrillic table both ways", "[cw_morse]") {
+    check_table(cw_characters_cyrillic, CW_MORSE_CYRILLIC);
+    check_table(cw_prosigns, CW_MORSE_CYRILLIC);
+
+    /* Digits are shared, letters are not */
+    REQUIRE(std::string(cw_morse_decode(cw_morse_from_string(".----"), CW_MORSE_CYRILLIC)) == "1");
+    REQUIRE(std::string(cw_morse_decode(cw_morse_from_string("--.-"), CW_MORSE_CYRILLIC)) == "Щ");
+    REQUIRE(std::string(cw_morse_decode(cw_morse_from_string("--.-"), CW_MORSE_LATIN)) == "Q");
+}
+
+TEST_CASE("Unknown and too long codes", "[cw_morse]") {
+    cw_morse_t m;
+
+    cw_morse_clear(&m);
+    REQUIRE(cw_morse_decode(m, CW_MORSE_LATIN) == nullptr);
+
+    REQUIRE(cw_morse_decode(cw_morse_from_string("..--..--"), CW_MORSE_LATIN) == nullptr);
+
+    for (int i = 0; i < CW_MORSE_MAX_LEN + 5; i++) {
+        cw_morse_push(&m, false);
+    }
+    REQUIRE(cw_morse_decode(m, CW_MORSE_LATIN) == nullptr);
+
+    REQUIRE(cw_morse_encode("~", &m) == 0);
+    REQUIRE(cw_morse_encode("<XX>", &m) == 0);
+}
+
+TEST_CASE("Encode text", "[cw_morse]") {
+    const char  *text = "cq<AR>5";
+    const char  *expected[] = { "-.-.", "--.-", ".-.-.", "....." };
+    size_t      n = 0;
+
+    while (*text) {
+        cw_morse_t  m;
+        size_t      len = cw_morse_encode(text, &m);
+
+        REQUIRE(len > 0);
+        REQUIRE(to_string(m) == expected[n++]);
+        text += len;
+    }
+
+    REQUIRE(n == 4);
+}
+
+TEST_CASE("Encode lower case Cyrillic", "[cw_morse]") {
+    const char  *upper = "ПРИВЕТЁЩЪЯ";
+    const char  *lower = "приветёщъя";
+
+    while (*upper) {
+        cw_morse_t  mu, ml;
+        size_t      len_u = cw_morse_encode(upper, &mu);
+        size_t      len_l = cw_morse_encode(lower, &ml);
+
+        REQUIRE(len_u == 2);
+        REQUIRE(len_l == 2);
+        REQUIRE(to_string(mu) == to_string(ml));
+        upper += len_u;
+        lower += len_l;
+    }
+
+    cw_morse_t m;
+
+    REQUIRE(cw_morse_encode("ё", &m) == 2);
+    REQUIRE(to_string(m) == ".");
+    REQUIRE(cw_morse_encode("я", &m) == 2);
+    REQUIRE(to_string(m) == ".-.-");
+}
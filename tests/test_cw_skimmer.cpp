@@ -0,0 +1,121 @@
+#include "../src/cw_skimmer.h"
+#include "../src/cw_morse.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define RATE 44100
+
+/* Main receiver decoder is not used here */
+extern "C" void pannel_add_text(const char *text) {
+}
+
+/* Key down intervals in ms, from the start */
+static std::vector<std::pair<float, float>> make_keying(const char *text, float wpm, float start) {
+    std::vector<std::pair<float, float>>    out;
+    float                                   dot = 1200.0f / wpm;
+    float                                   t = start;
+
+    while (*text) {
+        if (*text == ' ') {
+            t += dot * 4;           /* 3 after the letter already */
+            text++;
+            continue;
+        }
+
+        cw_morse_t  m;
+        size_t      len = cw_morse_encode(text, &m);
+
+        REQUIRE(len > 0);
+
+        for (uint8_t i = 0; i < m.len; i++) {
+            float d = cw_morse_dah(m, i) ? dot * 3 : dot;
+
+            out.push_back({ t, t + d });
+            t += d + dot;
+        }
+
+        t += dot * 2;
+        text += len;
+    }
+
+    return out;
+}
+
+/* 5 ms raised cosine edges keep the keying clicks out of the neighbour channels */
+static void add_signal(std::vector<cfloat> &out, const char *text, float freq, float wpm, float start) {
+    const float ramp = 5.0f;
+
+    for (auto &[on, off] : make_keying(text, wpm, start)) {
+        size_t from = on * RATE / 1000;
+        size_t to = (off + ramp) * RATE / 1000;
+
+        for (size_t n = from; n < to && n < out.size(); n++) {
+            float ms = n * 1000.0f / RATE;
+            float a = 1.0f;
+
+            if (ms < on + ramp) {
+                a = 0.5f - 0.5f * cosf(M_PI * (ms - on) / ramp);
+            } else if (ms > off) {
+                a = 0.5f + 0.5f * cosf(M_PI * (ms - off) / ramp);
+            }
+
+            out[n] += std::polar(0.1f * a, (float) (2.0 * M_PI * freq * n / RATE));
+        }
+    }
+}
+
+TEST_CASE("Several signals are decoded at once", "[cw_skimmer]") {
+    struct {
+        float       freq;
+        float       wpm;
+        const char  *call;
+    } signals[] = {
+        { 600.0f, 18.0f, "R2RFE" },
+        { 1100.0f, 25.0f, "UA9XYZ" },
+        { 1800.0f, 30.0f, "DL1ABC" },
+    };
+
+    std::vector<cfloat> in(RATE * 30);
+    uint32_t            rnd = 1;
+
+    for (auto &x : in) {
+        rnd = rnd * 1664525 + 1013904223;
+        x = ((float) rnd / UINT32_MAX - 0.5f) * 0.05f;
+    }
+
+    for (auto &s : signals) {
+        std::string text;
+
+        for (int i = 0; i < 3; i++) {
+            text += std::string("CQ CQ DE ") + s.call + " " + s.call + " K ";
+        }
+        add_signal(in, text.c_str(), s.freq, s.wpm, 500.0f);
+    }
+
+    cw_skimmer_start();
+
+    for (size_t pos = 0; pos < in.size(); pos += 4410) {
+        cw_skimmer_put_audio_samples(std::min((size_t) 4410, in.size() - pos), &in[pos]);
+    }
+
+    cw_skimmer_entry_t  entries[CW_SKIMMER_TRACKS];
+    size_t              count = cw_skimmer_get(entries, CW_SKIMMER_TRACKS);
+
+    cw_skimmer_stop();
+
+    REQUIRE(count == 3);
+
+    for (size_t i = 0; i < count; i++) {
+        CAPTURE(i, entries[i].freq, entries[i].wpm, entries[i].text);
+
+        REQUIRE(fabsf(entries[i].freq - signals[i].freq) < 40.0f);
+        REQUIRE(strcmp(entries[i].call, signals[i].call) == 0);
+        REQUIRE(fabsf((float) entries[i].wpm - signals[i].wpm) <= 3.0f);
+    }
+}
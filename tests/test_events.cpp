@@ -0,0 +1,154 @@
+extern "C" {
+    #include "../src/events.h"
+    #include "../src/keyboard.h"
+
+    lv_group_t  *keyboard_group;
+}
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <utility>
+#include <vector>
+
+#define QUEUE_CAPACITY  63      /* One slot of QUEUE_SIZE is kept free */
+
+static std::vector<std::pair<lv_obj_t *, int32_t>>  rotary;
+static std::vector<lv_event_code_t>                 other;
+
+static void event_cb(lv_event_t *e) {
+    lv_event_code_t code = lv_event_get_code(e);
+
+    if (code == EVENT_ROTARY) {
+        rotary.push_back({ lv_event_get_target(e), *(int32_t *) lv_event_get_param(e) });
+    } else if (code == EVENT_KEYPAD) {
+        other.push_back(code);
+    }
+}
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+    lv_disp_flush_ready(drv);
+}
+
+/* Two objects on a display without output */
+static void init(lv_obj_t **a, lv_obj_t **b) {
+    static lv_color_t           buf[480 * 10];
+    static lv_disp_draw_buf_t   disp_buf;
+    static lv_disp_drv_t        disp_drv;
+    static lv_obj_t             *obj[2];
+
+    if (!obj[0]) {
+        lv_init();
+        event_init();
+
+        lv_disp_draw_buf_init(&disp_buf, buf, NULL, sizeof(buf) / sizeof(buf[0]));
+        lv_disp_drv_init(&disp_drv);
+        disp_drv.draw_buf = &disp_buf;
+        disp_drv.flush_cb = flush_cb;
+        disp_drv.hor_res = 480;
+        disp_drv.ver_res = 320;
+        lv_disp_drv_register(&disp_drv);
+
+        for (auto &o : obj) {
+            o = lv_obj_create(lv_scr_act());
+            lv_obj_add_event_cb(o, event_cb, LV_EVENT_ALL, NULL);
+        }
+    }
+
+    *a = obj[0];
+    *b = obj[1];
+
+    event_obj_check();
+    rotary.clear();
+    other.clear();
+}
+
+TEST_CASE("Rotary diff to the same object is merged", "[events]") {
+    lv_obj_t *a, *b;
+
+    init(&a, &b);
+
+    event_send_rotary(a, 1);
+    event_send_rotary(a, 2);
+    event_send_rotary(a, -1);
+    event_obj_check();
+
+    REQUIRE(rotary.size() == 1);
+    REQUIRE(rotary[0].first == a);
+    REQUIRE(rotary[0].second == 2);
+}
+
+TEST_CASE("Rotary diff to another object is not merged", "[events]") {
+    lv_obj_t *a, *b;
+
+    init(&a, &b);
+
+    event_send_rotary(a, 1);
+    event_send_rotary(b, 2);
+    event_send_rotary(a, 3);
+    event_obj_check();
+
+    REQUIRE(rotary.size() == 3);
+    REQUIRE(rotary[0] == std::make_pair(a, (int32_t) 1));
+    REQUIRE(rotary[1] == std::make_pair(b, (int32_t) 2));
+    REQUIRE(rotary[2] == std::make_pair(a, (int32_t) 3));
+
+    /* Other event in between keeps the order */
+
+    event_keypad_t keypad = { .key = KEYPAD_F1, .state = KEYPAD_PRESS };
+
+    rotary.clear();
+    event_send_rotary(a, 1);
+    event_send(a, (lv_event_code_t) EVENT_KEYPAD, &keypad, sizeof(keypad));
+    event_send_rotary(a, 1);
+    event_obj_check();
+
+    REQUIRE(rotary.size() == 2);
+    REQUIRE(other.size() == 1);
+
+    /* Dispatched diff is not changed by later ones */
+
+    rotary.clear();
+    event_send_rotary(a, 1);
+    event_obj_check();
+    event_send_rotary(a, 5);
+    event_obj_check();
+
+    REQUIRE(rotary.size() == 2);
+    REQUIRE(rotary[0].second == 1);
+    REQUIRE(rotary[1].second == 5);
+}
+
+TEST_CASE("Full queue drops new events", "[events]") {
+    lv_obj_t        *a, *b;
+    event_keypad_t  keypad = { .key = KEYPAD_F1, .state = KEYPAD_PRESS };
+
+    init(&a, &b);
+
+    for (int i = 0; i < QUEUE_CAPACITY - 1; i++) {
+        event_send(b, (lv_event_code_t) EVENT_KEYPAD, &keypad, sizeof(keypad));
+    }
+    event_send_rotary(a, 1);
+
+    /* No free slot, but the pending rotary still takes the diff */
+
+    event_send(b, (lv_event_code_t) EVENT_KEYPAD, &keypad, sizeof(keypad));
+    event_send_rotary(b, 10);
+    event_send_rotary(a, 1);
+
+    REQUIRE(event_get_peak_depth() == QUEUE_CAPACITY);
+
+    event_obj_check();
+
+    REQUIRE(other.size() == QUEUE_CAPACITY - 1);
+    REQUIRE(rotary.size() == 1);
+    REQUIRE(rotary[0] == std::make_pair(a, (int32_t) 2));
+
+    /* Works again after the drain */
+
+    rotary.clear();
+    event_send_rotary(b, 10);
+    event_obj_check();
+
+    REQUIRE(rotary.size() == 1);
+    REQUIRE(rotary[0] == std::make_pair(b, (int32_t) 10));
+}
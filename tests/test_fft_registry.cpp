@@ -0,0 +1,134 @@
+#include "../src/fft_registry.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Windows are shared", "[fft_registry]") {
+    const float *a = fft_registry_window_get(128, FFT_WINDOW_HANN_POWER);
+    const float *b = fft_registry_window_get(128, FFT_WINDOW_HANN_POWER);
+    const float *c = fft_registry_window_get(128, FFT_WINDOW_HANN);
+
+    REQUIRE(a == b);
+    REQUIRE(a != c);
+
+    float power = 0.0f;
+
+    for (size_t i = 0; i < 128; i++) {
+        power += a[i] * a[i];
+    }
+
+    REQUIRE(std::fabs(power - 1.0f) < 1e-5f);
+
+    fft_registry_window_put(a);
+    fft_registry_window_put(b);
+    fft_registry_window_put(c);
+}
+
+TEST_CASE("Plans are pooled", "[fft_registry]") {
+    fft_registry_plan_t *a = fft_registry_plan_get(256, LIQUID_FFT_FORWARD);
+    fft_registry_plan_t *b = fft_registry_plan_get(256, LIQUID_FFT_FORWARD);
+
+    /* Plan has own buffers, so users at the same time get different ones */
+    REQUIRE(a != b);
+    REQUIRE(a->time != b->time);
+    REQUIRE(a->size == 256);
+
+    fft_registry_plan_put(a);
+
+    /* Released plan is taken again without setup */
+    fft_registry_plan_t *c = fft_registry_plan_get(256, LIQUID_FFT_FORWARD);
+
+    REQUIRE(c == a);
+
+    for (size_t i = 0; i < 256; i++) {
+        c->time[i] = (i == 1) ? 1.0f : 0.0f;
+    }
+
+    fft_execute(c->plan);
+
+    REQUIRE(std::abs(c->freq[0] - cfloat(1.0f, 0.0f)) < 1e-5f);
+
+    fft_registry_plan_put(b);
+    fft_registry_plan_put(c);
+}
+
+TEST_CASE("Concurrent users", "[fft_registry]") {
+    const int                   threads_count = 8;
+    std::vector<std::thread>    threads;
+    std::mutex                  held_mux;
+    std::set<void *>            held;
+    std::atomic<int>            shared(0);
+    fft_registry_stat_t         before, after;
+
+    fft_registry_get_stat(&before);
+
+    for (int t = 0; t < threads_count; t++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 1000; i++) {
+                fft_registry_plan_t *p = fft_registry_plan_get(64, LIQUID_FFT_FORWARD);
+                const float         *w = fft_registry_window_get(64, FFT_WINDOW_HANN);
+
+                /* Plans held at the same time are distinct */
+                {
+                    std::lock_guard<std::mutex> lock(held_mux);
+
+                    if (!held.insert(p).second) {
+                        shared++;
+                    }
+                }
+
+                p->time[0] = w[10];
+                std::this_thread::yield();
+
+                {
+                    std::lock_guard<std::mutex> lock(held_mux);
+
+                    held.erase(p);
+                }
+
+                fft_registry_window_put(w);
+                fft_registry_plan_put(p);
+            }
+        });
+    }
+
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    fft_registry_get_stat(&after);
+
+    REQUIRE(shared == 0);
+    REQUIRE(after.refs == 0);
+
+    /* One plan per thread at most, and the window */
+    REQUIRE(after.entries - before.entries <= threads_count + 1);
+
+    /* Released plans are taken again, nothing new is made */
+    std::vector<fft_registry_plan_t *> plans;
+
+    for (uint32_t i = 0; i < after.entries - before.entries - 1; i++) {
+        plans.push_back(fft_registry_plan_get(64, LIQUID_FFT_FORWARD));
+    }
+
+    fft_registry_stat_t reuse;
+
+    fft_registry_get_stat(&reuse);
+
+    REQUIRE(reuse.entries == after.entries);
+    REQUIRE(reuse.refs == after.refs + plans.size());
+
+    for (auto p : plans) {
+        fft_registry_plan_put(p);
+    }
+
+    fft_registry_get_stat(&reuse);
+
+    REQUIRE(reuse.refs == 0);
+}
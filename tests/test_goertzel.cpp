@@ -0,0 +1,122 @@
+#include "../src/goertzel.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <liquid/liquid.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#define N 256
+
+/* Tones and noise, the same block for the bank and the FFT */
+static std::vector<float> make_block() {
+    std::vector<float>  out(N);
+    uint32_t            rnd = 1;
+
+    for (size_t i = 0; i < N; i++) {
+        rnd = rnd * 1664525 + 1013904223;
+
+        out[i] = 0.5f * cosf(2.0f * M_PI * 10 * i / N)
+               + 0.2f * sinf(2.0f * M_PI * 37 * i / N + 0.3f)
+               + ((float) rnd / UINT32_MAX - 0.5f) * 0.1f;
+    }
+
+    return out;
+}
+
+static std::vector<float> fft_magnitude(const std::vector<float> &in) {
+    std::vector<liquid_float_complex>   x(N), y(N);
+    std::vector<float>                  out(N);
+    fftplan                             plan = fft_create_plan(N, x.data(), y.data(), LIQUID_FFT_FORWARD, 0);
+
+    for (size_t i = 0; i < N; i++) {
+        x[i] = in[i];
+    }
+
+    fft_execute(plan);
+    fft_destroy_plan(plan);
+
+    for (size_t i = 0; i < N; i++) {
+        out[i] = std::abs(y[i]);
+    }
+
+    return out;
+}
+
+TEST_CASE("Bank matches FFT bins", "[goertzel]") {
+    std::vector<float>  in = make_block();
+    std::vector<float>  ref = fft_magnitude(in);
+
+    /* Odd counts check the padded tail */
+    for (uint16_t count : { 1, 5, 8, 13, 64 }) {
+        goertzel_bank_t     bank;
+        std::vector<float>  out(count);
+
+        goertzel_bank_init(&bank, count);
+
+        for (uint16_t k = 0; k < count; k++) {
+            goertzel_bank_bin_init(&bank, k, (k * 7 + 3) % (N / 2), N);
+        }
+
+        /* Split block to check that state is kept between calls, odd part too */
+        goertzel_bank_input(&bank, in.data(), 101);
+        goertzel_bank_input(&bank, in.data() + 101, N - 101);
+        goertzel_bank_output(&bank, out.data());
+
+        for (uint16_t k = 0; k < count; k++) {
+            REQUIRE(out[k] == Catch::Approx(ref[(k * 7 + 3) % (N / 2)]).margin(1e-3));
+        }
+    }
+}
+
+TEST_CASE("Bank matches scalar filter", "[goertzel]") {
+    std::vector<float>  in = make_block();
+    goertzel_bank_t     bank;
+    float               out[3];
+    uint32_t            freqs[3] = { 700, 1000, 1300 };
+
+    goertzel_bank_init(&bank, 3);
+
+    for (int k = 0; k < 3; k++) {
+        goertzel_bank_freq_init(&bank, k, freqs[k], 8000, N);
+    }
+
+    goertzel_bank_input(&bank, in.data(), N);
+    goertzel_bank_output(&bank, out);
+
+    for (int k = 0; k < 3; k++) {
+        goertzel_t g;
+
+        goertzel_freq_init(&g, freqs[k], 8000, N);
+
+        for (size_t i = 0; i < N; i++) {
+            goertzel_input(&g, in[i]);
+        }
+
+        REQUIRE(out[k] == Catch::Approx(goertzel_output(&g)).epsilon(1e-5));
+    }
+
+    goertzel_bank_reset(&bank);
+    goertzel_bank_output(&bank, out);
+
+    REQUIRE(out[0] == 0.0f);
+}
+
+TEST_CASE("Bank ignores tones out of range", "[goertzel]") {
+    goertzel_bank_t bank;
+
+    goertzel_bank_init(&bank, GOERTZEL_BANK_MAX + 10);
+
+    REQUIRE(bank.count == GOERTZEL_BANK_MAX);
+
+    goertzel_bank_t copy = bank;
+
+    goertzel_bank_bin_init(&bank, GOERTZEL_BANK_MAX, 10, N);
+    goertzel_bank_freq_init(&bank, GOERTZEL_BANK_MAX + 100, 1000, 8000, N);
+
+    REQUIRE(memcmp(&bank, &copy, sizeof(bank)) == 0);
+}
@@ -0,0 +1,132 @@
+#include "../src/psk_rx.h"
+#include "../src/psk_varicode.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define RATE 44100
+
+TEST_CASE("Varicode is prefix free", "[psk]") {
+    for (int c = 0; c < 128; c++) {
+        psk_varicode_t code = psk_varicode_encode(c);
+
+        REQUIRE(code.len > 0);
+        REQUIRE(code.len <= PSK_VARICODE_MAX_LEN);
+        REQUIRE((code.bits & 1) == 1);
+        REQUIRE((code.bits >> (code.len - 1)) == 1);
+
+        for (int i = 0; i < code.len - 1; i++) {
+            REQUIRE(((code.bits >> i) & 3) != 0);
+        }
+
+        if (c) {
+            REQUIRE(psk_varicode_decode(code.bits) == c);
+        }
+    }
+
+    REQUIRE(psk_varicode_encode(' ').bits == 0b1);
+    REQUIRE(psk_varicode_encode('e').bits == 0b11);
+    REQUIRE(psk_varicode_encode('E').bits == 0b1110111);
+    REQUIRE(psk_varicode_decode(0b100) == 0);
+}
+
+/* Phase reversal is zero, amplitude goes through zero by cosine on reversals */
+static std::vector<cfloat> make_psk(const char *text, float freq, float baud) {
+    std::vector<bool>   bits;
+    std::vector<cfloat> out;
+    uint32_t            rnd = 1;
+
+    for (int i = 0; i < 64; i++) {
+        bits.push_back(false);
+    }
+
+    for (const char *c = text; *c; c++) {
+        psk_varicode_t code = psk_varicode_encode(*c);
+
+        for (int i = code.len - 1; i >= 0; i--) {
+            bits.push_back((code.bits >> i) & 1);
+        }
+        bits.push_back(false);
+        bits.push_back(false);
+    }
+
+    for (int i = 0; i < 64; i++) {
+        bits.push_back(true);
+    }
+
+    float   symbol = RATE / baud;
+    float   sign = 1.0f;
+    size_t  n = 0;
+
+    for (size_t k = 0; k < bits.size(); k++) {
+        float next = bits[k] ? sign : -sign;
+
+        for (; n < (k + 1) * symbol; n++) {
+            float t = (n - k * symbol) / symbol;
+            float a = (sign == next) ? sign : sign * cosf(M_PI * t);
+
+            rnd = rnd * 1664525 + 1013904223;
+            float noise = ((float) rnd / UINT32_MAX - 0.5f) * 0.05f;
+
+            out.push_back(std::polar(0.3f * a, (float) (2.0 * M_PI * freq * n / RATE)) + noise);
+        }
+
+        sign = next;
+    }
+
+    return out;
+}
+
+static void on_text(uint8_t channel, char c, void *user) {
+    std::vector<std::string> *text = (std::vector<std::string> *) user;
+
+    (*text)[channel] += c;
+}
+
+TEST_CASE("PSK31 and PSK63 are decoded", "[psk]") {
+    for (float baud : { 31.25f, 62.5f }) {
+        std::vector<cfloat>         in = make_psk("CQ CQ CQ DE R2RFE R2RFE K", 1010.0f, baud);
+        std::vector<std::string>    text(PSK_RX_CHANNELS);
+        psk_rx_t                    rx = psk_rx_create(baud, RATE, on_text, &text);
+
+        psk_rx_tune(rx, 0, 1000.0f);
+
+        for (size_t pos = 0; pos < in.size(); pos += 4410) {
+            psk_rx_process(rx, std::min((size_t) 4410, in.size() - pos), &in[pos]);
+        }
+
+        REQUIRE(fabsf(psk_rx_get_freq(rx, 0) - 1010.0f) < 2.0f);
+        psk_rx_destroy(rx);
+
+        REQUIRE(text[0].find("DE R2RFE") != std::string::npos);
+    }
+}
+
+TEST_CASE("Multi-channel mode finds signals", "[psk]") {
+    std::vector<cfloat>         a = make_psk("CQ CQ DE R2RFE R2RFE K", 800.0f, 31.25f);
+    std::vector<cfloat>         b = make_psk("CQ CQ DE R1CBU R1CBU K", 1500.0f, 31.25f);
+    std::vector<std::string>    text(PSK_RX_CHANNELS);
+    psk_rx_t                    rx = psk_rx_create(31.25f, RATE, on_text, &text);
+
+    for (size_t i = 0; i < a.size() && i < b.size(); i++) {
+        a[i] += b[i];
+    }
+
+    psk_rx_set_detect(rx, true);
+    psk_rx_process(rx, a.size(), a.data());
+    psk_rx_destroy(rx);
+
+    std::string all;
+
+    for (auto &t : text) {
+        all += t + "|";
+    }
+
+    REQUIRE(all.find("R2RFE") != std::string::npos);
+    REQUIRE(all.find("R1CBU") != std::string::npos);
+}
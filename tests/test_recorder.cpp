@@ -0,0 +1,158 @@
+#include "../src/cfg/subjects.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sndfile.h>
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdarg>
+#include <mutex>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "../src/recorder.h"
+#include "../src/audio.h"
+#include "../src/scheduler.h"
+#include "../src/params/params.h"
+}
+
+params_t params;
+
+static std::mutex               msg_mux;
+static std::condition_variable  msg_cond;
+static std::string              msg_last;
+
+extern "C" void msg_update_text_fmt(const char *fmt, ...) {
+}
+
+extern "C" void msg_schedule_text_fmt(const char *fmt, ...) {
+    char    text[128];
+    va_list args;
+
+    va_start(args, fmt);
+    vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+
+    std::lock_guard<std::mutex> lock(msg_mux);
+
+    msg_last = text;
+    msg_cond.notify_all();
+}
+
+extern "C" void dialog_recorder_set_on(bool on) {
+}
+
+extern "C" void scheduler_put_noargs(scheduler_fn_t fn) {
+    fn(NULL);
+}
+
+/* Goertzel power of the tone at freq */
+static float tone_power(const std::vector<short> &x, size_t from, size_t len, float freq, float rate) {
+    float   k = 2.0f * cosf(2.0f * M_PI * freq / rate);
+    float   s1 = 0.0f, s2 = 0.0f;
+
+    for (size_t i = from; i < from + len; i++) {
+        float s = x[i] + k * s1 - s2;
+
+        s2 = s1;
+        s1 = s;
+    }
+
+    return s1 * s1 + s2 * s2 - k * s1 * s2;
+}
+
+TEST_CASE("Recorded buffer is encoded to the file", "[recorder]") {
+    char        dir[] = "/tmp/test_recorder_XXXXXX";
+    const float freq = 1000.0f;
+    const short amp = 8000;
+
+    REQUIRE(mkdtemp(dir) != NULL);
+
+    recorder_path = dir;
+    recorder_init();
+
+    std::vector<short> in(AUDIO_CAPTURE_RATE * 2);
+
+    for (size_t i = 0; i < in.size(); i++) {
+        in[i] = amp * sinf(2.0f * M_PI * freq * i / AUDIO_CAPTURE_RATE);
+    }
+
+    recorder_set_on(true);
+    REQUIRE(recorder_is_on());
+
+    /* Capture callback chunks */
+    for (size_t pos = 0; pos < in.size(); pos += 1024) {
+        recorder_put_audio_samples(std::min((size_t) 1024, in.size() - pos), &in[pos]);
+        usleep(1000);
+    }
+
+    recorder_set_on(false);
+    REQUIRE_FALSE(recorder_is_on());
+
+    {
+        std::unique_lock<std::mutex> lock(msg_mux);
+
+        REQUIRE(msg_cond.wait_for(lock, std::chrono::seconds(10), [] { return msg_last == "Recorder is off"; }));
+    }
+
+    std::string     name;
+    DIR             *dp = opendir(dir);
+    struct dirent   *ep;
+
+    REQUIRE(dp != NULL);
+
+    while ((ep = readdir(dp)) != NULL) {
+        if (ep->d_name[0] != '.') {
+            name = std::string(dir) + "/" + ep->d_name;
+        }
+    }
+    closedir(dp);
+
+    REQUIRE_FALSE(name.empty());
+
+    SF_INFO info = {};
+    SNDFILE *file = sf_open(name.c_str(), SFM_READ, &info);
+
+    REQUIRE(file != NULL);
+    REQUIRE(info.channels == 1);
+    REQUIRE(info.samplerate == AUDIO_CAPTURE_RATE);
+
+    /* Encoder delay and frame padding only */
+    REQUIRE(info.frames >= (sf_count_t) in.size());
+    REQUIRE(info.frames <= (sf_count_t) in.size() + 4 * 1152);
+
+    std::vector<short> out(info.frames);
+
+    REQUIRE(sf_read_short(file, out.data(), out.size()) == info.frames);
+    sf_close(file);
+    unlink(name.c_str());
+    rmdir(dir);
+
+    /* Middle half second, away from the edges */
+    size_t  from = AUDIO_CAPTURE_RATE * 3 / 4;
+    size_t  len = AUDIO_CAPTURE_RATE / 2;
+    double  in_rms = 0.0, out_rms = 0.0;
+
+    for (size_t i = from; i < from + len; i++) {
+        in_rms += (double) in[i] * in[i];
+        out_rms += (double) out[i] * out[i];
+    }
+
+    float level_db = 10.0f * log10f(out_rms / in_rms);
+
+    CAPTURE(level_db);
+    REQUIRE(fabsf(level_db) < 1.0f);
+
+    float tone = tone_power(out, from, len, freq, AUDIO_CAPTURE_RATE);
+
+    for (float other : { 500.0f, 1500.0f, 2000.0f, 3000.0f }) {
+        CAPTURE(other);
+        REQUIRE(10.0f * log10f(tone / tone_power(out, from, len, other, AUDIO_CAPTURE_RATE)) > 30.0f);
+    }
+}
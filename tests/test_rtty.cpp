@@ -0,0 +1,123 @@
+#include "../src/rtty_rx.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define RATE 44100
+#define CENTER 1000.0f
+
+#define LTRS 0x1F
+#define FIGS 0x1B
+
+static const char letters[] = "\0E\nA SIU\0DRJNFCKTZLWHYPQOBG MXV ";
+static const char figures[] = "\0" "3\n- \0" "87\0$4',!:(5\")2#6019?& ./; ";
+
+/* Mark is the lower tone, 1.5 stop bits, idle mark around the text */
+static std::vector<cfloat> make_rtty(const char *text, float baud, uint16_t shift) {
+    std::vector<std::pair<bool, float>> bits;       /* Level and length in bits */
+    bool                                figs = false;
+
+    auto put = [&](uint8_t code) {
+        bits.push_back({ false, 1.0f });
+
+        for (int i = 0; i < 5; i++) {
+            bits.push_back({ (code >> i) & 1, 1.0f });
+        }
+
+        bits.push_back({ true, 1.5f });
+    };
+
+    bits.push_back({ true, 50.0f });
+    put(LTRS);
+
+    for (const char *c = text; *c; c++) {
+        const char *l = (const char *) memchr(letters + 1, *c, 31);
+        const char *f = (const char *) memchr(figures + 1, *c, 31);
+
+        if (l && (!figs || !f)) {
+            if (figs) {
+                put(LTRS);
+                figs = false;
+            }
+            put(l - letters);
+        } else if (f) {
+            if (!figs) {
+                put(FIGS);
+                figs = true;
+            }
+            put(f - figures);
+        }
+    }
+
+    bits.push_back({ true, 50.0f });
+
+    std::vector<cfloat> out;
+    float               phase = 0.0f;
+    float               t = 0.0f;
+
+    for (auto &[mark, len] : bits) {
+        float freq = CENTER + (mark ? -shift : shift) / 2.0f;
+
+        for (t += len * RATE / baud; t >= 1.0f; t -= 1.0f) {
+            out.push_back(std::polar(0.3f, phase));
+            phase = fmodf(phase + 2.0f * M_PI * freq / RATE, 2.0f * M_PI);
+        }
+    }
+
+    return out;
+}
+
+static void on_text(char c, void *user) {
+    *(std::string *) user += c;
+}
+
+static void process(rtty_rx_t rx, std::vector<cfloat> &in) {
+    for (size_t pos = 0; pos < in.size(); pos += 4410) {
+        rtty_rx_process(rx, std::min((size_t) 4410, in.size() - pos), &in[pos]);
+    }
+}
+
+TEST_CASE("Fixed rate is decoded", "[rtty]") {
+    std::vector<cfloat> in = make_rtty("RYRYRY CQ CQ DE R2RFE R2RFE K\n", 45.45f, 170);
+    std::string         text;
+    rtty_rx_t           rx = rtty_rx_create(45.45f, 170, RATE, on_text, &text);
+
+    rtty_rx_set_center(rx, CENTER);
+    process(rx, in);
+    rtty_rx_destroy(rx);
+
+    REQUIRE(text.find("DE R2RFE") != std::string::npos);
+}
+
+TEST_CASE("Auto rate selects the rate and shift of the signal", "[rtty]") {
+    struct {
+        float       baud;
+        uint16_t    shift;
+    } signals[] = {
+        { 45.45f, 170 },
+        { 75.0f, 850 },
+    };
+
+    for (auto &s : signals) {
+        std::string         msg = "RYRYRY CQ CQ DE R2RFE R2RFE K\n";
+        std::vector<cfloat> in = make_rtty((msg + msg + msg).c_str(), s.baud, s.shift);
+        std::string         text;
+        rtty_rx_t           rx = rtty_rx_create(0.0f, 0, RATE, on_text, &text);
+
+        rtty_rx_set_center(rx, CENTER);
+        process(rx, in);
+
+        CAPTURE(s.baud, s.shift, text);
+        REQUIRE(rtty_rx_get_rate(rx) == s.baud);
+        REQUIRE(rtty_rx_get_shift(rx) == s.shift);
+        REQUIRE(text.find("DE R2RFE") != std::string::npos);
+
+        rtty_rx_destroy(rx);
+    }
+}
@@ -0,0 +1,133 @@
+#include "../src/scheduler.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int          noargs_calls;
+static std::string  text;
+
+static void noargs_cb(void *arg) {
+    REQUIRE(arg == nullptr);
+    noargs_calls++;
+}
+
+static void text_cb(void *arg) {
+    text += (const char *) arg;
+}
+
+static void requeue_cb(void *arg) {
+    noargs_calls++;
+
+    if (noargs_calls == 1) {
+        scheduler_put_noargs(requeue_cb);
+    }
+}
+
+TEST_CASE("Pending task without arguments is coalesced", "[scheduler]") {
+    size_t coalesced = scheduler_get_coalesced();
+
+    noargs_calls = 0;
+    scheduler_put_noargs(noargs_cb);
+    scheduler_put_noargs(noargs_cb);
+    scheduler_put_noargs(noargs_cb);
+    scheduler_work();
+
+    REQUIRE(noargs_calls == 1);
+    REQUIRE(scheduler_get_coalesced() == coalesced + 2);
+
+    /* Put from the task itself runs again */
+    noargs_calls = 0;
+    scheduler_put_noargs(requeue_cb);
+    scheduler_work();
+
+    REQUIRE(noargs_calls == 2);
+}
+
+TEST_CASE("Arguments are copied and kept in order", "[scheduler]") {
+    char buf[16];
+
+    text.clear();
+
+    for (int i = 0; i < 10; i++) {
+        snprintf(buf, sizeof(buf), "%i,", i);
+        scheduler_put(text_cb, buf, strlen(buf) + 1);
+        memset(buf, 'x', sizeof(buf));
+    }
+
+    scheduler_work();
+
+    REQUIRE(text == "0,1,2,3,4,5,6,7,8,9,");
+}
+
+TEST_CASE("Full queue drops and counts", "[scheduler]") {
+    size_t overflows = scheduler_get_overflows();
+
+    text.clear();
+
+    for (int i = 0; i < 100; i++) {
+        scheduler_put(text_cb, (void *) "a", 2);
+    }
+
+    scheduler_work();
+
+    REQUIRE(text.size() == 64);
+    REQUIRE(scheduler_get_overflows() == overflows + 36);
+}
+
+static std::atomic<int> executed;
+static int              last[4];
+static bool             ordered;
+
+static void count_cb(void *arg) {
+    int *v = (int *) arg;
+
+    /* Tasks of one producer come in order */
+    if (v[1] <= last[v[0]]) {
+        ordered = false;
+    }
+
+    last[v[0]] = v[1];
+    executed++;
+}
+
+TEST_CASE("Many producers", "[scheduler]") {
+    std::atomic<bool>           done = false;
+    std::vector<std::thread>    threads;
+    size_t                      overflows = scheduler_get_overflows();
+
+    executed = 0;
+    ordered = true;
+
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t] {
+            for (int i = 1; i <= 10000; i++) {
+                int v[2] = { t, i };
+
+                scheduler_put(count_cb, v, sizeof(v));
+            }
+        });
+    }
+
+    std::thread consumer([&] {
+        while (!done) {
+            scheduler_work();
+        }
+        scheduler_work();
+    });
+
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    done = true;
+    consumer.join();
+
+    REQUIRE(ordered);
+    REQUIRE(executed + scheduler_get_overflows() - overflows == 40000);
+}
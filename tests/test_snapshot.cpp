@@ -0,0 +1,166 @@
+#include "../src/cfg/subjects.h"
+
+extern "C" {
+    #include "../src/cfg/snapshot.private.h"
+
+    cfg_t       cfg;
+    cfg_cur_t   cfg_cur;
+}
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static cfg_band_t               band;
+static std::vector<Subject *>   values;     /* Set to n */
+static std::vector<Subject *>   flags;      /* Set to n & 1 */
+
+static Subject * add(std::vector<Subject *> &list) {
+    Subject *subj = subject_create_int(0);
+
+    list.push_back(subj);
+    return subj;
+}
+
+static void add_vfo(struct vfo_params *vfo) {
+    vfo->freq.val = add(values);
+    vfo->mode.val = add(values);
+    vfo->agc.val = add(values);
+    vfo->att.val = add(values);
+    vfo->pre.val = add(values);
+}
+
+static void init_cfg() {
+    cfg_cur.fg_freq = add(values);
+    cfg_cur.bg_freq = add(values);
+    cfg_cur.freq_shift = add(values);
+    cfg_cur.mode = add(values);
+    cfg_cur.agc = add(values);
+    cfg_cur.att = add(values);
+    cfg_cur.pre = add(values);
+    cfg_cur.filter.low = add(values);
+    cfg_cur.filter.high = add(values);
+    cfg_cur.fft_width = add(values);
+
+    cfg_cur.band = &band;
+    band.vfo.val = add(values);
+    band.split.val = add(flags);
+    add_vfo(&band.vfo_a);
+    add_vfo(&band.vfo_b);
+
+    cfg.key_train.val = add(flags);
+
+    cfg_snapshot_init();
+}
+
+/* Enum fields hold values out of their range here */
+static int32_t word(const void *field) {
+    int32_t val;
+
+    memcpy(&val, field, sizeof(val));
+    return val;
+}
+
+/* Every field of one publication is from the same change */
+static bool consistent(const cfg_snapshot_t &snap) {
+    int32_t n = snap.fg_freq;
+
+    const int32_t fields[] = {
+        snap.bg_freq, snap.freq_shift, word(&snap.mode), word(&snap.agc), word(&snap.att), word(&snap.pre),
+        snap.filter_low, snap.filter_high, (int32_t) snap.fft_width, word(&snap.vfo),
+        snap.vfo_a.freq, word(&snap.vfo_a.mode), word(&snap.vfo_a.agc), word(&snap.vfo_a.att), word(&snap.vfo_a.pre),
+        snap.vfo_b.freq, word(&snap.vfo_b.mode), word(&snap.vfo_b.agc), word(&snap.vfo_b.att), word(&snap.vfo_b.pre),
+    };
+
+    for (auto field : fields) {
+        if (field != n) {
+            return false;
+        }
+    }
+
+    return snap.split == (n & 1) && snap.key_train == (n & 1);
+}
+
+TEST_CASE("Transaction publishes one snapshot", "[snapshot]") {
+    if (values.empty()) {
+        init_cfg();
+    }
+
+    uint32_t        version = cfg_snapshot_version();
+    cfg_snapshot_t  snap;
+
+    subject_transaction_begin();
+
+    for (auto subj : values) {
+        subject_set_int(subj, 7);
+    }
+    for (auto subj : flags) {
+        subject_set_int(subj, 1);
+    }
+
+    REQUIRE(cfg_snapshot_version() == version);
+
+    subject_transaction_commit();
+    cfg_snapshot_get(&snap);
+
+    REQUIRE(cfg_snapshot_version() == version + 1);
+    REQUIRE(snap.version == version + 1);
+    REQUIRE(consistent(snap));
+}
+
+TEST_CASE("Readers never see a torn snapshot", "[snapshot]") {
+    if (values.empty()) {
+        init_cfg();
+    }
+
+    std::atomic<bool>           stop = false;
+    std::atomic<int>            torn = 0;
+    std::atomic<int>            reads = 0;
+    std::vector<std::thread>    readers;
+
+    for (int i = 0; i < 3; i++) {
+        readers.emplace_back([&] {
+            uint32_t last = 0;
+
+            while (!stop) {
+                cfg_snapshot_t snap;
+
+                cfg_snapshot_get(&snap);
+
+                if (!consistent(snap) || snap.version < last) {
+                    torn++;
+                }
+                last = snap.version;
+                reads++;
+            }
+        });
+    }
+
+    std::thread writer([] {
+        for (int32_t n = 100; n < 20100; n++) {
+            subject_transaction_begin();
+
+            for (auto subj : values) {
+                subject_set_int(subj, n);
+            }
+            for (auto subj : flags) {
+                subject_set_int(subj, n & 1);
+            }
+
+            subject_transaction_commit();
+        }
+    });
+
+    writer.join();
+    stop = true;
+
+    for (auto &reader : readers) {
+        reader.join();
+    }
+
+    REQUIRE(reads > 0);
+    REQUIRE(torn == 0);
+}
@@ -0,0 +1,232 @@
+#include "../src/cfg/subjects.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static std::vector<int> calls;
+
+static void observer_cb(Subject *subj, void *user) {
+    calls.push_back((int) (intptr_t) user);
+}
+
+/* Change from other thread, as radio or CAT */
+static void set_from_thread(Subject *subj, int32_t val) {
+    std::thread thread([subj, val] { subject_set_int(subj, val); });
+
+    thread.join();
+}
+
+TEST_CASE("Delayed observer is called once per pass", "[subjects]") {
+    Subject         *a = subject_create_int(0);
+    Subject         *b = subject_create_int(0);
+    ObserverDelayed *oa = subject_add_delayed_observer(a, observer_cb, (void *) 1);
+    ObserverDelayed *ob = subject_add_delayed_observer(b, observer_cb, (void *) 2);
+
+    calls.clear();
+
+    set_from_thread(b, 1);
+    set_from_thread(a, 1);
+    set_from_thread(b, 2);
+
+    REQUIRE(calls.empty());
+
+    observer_delayed_notify_all();
+
+    REQUIRE(calls == std::vector<int>{ 2, 1 });
+
+    /* Nothing changed */
+    calls.clear();
+    observer_delayed_notify_all();
+
+    REQUIRE(calls.empty());
+
+    /* Same thread is called at once */
+    subject_set_int(a, 5);
+
+    REQUIRE(calls == std::vector<int>{ 1 });
+
+    observer_delayed_del(oa);
+    observer_delayed_del(ob);
+}
+
+TEST_CASE("Pending observer can be deleted", "[subjects]") {
+    Subject         *a = subject_create_int(0);
+    Subject         *b = subject_create_int(0);
+    ObserverDelayed *oa = subject_add_delayed_observer(a, observer_cb, (void *) 1);
+    ObserverDelayed *ob = subject_add_delayed_observer(b, observer_cb, (void *) 2);
+
+    calls.clear();
+
+    set_from_thread(a, 1);
+    set_from_thread(b, 1);
+    observer_delayed_del(oa);
+    observer_delayed_notify_all();
+
+    REQUIRE(calls == std::vector<int>{ 2 });
+
+    observer_delayed_del(ob);
+}
+
+TEST_CASE("Delayed observer can be deleted while other thread notifies", "[subjects]") {
+    Subject             *a = subject_create_int(0);
+    std::atomic<bool>   stop = false;
+
+    std::thread thread([a, &stop] {
+        for (int32_t i = 1; !stop; i++) {
+            subject_set_int(a, i);
+        }
+    });
+
+    calls.clear();
+
+    for (int i = 0; i < 10000; i++) {
+        ObserverDelayed *o = subject_add_delayed_observer(a, observer_cb, (void *) 1);
+
+        std::this_thread::yield();
+        observer_delayed_del(o);
+    }
+
+    stop = true;
+    thread.join();
+    observer_delayed_notify_all();
+
+    REQUIRE(calls.empty());
+}
+
+static Subject *mirror_src;
+static Subject *mirror_dst;
+
+/* As band params copied to the current ones */
+static void mirror_cb(Subject *subj, void *user) {
+    subject_set_int(mirror_dst, subject_get_int(mirror_src));
+}
+
+static void value_cb(Subject *subj, void *user) {
+    calls.push_back(subject_get_int(subj));
+}
+
+TEST_CASE("Transaction notifies each observer once with final values", "[subjects]") {
+    Subject     *a = subject_create_int(0);
+    Subject     *b = subject_create_int(0);
+    Observer    *oa = subject_add_observer(a, observer_cb, (void *) 1);
+    Observer    *ob = subject_add_observer(b, observer_cb, (void *) 2);
+    Observer    *oab = subject_add_observer(b, observer_cb, (void *) 3);
+
+    calls.clear();
+
+    subject_transaction_begin();
+    subject_set_int(b, 1);
+    subject_set_int(a, 1);
+    subject_transaction_begin();
+    subject_set_int(b, 2);
+    subject_set_int(a, 2);
+    subject_transaction_commit();
+
+    REQUIRE(calls.empty());
+
+    subject_transaction_commit();
+
+    REQUIRE(calls == std::vector<int>{ 2, 3, 1 });
+
+    /* Outside of the transaction every change is delivered */
+    calls.clear();
+    subject_set_int(a, 3);
+    subject_set_int(a, 4);
+
+    REQUIRE(calls == std::vector<int>{ 1, 1 });
+
+    observer_del(oa);
+    observer_del(ob);
+    observer_del(oab);
+}
+
+TEST_CASE("Cascaded changes are delivered in the same commit", "[subjects]") {
+    mirror_src = subject_create_int(0);
+    mirror_dst = subject_create_int(0);
+
+    Observer *om = subject_add_observer(mirror_src, mirror_cb, NULL);
+    Observer *ov = subject_add_observer(mirror_dst, value_cb, NULL);
+
+    calls.clear();
+
+    subject_transaction_begin();
+    subject_set_int(mirror_src, 10);
+    subject_set_int(mirror_src, 20);
+    subject_set_int(mirror_src, 30);
+    subject_transaction_commit();
+
+    REQUIRE(calls == std::vector<int>{ 30 });
+    REQUIRE(subject_get_int(mirror_dst) == 30);
+
+    observer_del(om);
+    observer_del(ov);
+}
+
+static int after_calls;
+
+static void after_cb() {
+    after_calls++;
+}
+
+static void after_observer_cb(Subject *subj, void *user) {
+    subject_after_commit(after_cb);
+}
+
+TEST_CASE("After commit hook is called once per transaction", "[subjects]") {
+    Subject     *a = subject_create_int(0);
+    Subject     *b = subject_create_int(0);
+    Observer    *oa = subject_add_observer(a, after_observer_cb, NULL);
+    Observer    *ob = subject_add_observer(b, after_observer_cb, NULL);
+
+    after_calls = 0;
+
+    subject_transaction_begin();
+    subject_set_int(a, 1);
+    subject_set_int(b, 1);
+    subject_transaction_commit();
+
+    REQUIRE(after_calls == 1);
+
+    subject_set_int(a, 2);
+    subject_set_int(b, 2);
+
+    REQUIRE(after_calls == 3);
+
+    observer_del(oa);
+    observer_del(ob);
+}
+
+TEST_CASE("Delayed observer made by a worker belongs to the pinned thread", "[subjects]") {
+    Subject         *a = subject_create_int(0);
+    ObserverDelayed *o = nullptr;
+
+    /* As params_init on a boot worker */
+    observer_delayed_pin_thread();
+
+    std::thread worker([a, &o] {
+        o = subject_add_delayed_observer(a, observer_cb, (void *) 1);
+        subject_set_int(a, 1);
+    });
+
+    worker.join();
+
+    calls.clear();
+    set_from_thread(a, 2);
+
+    REQUIRE(calls.empty());
+
+    observer_delayed_notify_all();
+
+    REQUIRE(calls == std::vector<int>{ 1 });
+
+    /* Pinned thread is called at once */
+    calls.clear();
+    subject_set_int(a, 3);
+
+    REQUIRE(calls == std::vector<int>{ 1 });
+
+    observer_delayed_del(o);
+}
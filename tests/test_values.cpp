@@ -0,0 +1,127 @@
+extern "C" {
+    #include <sqlite3.h>
+    #include "../src/cfg/values.private.h"
+}
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+/* Same FNV-1a as values.c, to pick colliding names */
+static uint32_t fnv1a(const std::string &str) {
+    uint32_t h = 2166136261u;
+
+    for (char c : str) {
+        h = (h ^ (uint8_t) c) * 16777619u;
+    }
+    return h;
+}
+
+/* Names with the given slot in a table of 16 */
+static std::vector<std::string> names_at(uint32_t slot, size_t n) {
+    std::vector<std::string> out;
+
+    for (int i = 0; out.size() < n; i++) {
+        std::string name = "item_" + std::to_string(i);
+
+        if ((fnv1a(name) & 15) == slot) {
+            out.push_back(name);
+        }
+    }
+    return out;
+}
+
+static db_values_t * load(const std::vector<std::string> &names) {
+    sqlite3         *db;
+    sqlite3_stmt    *stmt;
+
+    REQUIRE(sqlite3_open(":memory:", &db) == SQLITE_OK);
+    REQUIRE(sqlite3_exec(db, "CREATE TABLE params(name TEXT, val)", NULL, NULL, NULL) == SQLITE_OK);
+    REQUIRE(sqlite3_prepare_v2(db, "INSERT INTO params(name, val) VALUES(?, ?)", -1, &stmt, 0) == SQLITE_OK);
+
+    for (size_t i = 0; i < names.size(); i++) {
+        sqlite3_bind_text(stmt, 1, names[i].c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 2, i * 10);
+        REQUIRE(sqlite3_step(stmt) == SQLITE_DONE);
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+
+    REQUIRE(sqlite3_prepare_v2(db, "SELECT name, val FROM params", -1, &stmt, 0) == SQLITE_OK);
+
+    db_values_t *values = db_values_load(stmt);
+
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+
+    REQUIRE(values != NULL);
+    REQUIRE(db_values_count(values) == names.size());
+
+    return values;
+}
+
+static void require_all(db_values_t *values, const std::vector<std::string> &names) {
+    for (size_t i = 0; i < names.size(); i++) {
+        const db_value_t *value = db_values_get(values, names[i].c_str());
+
+        CAPTURE(names[i]);
+        REQUIRE(value != NULL);
+        REQUIRE(value->name == names[i]);
+        REQUIRE(value->int_val == (int64_t) i * 10);
+    }
+}
+
+TEST_CASE("Colliding names are probed to the next slots", "[values]") {
+    /* 8 items fit into a table of 16. Last slot makes the probe wrap around */
+    std::vector<std::string>    names = names_at(15, 4);
+    std::vector<std::string>    more = names_at(0, 2);
+
+    names.insert(names.end(), more.begin(), more.end());
+    more = names_at(7, 2);
+    names.insert(names.end(), more.begin(), more.end());
+
+    db_values_t *values = load(names);
+
+    require_all(values, names);
+
+    /* Missing names of the same slots walk the whole cluster */
+    REQUIRE(db_values_get(values, names_at(15, 5).back().c_str()) == NULL);
+    REQUIRE(db_values_get(values, names_at(0, 3).back().c_str()) == NULL);
+
+    db_values_free(values);
+}
+
+TEST_CASE("Missing name and empty table", "[values]") {
+    db_values_t *values = load({});
+
+    REQUIRE(db_values_get(values, "band") == NULL);
+    db_values_free(values);
+
+    values = load({ "band", "mode", "vol" });
+
+    REQUIRE(db_values_get(values, "band") != NULL);
+    REQUIRE(db_values_get(values, "") == NULL);
+    REQUIRE(db_values_get(values, "ban") == NULL);
+    REQUIRE(db_values_get(values, "bands") == NULL);
+    db_values_free(values);
+}
+
+TEST_CASE("Table is never full", "[values]") {
+    /* Power of two counts: the index grows to keep free slots for the probe to stop at */
+    for (size_t n : { 8, 16, 1000, 1024 }) {
+        std::vector<std::string> names;
+
+        for (size_t i = 0; i < n; i++) {
+            names.push_back("name_" + std::to_string(i));
+        }
+
+        CAPTURE(n);
+
+        db_values_t *values = load(names);
+
+        require_all(values, names);
+        REQUIRE(db_values_get(values, "missing") == NULL);
+        db_values_free(values);
+    }
+}
@@ -0,0 +1,122 @@
+#include "../src/vmath.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+/* Odd size, so the scalar tail after the vector loop is checked too */
+#define N   100003
+
+static std::vector<float> range(float from, float to) {
+    std::vector<float> x(N);
+
+    for (size_t i = 0; i < N; i++) {
+        x[i] = from + (to - from) * i / (N - 1);
+    }
+
+    return x;
+}
+
+TEST_CASE("exp against libm", "[vmath]") {
+    std::vector<float>  x = range(-87.0f, 88.0f);
+    std::vector<float>  y(N);
+    double              err = 0.0;
+
+    vmath_exp(x.data(), y.data(), N);
+
+    for (size_t i = 0; i < N; i++) {
+        double ref = exp((double) x[i]);
+
+        err = std::max(err, fabs(y[i] - ref) / ref);
+    }
+
+    REQUIRE(err < 2e-7);
+}
+
+TEST_CASE("10^x against libm", "[vmath]") {
+    std::vector<float>  x = range(-37.7f, 38.2f);
+    std::vector<float>  y(N);
+    double              err = 0.0;
+
+    vmath_exp10(x.data(), y.data(), N);
+
+    for (size_t i = 0; i < N; i++) {
+        double ref = pow(10.0, (double) x[i]);
+
+        err = std::max(err, fabs(y[i] - ref) / ref);
+    }
+
+    REQUIRE(err < 2e-7);
+}
+
+TEST_CASE("log10 against libm", "[vmath]") {
+    std::vector<float>  x = range(-37.9f, 38.5f);
+    std::vector<float>  y(N);
+    double              err = 0.0;
+
+    for (auto &v : x) {
+        v = powf(10.0f, v);
+    }
+
+    vmath_log10(x.data(), y.data(), N);
+
+    for (size_t i = 0; i < N; i++) {
+        double ref = log10((double) x[i]);
+
+        err = std::max(err, fabs(y[i] - ref) / std::max(1.0, fabs(ref)));
+    }
+
+    REQUIRE(err < 2e-7);
+
+    /* Around 1, where the result is small */
+    x = range(0.5f, 2.0f);
+    vmath_log10(x.data(), y.data(), N);
+
+    for (size_t i = 0; i < N; i++) {
+        REQUIRE(fabs(y[i] - log10((double) x[i])) < 2e-7);
+    }
+}
+
+TEST_CASE("dB conversions in place", "[vmath]") {
+    std::vector<float> x = range(-200.0f, 200.0f);
+    std::vector<float> y = x;
+
+    vmath_db_to_power(y.data(), y.data(), N);
+
+    for (size_t i = 0; i < N; i++) {
+        double ref = pow(10.0, x[i] / 10.0);
+
+        REQUIRE(fabs(y[i] - ref) / ref < 1e-5);
+    }
+
+    vmath_power_to_db(y.data(), y.data(), N);
+
+    for (size_t i = 0; i < N; i++) {
+        REQUIRE(fabs(y[i] - x[i]) < 1e-4);
+    }
+}
+
+TEST_CASE("Out of range arguments", "[vmath]") {
+    float x[5] = { 0.0f, -1.0f, 1e-45f, INFINITY, 1.0f };
+    float y[5];
+
+    vmath_log10(x, y, 5);
+
+    REQUIRE(fabsf(y[0] - log10f(FLT_MIN)) < 1e-5f);
+    REQUIRE(y[1] == y[0]);
+    REQUIRE(y[2] == y[0]);
+    REQUIRE(y[3] > 38.0f);
+    REQUIRE(y[4] == 0.0f);
+
+    float e[4] = { -1000.0f, 1000.0f, -INFINITY, INFINITY };
+
+    vmath_exp(e, y, 4);
+
+    REQUIRE(y[0] > 0.0f);
+    REQUIRE(std::isfinite(y[1]));
+    REQUIRE(y[2] > 0.0f);
+    REQUIRE(std::isfinite(y[3]));
+}